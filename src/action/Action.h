@@ -19,6 +19,7 @@
 class SectionSamplerInterface;
 class SectionChooser;
 class Paths;
+class Species;
 #include <cstdlib>
 #include <blitz/array.h>
 #include <typeinfo>
@@ -57,6 +58,12 @@ public:
 
   /// Accept last move.
   virtual void acceptLastMove() {};
+  /// True if getTotalAction gives the full action, so that running
+  /// totals of accepted differences can be checked against it.
+  virtual bool hasTotalAction() const {return false;}
+  /// Whether moving particles of a species can change this action
+  /// (defaults to true; used by CompositeAction to skip actions).
+  virtual bool dependsOnSpecies(const Species&) const {return true;}
   /// Returns pointer to Action of type t, otherwise returns null pointer.
   virtual const Action* getActionPointerByType(const std::type_info &type) const { 
     return (typeid(*this)==type) ? this : 0;
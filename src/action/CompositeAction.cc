@@ -18,8 +18,12 @@
 #include <config.h>
 #endif
 #include "CompositeAction.h"
+#include "advancer/SectionSamplerInterface.h"
+#include "base/SimulationInfo.h"
+#include <algorithm>
 
-CompositeAction::CompositeAction(const int n) : actions(0) {
+CompositeAction::CompositeAction(const int n)
+  : actions(0), isLastMoveBoth(false), isTotalSynced(false) {
   if (n>0) actions.reserve(n);
 }
 
@@ -29,9 +33,22 @@ CompositeAction::~CompositeAction() {
 
 double CompositeAction::getActionDifference(
     const SectionSamplerInterface& sampler, const int level) {
+  const std::vector<int>& route
+    = routing.route(sampler.getMovingIndex(),actions.size());
+  // A sampler that moves both sections calls this for each section in
+  // turn, so keep the route and differences of the first section too.
+  isLastMoveBoth=sampler.isSamplingBoth();
+  bool isSecond = isLastMoveBoth
+    && &sampler.getMovingIndex()==&sampler.getMovingIndex(2);
+  if (isLastMoveBoth && !isSecond) firstRoute=route;
+  std::vector<double>& last(isSecond ? lastDifference2 : lastDifference);
+  last.resize(actions.size());
   double diff=0;
-  for (ConstActionIter action=actions.begin(); action<actions.end(); ++action) {
-    if (*action) diff+=(*action)->getActionDifference(sampler,level);
+  for (unsigned int i=0; i<route.size(); ++i) {
+    Action* action=actions[route[i]];
+    double d = action ? action->getActionDifference(sampler,level) : 0;
+    last[route[i]]=d;
+    diff+=d;
   }
   return diff;
 }
@@ -39,11 +56,17 @@ double CompositeAction::getActionDifference(
 double CompositeAction::getActionDifference(const Paths &paths, 
     const VArray &displacement, int nmoving, const IArray &movingIndex, 
     int iFirstSlice, int iLastSlice) {
+  const std::vector<int>& route
+    = routing.route(movingIndex,nmoving,actions.size());
+  isLastMoveBoth=false;
+  lastDifference.resize(actions.size());
   double diff=0;
-  for (ConstActionIter action=actions.begin(); action<actions.end(); ++action) {
-    if (*action)
-      diff+=(*action)->getActionDifference(paths,displacement,nmoving,
-                                           movingIndex,iFirstSlice,iLastSlice);
+  for (unsigned int i=0; i<route.size(); ++i) {
+    Action* action=actions[route[i]];
+    double d = action ? action->getActionDifference(paths,displacement,
+                          nmoving,movingIndex,iFirstSlice,iLastSlice) : 0;
+    lastDifference[route[i]]=d;
+    diff+=d;
   }
   return diff;
 }
@@ -75,9 +98,70 @@ void CompositeAction::initialize(const SectionChooser& sectionChooser) {
 }
 
 void CompositeAction::acceptLastMove() {
+  // Only the actions that computed the last difference see the move.
+  const std::vector<int>& route=routing.getLastRoute(actions.size());
+  lastDifference.resize(actions.size());
+  runningTotal.resize(actions.size());
+  if (!isLastMoveBoth) {
+    for (unsigned int i=0; i<route.size(); ++i) {
+      runningTotal[route[i]]+=lastDifference[route[i]];
+      actions[route[i]]->acceptLastMove();
+    }
+    return;
+  }
+  // The last route is that of the second section; each action on either
+  // route accepts once.
+  lastDifference2.resize(actions.size());
+  for (unsigned int i=0; i<firstRoute.size(); ++i) {
+    runningTotal[firstRoute[i]]+=lastDifference[firstRoute[i]];
+    actions[firstRoute[i]]->acceptLastMove();
+  }
+  for (unsigned int i=0; i<route.size(); ++i) {
+    runningTotal[route[i]]+=lastDifference2[route[i]];
+    if (std::find(firstRoute.begin(),firstRoute.end(),route[i])
+        ==firstRoute.end()) actions[route[i]]->acceptLastMove();
+  }
+}
+
+bool CompositeAction::hasTotalAction() const {
   for (ConstActionIter action=actions.begin(); action<actions.end(); ++action) {
-    (*action)->acceptLastMove();
+    if (*action && !(*action)->hasTotalAction()) return false;
+  }
+  return true;
+}
+
+void CompositeAction::syncRunningTotals(const Paths& paths,
+                                        std::vector<double>& drift) const {
+  runningTotal.resize(actions.size());
+  drift.assign(actions.size(),0.);
+  for (unsigned int i=0; i<actions.size(); ++i) {
+    if (!actions[i] || !actions[i]->hasTotalAction()) continue;
+    double total=actions[i]->getTotalAction(paths,0);
+    if (isTotalSynced) drift[i]=runningTotal[i]-total;
+    runningTotal[i]=total;
+  }
+  isTotalSynced=true;
+}
+
+bool CompositeAction::dependsOnSpecies(const Species& species) const {
+  for (ConstActionIter action=actions.begin(); action<actions.end(); ++action) {
+    if (*action && (*action)->dependsOnSpecies(species)) return true;
+  }
+  return false;
+}
+
+void CompositeAction::routeBySpecies(const SimulationInfo& simInfo) {
+  const int nspecies=simInfo.getNSpecies();
+  std::vector<bool> dependsOn(actions.size()*nspecies,false);
+  for (unsigned int iaction=0; iaction<actions.size(); ++iaction) {
+    CompositeAction* group=dynamic_cast<CompositeAction*>(actions[iaction]);
+    if (group) group->routeBySpecies(simInfo);
+    for (int ispec=0; ispec<nspecies; ++ispec) {
+      dependsOn[iaction*nspecies+ispec] = actions[iaction]
+        && actions[iaction]->dependsOnSpecies(simInfo.getSpecies(ispec));
+    }
   }
+  routing.setup(simInfo,dependsOn);
 }
 
 const Action* CompositeAction::getActionPointerByType(const std::type_info &type) const {
@@ -20,7 +20,10 @@ class SectionSamplerInterface;
 class DisplaceMoveSampler;
 class SectionChooser;
 class Paths;
+class SimulationInfo;
+class Species;
 #include "Action.h"
+#include "SpeciesRouting.h"
 #include <vector>
 
 /** Action class for composing multiple Action classes.
@@ -56,9 +59,39 @@ public:
   /// Returns pointer to an Action of type type, otherwise returns null pointer.
   virtual const Action* getActionPointerByType(const std::type_info &type) const;
   /// Returns the number of action objects.
-  int getCount() {return actions.size();}
+  int getCount() const {return actions.size();}
+  /// True if any of the actions depends on the species.
+  virtual bool dependsOnSpecies(const Species&) const;
+  /// Build the table of actions to call for moves of each species.
+  /// Call after all actions have been added.
+  void routeBySpecies(const SimulationInfo&);
+  /// True only if every action has a total action.
+  virtual bool hasTotalAction() const;
+  /// Running total of each action, summed from accepted differences.
+  /// A move that samples both sections adds the differences of both.
+  const std::vector<double>& getRunningTotals() const {return runningTotal;}
+  /// Recompute the total of each action that has one, and restart its
+  /// running total from it. The running total minus the recomputed total
+  /// goes in drift (zero on the first call and for other actions).
+  void syncRunningTotals(const Paths&, std::vector<double>& drift) const;
 protected:
   /// Pointers to the Action objects.
   ActionContainer actions;
+  /// Actions involved in moves of each species.
+  SpeciesRouting routing;
+  /// Difference of each action for the last move.
+  std::vector<double> lastDifference;
+  /// Difference of each action for the second section of the last move,
+  /// when the sampler moves both sections.
+  std::vector<double> lastDifference2;
+  /// Route of the first section of the last move, when the sampler moves
+  /// both sections.
+  std::vector<int> firstRoute;
+  /// Flag for a last move that sampled both sections.
+  bool isLastMoveBoth;
+  /// Running total of each action.
+  mutable std::vector<double> runningTotal;
+  /// Flag for running totals started from recomputed totals.
+  mutable bool isTotalSynced;
 };
 #endif
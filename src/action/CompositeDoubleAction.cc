@@ -18,6 +18,8 @@
 #include <config.h>
 #endif
 #include "CompositeDoubleAction.h"
+#include "advancer/SectionSamplerInterface.h"
+#include "base/SimulationInfo.h"
 
 CompositeDoubleAction::CompositeDoubleAction(const int n) : actions(0) {
   if (n>0) actions.reserve(n);
@@ -29,9 +31,15 @@ CompositeDoubleAction::~CompositeDoubleAction() {
 
 double CompositeDoubleAction::getActionDifference(
     const SectionSamplerInterface& sampler, const int level) {
+  // Double actions see both sections at once when both are moving.
+  const std::vector<int>& route = sampler.isSamplingBoth()
+    ? routing.route(sampler.getMovingIndex(1),sampler.getMovingIndex(2),
+                    actions.size())
+    : routing.route(sampler.getMovingIndex(1),actions.size());
   double diff=0;
-  for (ConstActionIter action=actions.begin(); action<actions.end(); ++action) {
-    if (*action) diff+=(*action)->getActionDifference(sampler,level);
+  for (unsigned int i=0; i<route.size(); ++i) {
+    DoubleAction* action=actions[route[i]];
+    if (action) diff+=action->getActionDifference(sampler,level);
   }
   return diff;
 }
@@ -39,11 +47,14 @@ double CompositeDoubleAction::getActionDifference(
 double CompositeDoubleAction::getActionDifference(const Paths &paths, 
     const VArray &displacement, int nmoving, const IArray &movingIndex, 
     int iFirstSlice, int nslice) {
+  const std::vector<int>& route
+    = routing.route(movingIndex,nmoving,actions.size());
   double diff=0;
-  for (ConstActionIter action=actions.begin(); action<actions.end(); ++action) {
-    if (*action)
-      diff+=(*action)->getActionDifference(paths,displacement,nmoving,
-                                           movingIndex,iFirstSlice,nslice);
+  for (unsigned int i=0; i<route.size(); ++i) {
+    DoubleAction* action=actions[route[i]];
+    if (action)
+      diff+=action->getActionDifference(paths,displacement,nmoving,
+                                        movingIndex,iFirstSlice,nslice);
   }
   return diff;
 }
@@ -77,7 +88,31 @@ void CompositeDoubleAction::initialize(const DoubleSectionChooser&
 }
 
 void CompositeDoubleAction::acceptLastMove() {
+  // Only the actions that computed the last difference see the move.
+  const std::vector<int>& route=routing.getLastRoute(actions.size());
+  for (unsigned int i=0; i<route.size(); ++i) {
+    actions[route[i]]->acceptLastMove();
+  }
+}
+
+bool CompositeDoubleAction::dependsOnSpecies(const Species& species) const {
   for (ConstActionIter action=actions.begin(); action<actions.end(); ++action) {
-    (*action)->acceptLastMove();
+    if (*action && (*action)->dependsOnSpecies(species)) return true;
+  }
+  return false;
+}
+
+void CompositeDoubleAction::routeBySpecies(const SimulationInfo& simInfo) {
+  const int nspecies=simInfo.getNSpecies();
+  std::vector<bool> dependsOn(actions.size()*nspecies,false);
+  for (unsigned int iaction=0; iaction<actions.size(); ++iaction) {
+    CompositeDoubleAction* group
+      = dynamic_cast<CompositeDoubleAction*>(actions[iaction]);
+    if (group) group->routeBySpecies(simInfo);
+    for (int ispec=0; ispec<nspecies; ++ispec) {
+      dependsOn[iaction*nspecies+ispec] = actions[iaction]
+        && actions[iaction]->dependsOnSpecies(simInfo.getSpecies(ispec));
+    }
   }
+  routing.setup(simInfo,dependsOn);
 }
@@ -17,7 +17,10 @@
 #ifndef __CompositeDoubleAction_h_
 #define __CompositeDoubleAction_h_
 class Paths;
+class SimulationInfo;
+class Species;
 #include "DoubleAction.h"
+#include "SpeciesRouting.h"
 #include <vector>
 
 /** Action class for composing multiple DoubleAction classes.
@@ -51,8 +54,15 @@ public:
   virtual void acceptLastMove();
   /// Get the number of constituent action objects.
   int getCount() const {return actions.size();}
+  /// True if any of the actions depends on the species.
+  virtual bool dependsOnSpecies(const Species&) const;
+  /// Build the table of actions to call for moves of each species.
+  /// Call after all actions have been added.
+  void routeBySpecies(const SimulationInfo&);
 protected:
   /// Pointers to the Action objects.
   ActionContainer actions;
+  /// Actions involved in moves of each species.
+  SpeciesRouting routing;
 };
 #endif
@@ -15,12 +15,14 @@
 #include "util/SuperCell.h"
 #include "util/TradEwaldSum.h"
 #include "util/OptEwaldSum.h"
+#include "util/PMEEwaldSum.h"
 
 CoulombAction::CoulombAction(const double epsilon, 
   const SimulationInfo& simInfo, const int norder, double rmin, double rmax,
   int ngpts, const bool dumpFiles, bool useEwald, int ewaldNDim, 
   double ewaldRcut, double ewaldKcut, double screenDist, const double kappa, 
-  const int nImages, const std::string ewaldType, int exLevel)
+  const int nImages, const std::string ewaldType, int exLevel,
+  const bool useImageTable)
   : epsilon(epsilon), tau(simInfo.getTau()), npart(simInfo.getNPart()),
     pairActionArray(0), screenDist(screenDist), ewaldSum(0) {
   typedef blitz::TinyVector<int, NDIM> IVec;
@@ -32,12 +34,15 @@ CoulombAction::CoulombAction(const double epsilon,
   
     if (ewaldType=="tradEwald") {
         ewaldSum = new TradEwaldSum(cell,npart,ewaldRcut,ewaldKcut, kappa);
+    } else if (ewaldType=="pme") {
+        ewaldSum = new PMEEwaldSum(cell,npart,ewaldRcut,ewaldKcut,4*ewaldKcut,8);
     } else if (ewaldType=="optEwald")  {
         ewaldSum = new OptEwaldSum(cell,npart,ewaldRcut,ewaldKcut,4*ewaldKcut,8);
     } else {
         ewaldSum = new OptEwaldSum(cell,npart,ewaldRcut,ewaldKcut,4*ewaldKcut,8);
     }
     rewald.resize(npart);
+    fewald.resize(npart);
     EwaldSum::Array &q=ewaldSum->getQArray();  
     for (int i=0; i<npart; ++i) q(i)=simInfo.getPartSpecies(i).charge;
     ewaldSum->evalSelfEnergy();
@@ -71,12 +76,14 @@ CoulombAction::CoulombAction(const double epsilon,
           pairActionArray.push_back(
             // Hack to handle ion-ion interaction properly.
             new ImagePairAction(s1,s2, *this, simInfo, (mu>500)?0:norder,
-                  nimage, rmin, rmax, ngpts,(i==j)?exLevel-1:-1));
+                  nimage, rmin, rmax, ngpts,(i==j)?exLevel-1:-1,
+                  useImageTable));
         } else {
 	  if (nImages > 1 && ewaldType=="tradEwald"){
 	    pairActionArray.push_back(
               new EwaldImagePairAction(s1,s2, *this, simInfo, (mu>500)?0:norder,
-                    rmin, rmax, ngpts, nImages, (i==j)?exLevel-1:-1));
+                    rmin, rmax, ngpts, nImages, (i==j)?exLevel-1:-1,
+                    useImageTable));
 	  } else {
 	    pairActionArray.push_back(
               // Hack to handle ion-ion interaction properly.
@@ -162,11 +169,18 @@ void CoulombAction::getBeadAction(const Paths& paths, int ipart, int islice,
     u+=ui; utau+=utaui; ulambda+=ulambdai; fm+=fmi; fp+=fpi;
   }
   // Compute long range action.
-  if (ewaldSum && ipart==0) {
-    paths.getSlice(islice,rewald);
-    double longRange = ewaldSum->evalLongRange(rewald)/epsilon;
-    u += longRange*tau;
-    utau += longRange;
+  // The slice is evaluated once, on the first particle, which also
+  // caches the long range forces for the other particles on the slice.
+  if (ewaldSum) {
+    if (ipart==0) {
+      paths.getSlice(islice,rewald);
+      double longRange = ewaldSum->evalLongRange(rewald,fewald)/epsilon;
+      u += longRange*tau;
+      utau += longRange;
+    }
+    Vec f = fewald(ipart)*(0.5*tau/epsilon);
+    fm += f;
+    fp += f;
   }
   //std :: cout << "CA :: "<<ipart<<" "<<islice<<"  "<<utau<<"  "<<u<<std ::endl;
 }
@@ -10,6 +10,8 @@ class EwaldSum;
 #include <vector>
 
 /** Class for calculating coulomb action between particles.
+ * With useImageTable, the image pair actions take the images beyond
+ * the minimum image from an ImageSumTable instead of summing them exactly.
  * @version $Revision$
  * @bug getEField method is not very accurate or efficient.
  * @author John Shumway. */
@@ -23,7 +25,8 @@ public:
             double rmin, double rmax, int ngpts, const bool dumpFiles,
             bool useEwald, int ewaldNDim, double ewaldRcut, double ewaldKcut,
             double screenDist, const double kappa, const int nimages,
-            const std::string ewaldType, int exLevel);
+            const std::string ewaldType, int exLevel,
+            const bool useImageTable);
     /// Virtual destructor.
     virtual ~CoulombAction();
     /// Calculate the difference in action.
@@ -67,5 +70,7 @@ private:
     EwaldSum *ewaldSum;
     /// Buffer for positions in long range ewald sum.
     mutable VArray1 rewald;
+    /// Long range ewald forces on the current slice.
+    mutable VArray1 fewald;
 };
 #endif
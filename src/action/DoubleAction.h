@@ -19,6 +19,7 @@
 class SectionSamplerInterface;class DoubleDisplaceMoveSampler;
 class DoubleSectionChooser;
 class Paths;
+class Species;
 #include <cstdlib>
 #include <blitz/array.h>
 
@@ -56,5 +57,8 @@ public:
 
   /// Accept last move.
   virtual void acceptLastMove() {};
+  /// Whether moving particles of a species can change this action
+  /// (defaults to true; used by CompositeDoubleAction to skip actions).
+  virtual bool dependsOnSpecies(const Species&) const {return true;}
 };
 #endif
@@ -2,6 +2,7 @@
 #include <config.h>
 #endif
 #include "EwaldImagePairAction.h"
+#include "ImageSumTable.h"
 #include "advancer/DisplaceMoveSampler.h"
 #include "advancer/SectionSamplerInterface.h"
 #include "base/Beads.h"
@@ -15,9 +16,9 @@
 EwaldImagePairAction::EwaldImagePairAction(const Species& s1, const Species& s2,
   const EmpiricalPairAction &action, const SimulationInfo& simInfo,
   const int norder, const double rmin, const double rmax, const int ngpts,
-  const int nImages, int exLevel) 
+  const int nImages, int exLevel, const bool useImageTable) 
   : PairAction(s1,s2,action,simInfo,norder,rmin,rmax,ngpts,false,exLevel),
-    nImages(nImages) {
+    nImages(nImages), imageTable(0) {
   std :: vector<double> cell(NDIM);
   sphereR=0.;
   for (int i=0; i< NDIM; i++){
@@ -28,8 +29,24 @@ EwaldImagePairAction::EwaldImagePairAction(const Species& s1, const Species& s2,
   boxImageVecs.resize(0);
   findBoxImageVectors(cell);
   std::cout << "Using Trad Ewald with nImages: " << nImages << std::endl;
+  if (useImageTable) {
+    // Sum all but the central box into a table.
+    std::vector<Vec> images;
+    for (unsigned int img=0; img<boxImageVecs.size(); img++){
+      Vec boxImage;
+      for (int l=0; l<NDIM; l++) boxImage[l]=boxImageVecs[img][l];
+      if (dot(boxImage,boxImage)>0) images.push_back(boxImage);
+    }
+    if (!images.empty()) {
+      imageTable=new ImageSumTable(*this, *simInfo.getSuperCell(), images);
+    }
+  }
 } 
 
+EwaldImagePairAction::~EwaldImagePairAction() {
+  delete imageTable;
+}
+
 
 double EwaldImagePairAction::getActionDifference(const SectionSamplerInterface& sampler,
                                          const int level) {
@@ -60,10 +77,30 @@ double EwaldImagePairAction::getActionDifference(const SectionSamplerInterface&
       Vec prevDelta =sectionBeads(i,0);
       prevDelta-=sectionBeads(j,0); cell.pbc(prevDelta);
       Vec prevMovingDelta=prevDelta;
+      if (imageTable) {
+        // Other images come from the table with the end-point approximation.
+        double prevW=(*imageTable)(prevDelta);
+        double prevMovingW=prevW;
+        for (int islice=nStride; islice<nSlice; islice+=nStride) {
+          Vec delta=movingBeads(iMoving,islice);
+          delta-=(isMoving)?movingBeads(jMoving,islice):sectionBeads(j,islice);
+          cell.pbc(delta);
+          double w=(*imageTable)(delta);
+          deltaAction+=0.5*(w+prevMovingW);
+          prevMovingW=w;
+          delta=sectionBeads(i,islice);
+          delta-=sectionBeads(j,islice);
+          cell.pbc(delta);
+          w=(*imageTable)(delta);
+          deltaAction-=0.5*(w+prevW);
+          prevW=w;
+        }
+      }
       //sum over images
       for (unsigned int img=0; img<boxImageVecs.size(); img++){
 	Vec boxImage;
 	for (int l=0; l<NDIM; l++) boxImage[l]=boxImageVecs[img][l];
+	if (imageTable && dot(boxImage,boxImage)>0) continue;
 
 	double prevR=sqrt(dot(prevDelta+boxImage,prevDelta+boxImage));
 	double prevMovingR=prevR;
@@ -137,11 +174,32 @@ double EwaldImagePairAction::getActionDifference(const Paths &paths,
       Vec prevMovingDelta=prevDelta+displacement(iMoving);
       if (isMoving) prevMovingDelta-=displacement(jMoving);
       cell.pbc(prevMovingDelta);
-
+      if (imageTable) {
+        // Other images come from the table with the end-point approximation.
+        double prevW=(*imageTable)(prevDelta);
+        double prevMovingW=(*imageTable)(prevMovingDelta);
+        for (int islice=iFirstSlice; islice<=iLastSlice; islice++) {
+          Vec delta=paths(i,islice);
+          delta+=displacement(iMoving);
+          delta-=paths(j,islice);
+          if (isMoving) delta-=displacement(jMoving);
+          cell.pbc(delta);
+          double w=(*imageTable)(delta);
+          deltaAction+=0.5*(w+prevMovingW);
+          prevMovingW=w;
+          delta=paths(i,islice);
+          delta-=paths(j,islice);
+          cell.pbc(delta);
+          w=(*imageTable)(delta);
+          deltaAction-=0.5*(w+prevW);
+          prevW=w;
+        }
+      }
 
       for (unsigned int img=0; img<boxImageVecs.size(); img++){//////////
 	Vec boxImage;
 	for (int l=0; l<NDIM; l++) boxImage[l]=boxImageVecs[img][l];
+	if (imageTable && dot(boxImage,boxImage)>0) continue;
 	
 	double prevR=sqrt(dot(prevDelta+boxImage,prevDelta+boxImage));
 	double prevMovingR=sqrt(dot(prevMovingDelta+boxImage,prevMovingDelta+boxImage));
@@ -198,6 +256,7 @@ void EwaldImagePairAction::getBeadAction(const Paths& paths, int ipart, int isli
       for (unsigned int img=0; img<boxImageVecs.size(); img++){//////////
 	Vec boxImage;
 	for (int l=0; l<NDIM; l++) boxImage[l]=boxImageVecs[img][l];
+	if (imageTable && dot(boxImage,boxImage)>0) continue;
 
 
 	for (int j=jbegin; j<jend; ++j) {
@@ -244,6 +303,21 @@ void EwaldImagePairAction::getBeadAction(const Paths& paths, int ipart, int isli
 	    +vz2*z*(delta+boxImage)*(2-z)/(q*r);
 	}
       }
+  if (imageTable) {
+    for (int j=jbegin; j<jend; ++j) {
+      if (ipart==j) continue;
+      Vec delta=paths(ipart,islice);
+      delta-=paths(j,islice);
+      paths.getSuperCell().pbc(delta);
+      // End-point action, half of each neighboring link on this bead.
+      double w,wtau; Vec grad;
+      imageTable->evalDerivatives(delta,w,wtau,grad);
+      u += 0.5*w;
+      utau += 0.5*wtau;
+      fm -= 0.5*grad;
+      fp -= 0.5*grad;
+    }
+  }
 }
 
 
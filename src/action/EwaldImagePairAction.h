@@ -21,21 +21,26 @@ class DisplaceMoveSampler;
 class Paths;
 class Species;
 class SimulationInfo;
+class ImageSumTable;
 #include "PairAction.h"
 #include <cstdlib>
 #include <blitz/array.h>
 #include <vector>
 
+/** Pair action summed over the box images inside a sphere of nImages
+* cell lengths. By default every image is evaluated exactly. With
+* useImageTable only the central box is exact, and the other images are
+* summed once into an ImageSumTable with the end-point approximation. */
 class EwaldImagePairAction :public PairAction {
 public:
   /// Construct by providing the species and EmpiricalPairAction.
     EwaldImagePairAction(const Species&, const Species&, const EmpiricalPairAction&,
 			 const SimulationInfo&, const int norder, 
 			 const double rmin, const double rmax, const int ngpts,
-			 const int nImages, int exLevel);
+			 const int nImages, int exLevel, const bool useImageTable);
     
   /// Virtual destructor.
-  virtual ~EwaldImagePairAction() {}
+  virtual ~EwaldImagePairAction();
   /// Calculate the difference in action.
   virtual double getActionDifference(const SectionSamplerInterface&,
                                      int level);
@@ -44,6 +49,8 @@ public:
     int nmoving, const IArray &movingIndex, int iFirstSlice, int iLastSlice);
   /// Calculate the total action.
   virtual double getTotalAction(const Paths&, const int level) const;
+  /// The total action with images is not implemented.
+  virtual bool hasTotalAction() const {return false;}
   /// Calculate the action and derivatives at a bead.
   virtual void getBeadAction(const Paths&, const int ipart, const int islice,
     double& u, double& utau, double& ulambda, Vec& fm, Vec& fp) const;
@@ -54,5 +61,8 @@ protected:
   double sphereR;
   const int nImages;
   std :: vector<std :: vector<double> > boxImageVecs;
+  /// Table of the action summed over the images outside the central box,
+  /// or null.
+  ImageSumTable *imageTable;
 };
 #endif
@@ -16,6 +16,9 @@ GridPotential::GridPotential(const SimulationInfo& simInfo,
   : tau(simInfo.getTau()), 
     vindex(simInfo.getNPart(),(ArrayN*)0) {
   //int nn;
+  // HDF5 converts the stored doubles to the table type on reading.
+  const hid_t tableType = (sizeof(TableReal)==sizeof(float))
+                          ? H5T_NATIVE_FLOAT : H5T_NATIVE_DOUBLE;
   // Read the bandoffsets from grid.h5.
   hid_t fileID = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
 #if (H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>=8))
@@ -36,7 +39,7 @@ GridPotential::GridPotential(const SimulationInfo& simInfo,
   for (int i=0; i<NDIM; ++i) nvec[i]=dims[i];
   //nn = product(nvec);
   vhgrid.resize(nvec);
-  H5Dread(dataSetID, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+  H5Dread(dataSetID, tableType, H5S_ALL, H5S_ALL, H5P_DEFAULT,
           vhgrid.data()); 
   vegrid.resize(nvec);
   H5Dclose(dataSetID);
@@ -45,7 +48,7 @@ GridPotential::GridPotential(const SimulationInfo& simInfo,
 #else
   dataSetID = H5Dopen(groupID, "ve");
 #endif
-  H5Dread(dataSetID, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+  H5Dread(dataSetID, tableType, H5S_ALL, H5S_ALL, H5P_DEFAULT,
           vegrid.data()); 
   H5Dclose(dataSetID);
   // Read the grid spacing.
@@ -72,7 +75,7 @@ GridPotential::GridPotential(const SimulationInfo& simInfo,
 #else
   dataSetID = H5Dopen(groupID, "Varary");
 #endif
-  H5Dread(dataSetID, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+  H5Dread(dataSetID, tableType, H5S_ALL, H5S_ALL, H5P_DEFAULT,
           piezogrid.data());
   H5Dclose(dataSetID);
   H5Gclose(groupID);
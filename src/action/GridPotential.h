@@ -21,6 +21,7 @@ class DisplaceMoveSampler;
 class Paths;
 class SimulationInfo;
 #include "action/Action.h"
+#include "util/TableReal.h"
 #include <string>
 #include <vector>
 #include <cstdlib>
@@ -34,7 +35,7 @@ class GridPotential : public Action {
 public:
   /// Typedefs.
   typedef blitz::Array<int,1> IArray;
-  typedef blitz::Array<double,NDIM> ArrayN;
+  typedef blitz::Array<TableReal,NDIM> ArrayN;
   typedef blitz::TinyVector<int,NDIM> IVecN;
   /// Constructor by providing an HDF5 file name and SimulationInfo.
   GridPotential(const SimulationInfo& simInfo, const std::string& filename, bool usePiezo);
@@ -2,6 +2,7 @@
 #include <config.h>
 #endif
 #include "ImagePairAction.h"
+#include "ImageSumTable.h"
 #include "advancer/SectionSamplerInterface.h"
 #include "base/Beads.h"
 #include "base/Paths.h"
@@ -13,22 +14,39 @@
 
 ImagePairAction::ImagePairAction(const Species& s1, const Species& s2,
             const std::string& filename, const SimulationInfo& simInfo, 
-            const int norder, const IVec nimage, const bool isDMD, int exLevel) 
+            const int norder, const IVec nimage, const bool isDMD, int exLevel,
+            const bool useImageTable) 
   : PairAction(s1, s2, filename, simInfo, norder, false, isDMD, exLevel), 
-    nimage(nimage) { 
+    nimage(nimage), imageTable(0) { 
   std::cout << "Using images: " << nimage << std::endl;
+  if (useImageTable) makeImageTable(*simInfo.getSuperCell());
 }
 
 ImagePairAction::ImagePairAction(const Species& s1, const Species& s2,
             const EmpiricalPairAction &action, 
             const SimulationInfo& simInfo, const int norder, const IVec nimage,
             const double rmin, const double rmax,
-            const int ngpts, int exLevel) 
+            const int ngpts, int exLevel, const bool useImageTable) 
   : PairAction(s1,s2,action,simInfo,norder,rmin,rmax,ngpts,false,exLevel),
-    nimage(nimage) {
+    nimage(nimage), imageTable(0) {
   std::cout << "Using images: " << nimage << std::endl;
+  if (useImageTable) makeImageTable(*simInfo.getSuperCell());
 } 
 
+ImagePairAction::~ImagePairAction() {
+  delete imageTable;
+}
+
+void ImagePairAction::makeImageTable(const SuperCell& cell) {
+  std::vector<Vec> images;
+  for (int img=-nimage[0]; img<=nimage[0]; ++img) {
+    if (img==0) continue;
+    Vec imgVec=0.; imgVec[0]=cell.a[0]*img;
+    images.push_back(imgVec);
+  }
+  if (!images.empty()) imageTable=new ImageSumTable(*this, cell, images);
+}
+
 double ImagePairAction::getActionDifference(const SectionSamplerInterface& sampler,
                                          const int level) {
   const Beads<NDIM>& sectionBeads=sampler.getSectionBeads();
@@ -58,8 +76,28 @@ double ImagePairAction::getActionDifference(const SectionSamplerInterface& sampl
       Vec prevDelta =sectionBeads(i,0);
       prevDelta-=sectionBeads(j,0); cell.pbc(prevDelta);
       Vec prevMovingDelta=prevDelta;
+      if (imageTable && i!=j) {
+        // Other images come from the table with the end-point approximation.
+        double prevW=(*imageTable)(prevDelta);
+        double prevMovingW=prevW;
+        for (int islice=nStride; islice<nSlice; islice+=nStride) {
+          Vec delta=movingBeads(iMoving,islice);
+          delta-=(isMoving)?movingBeads(jMoving,islice):sectionBeads(j,islice);
+          cell.pbc(delta);
+          double w=(*imageTable)(delta);
+          deltaAction+=0.5*(w+prevMovingW);
+          prevMovingW=w;
+          delta=sectionBeads(i,islice);
+          delta-=sectionBeads(j,islice);
+          cell.pbc(delta);
+          w=(*imageTable)(delta);
+          deltaAction-=0.5*(w+prevW);
+          prevW=w;
+        }
+      }
+      const int nimg=(imageTable)?0:nimage[0];
       //for (int img=-0; img<0; ++img) {
-      for (int img=-nimage[0]; img<=nimage[0]; ++img) {
+      for (int img=-nimg; img<=nimg; ++img) {
         if (img==0 && i==j) continue; //Skip self-interaction.
         Vec imgVec=0.; imgVec[0]=cell.a[0]*img;
         double prevR=sqrt(dot(prevDelta+imgVec,prevDelta+imgVec));
@@ -124,7 +162,8 @@ void ImagePairAction::getBeadAction(const Paths& paths, int ipart, int islice,
     prevDelta-=paths(j,islice,-1); cell.pbc(prevDelta);
     Vec nextDelta=paths(ipart,islice,+1);
     nextDelta-=paths(j,islice,+1); cell.pbc(nextDelta);
-    for (int img=-nimage[0]; img<=nimage[0]; ++img) {
+    const int nimg=(imageTable)?0:nimage[0];
+    for (int img=-nimg; img<=nimg; ++img) {
     //for (int img=0; img<=0; ++img) {
       if (img==0 && ipart==j) continue;
       Vec imgVec=0.; imgVec[0]=cell.a[0]*img;
@@ -144,5 +183,14 @@ void ImagePairAction::getBeadAction(const Paths& paths, int ipart, int islice,
       fp -= vq*(delta+imgVec)/(2*r) + vs2*(2*svec/(q*q) 
           - s2*(delta+imgVec)/(q*r));
     }
+    if (imageTable) {
+      // End-point action, half of each neighboring link on this bead.
+      double w,wtau; Vec grad;
+      imageTable->evalDerivatives(delta,w,wtau,grad);
+      u += 0.5*w;
+      utau += 0.5*wtau;
+      fm -= 0.5*grad;
+      fp -= 0.5*grad;
+    }
   }
 }
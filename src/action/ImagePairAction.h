@@ -20,6 +20,8 @@ class SectionSamplerInterface;class DisplaceMoveSampler;
 class Paths;
 class Species;
 class SimulationInfo;
+class SuperCell;
+class ImageSumTable;
 #include "PairAction.h"
 #include <cstdlib>
 #include <blitz/array.h>
@@ -50,6 +52,10 @@ class SimulationInfo;
 * and
 * @f[ \frac{\partial u}{\partial (s^2)}  
 *     =\sum_{k=1}^{N_{order}} k u_k(q)s^{2(k-1)}. @f]
+* By default every image along the first axis is evaluated exactly.
+* With useImageTable only the minimum image is exact, and the other
+* images are summed once into an ImageSumTable with the end-point
+* approximation, so the cost does not grow with the number of images.
 * @version $Revision$
 * @todo Make a version for non-coulomb actions.
 * @author John Shumway. */
@@ -60,18 +66,21 @@ public:
   /// Construct by providing the species and dmu filename.
   ImagePairAction(const Species&, const Species&, const std::string& filename,
     const SimulationInfo&, const int norder, const IVec nimage,
-    const bool isDMD, int exLevel);
+    const bool isDMD, int exLevel, const bool useImageTable);
   /// Construct by providing the species and dmu filename.
   ImagePairAction(const Species&, const Species&, const EmpiricalPairAction&,
     const SimulationInfo&, const int norder, const IVec nimage,
-    const double rmin, const double rmax, const int ngpts, int exLevel);
+    const double rmin, const double rmax, const int ngpts, int exLevel,
+    const bool useImageTable);
   /// Virtual destructor.
-  virtual ~ImagePairAction() {}
+  virtual ~ImagePairAction();
   /// Calculate the difference in action.
   virtual double getActionDifference(const SectionSamplerInterface&,
                                      int level);
  /// Calculate the total action.
   virtual double getTotalAction(const Paths&, const int level) const;
+  /// The total action with images is not implemented.
+  virtual bool hasTotalAction() const {return false;}
   /// Calculate the action and derivatives at a bead.
   virtual void getBeadAction(const Paths&, const int ipart, const int islice,
     double& u, double& utau, double& ulambda, Vec& fm, Vec& fp) const;
@@ -79,5 +88,9 @@ public:
 private:
   /// The number of images.
   const IVec nimage;
+  /// Table of the action summed over the other images, or null.
+  ImageSumTable *imageTable;
+  /// Set up the image table.
+  void makeImageTable(const SuperCell&);
 };
 #endif
@@ -0,0 +1,138 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "ImageSumTable.h"
+#include "PairAction.h"
+#include "util/SuperCell.h"
+#include <cmath>
+#include <iostream>
+#include <blitz/tinyvec-et.h>
+
+ImageSumTable::ImageSumTable(const PairAction& action, const SuperCell& cell,
+    const std::vector<Vec>& images, int ngrid)
+  : wire(NDIM>1) {
+  if (ngrid<1) ngrid=1;
+  for (unsigned int img=0; img<images.size(); ++img) {
+    for (int idim=1; idim<NDIM; ++idim) {
+      if (images[img][idim]!=0.) wire=false;
+    }
+  }
+  ntable=wire?2:NDIM;
+  nvalue=2+ntable;
+  for (int idim=0; idim<ntable; ++idim) {
+    npoint[idim]=ngrid+1;
+    delta[idim]=cell.a[idim]/ngrid;
+    origin[idim]=-0.5*cell.a[idim];
+  }
+  if (wire) {
+    // Radial grid out to the corner of the transverse cell.
+    double rhomax=0.;
+    for (int idim=1; idim<NDIM; ++idim) rhomax+=0.25*cell.a[idim]*cell.a[idim];
+    rhomax=sqrt(rhomax);
+    delta[1]=(rhomax>4*ngrid*delta[0])?rhomax/(4*ngrid):delta[0];
+    npoint[1]=(int)ceil(rhomax/delta[1])+1;
+    origin[1]=0.;
+  }
+  long ntotal=1;
+  for (int idim=0; idim<ntable; ++idim) {
+    deltaInv[idim]=1./delta[idim];
+    ntotal*=npoint[idim];
+  }
+  std::cout << "Image sum table: " << images.size() << " images, "
+            << ntotal << (wire?" wire":" cell") << " grid points" << std::endl;
+  table.resize(ntotal*nvalue);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (long ipoint=0; ipoint<ntotal; ++ipoint) {
+    // Separation at this grid point (along the second axis for a wire).
+    Vec r=0.;
+    long rem=ipoint;
+    for (int idim=ntable-1; idim>=0; --idim) {
+      r[idim]=origin[idim]+(rem%npoint[idim])*delta[idim];
+      rem/=npoint[idim];
+    }
+    double u=0., utau=0.;
+    Vec grad=0.;
+    for (unsigned int img=0; img<images.size(); ++img) {
+      Vec rimg=r+images[img];
+      double rmag=sqrt(dot(rimg,rimg));
+      if (rmag==0.) continue;
+      double v,vtau,vq,vs2;
+      action.uk0CalcDerivatives(rmag,0.,v,vtau,vq,vs2);
+      u+=v;
+      utau+=vtau;
+      grad+=vq*rimg/rmag;
+    }
+    double *p=&table[ipoint*nvalue];
+    p[0]=u;
+    p[1]=utau;
+    for (int idim=0; idim<ntable; ++idim) p[2+idim]=grad[idim];
+  }
+}
+
+double ImageSumTable::operator()(const Vec& r) const {
+  double x[NDIM], u;
+  getCoordinates(r,x);
+  interpolate(x,1,&u);
+  return u;
+}
+
+void ImageSumTable::evalDerivatives(const Vec& r, double& u, double& utau,
+                                    Vec& grad) const {
+  double x[NDIM], value[2+NDIM];
+  getCoordinates(r,x);
+  interpolate(x,nvalue,value);
+  u=value[0];
+  utau=value[1];
+  if (wire) {
+    grad=0.;
+    grad[0]=value[2];
+    double rho=0.;
+    for (int idim=1; idim<NDIM; ++idim) rho+=r[idim]*r[idim];
+    rho=sqrt(rho);
+    if (rho>0.) {
+      for (int idim=1; idim<NDIM; ++idim) grad[idim]=value[3]*r[idim]/rho;
+    }
+  } else {
+    for (int idim=0; idim<NDIM; ++idim) grad[idim]=value[2+idim];
+  }
+}
+
+void ImageSumTable::getCoordinates(const Vec& r, double *x) const {
+  for (int idim=0; idim<ntable; ++idim) x[idim]=r[idim];
+  if (wire) {
+    double rho2=0.;
+    for (int idim=1; idim<NDIM; ++idim) rho2+=r[idim]*r[idim];
+    x[1]=sqrt(rho2);
+  }
+  for (int idim=0; idim<ntable; ++idim) {
+    x[idim]=(x[idim]-origin[idim])*deltaInv[idim];
+  }
+}
+
+void ImageSumTable::interpolate(const double *x, int nval,
+                                double *value) const {
+  int i[NDIM];
+  double f[NDIM];
+  for (int idim=0; idim<ntable; ++idim) {
+    i[idim]=(int)floor(x[idim]);
+    if (i[idim]<0) i[idim]=0;
+    if (i[idim]>npoint[idim]-2) i[idim]=npoint[idim]-2;
+    f[idim]=x[idim]-i[idim];
+    if (f[idim]<0.) f[idim]=0.;
+    if (f[idim]>1.) f[idim]=1.;
+  }
+  for (int k=0; k<nval; ++k) value[k]=0.;
+  for (int corner=0; corner<(1<<ntable); ++corner) {
+    long index=0;
+    double w=1.;
+    for (int idim=0; idim<ntable; ++idim) {
+      int bit=(corner>>(ntable-1-idim))&1;
+      index=index*npoint[idim]+i[idim]+bit;
+      w*=bit?f[idim]:1.-f[idim];
+    }
+    const double *p=&table[index*nvalue];
+    for (int k=0; k<nval; ++k) value[k]+=w*p[k];
+  }
+}
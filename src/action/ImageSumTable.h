@@ -0,0 +1,54 @@
+#ifndef __ImageSumTable_h_
+#define __ImageSumTable_h_
+class PairAction;
+class SuperCell;
+#include <blitz/tinyvec.h>
+#include <vector>
+
+/** Table of a pair action summed over periodic images.
+* For a minimum-image separation @f$\mathbf{r}@f$ the table holds
+* @f[ W(\mathbf{r}) = \sum_{\mathbf{L}\ne 0} u_{00}(|\mathbf{r}+\mathbf{L}|) @f]
+* and its @f$\tau@f$ derivative and gradient, summed over a fixed set of
+* image vectors. The images are at least half a cell away, where the
+* off-diagonal (@f$s^2@f$) terms are negligible, so a link between
+* separations @f$\mathbf{r}@f$ and @f$\mathbf{r}'@f$ gets the end-point
+* action @f$[W(\mathbf{r})+W(\mathbf{r}')]/2@f$. This is an approximation
+* to the exact image loop, so the image pair actions only use the table
+* when it is requested.
+*
+* If all images lie along the first axis (a wire), W depends only on
+* the axial separation and the transverse distance, and the table is
+* two-dimensional. Otherwise it is an NDIM grid over the unit cell.
+* Values are interpolated multilinearly, so each lookup costs about
+* as much as a single PairAction lookup however many images are summed. */
+class ImageSumTable {
+public:
+  typedef blitz::TinyVector<double,NDIM> Vec;
+  /// Tabulate the image sum of the diagonal action with ngrid intervals
+  /// along each cell axis.
+  ImageSumTable(const PairAction&, const SuperCell&,
+                const std::vector<Vec>& images, int ngrid=32);
+  /// Get the image-summed action.
+  double operator()(const Vec& r) const;
+  /// Get the image-summed action, its tau derivative and gradient.
+  void evalDerivatives(const Vec& r, double& u, double& utau,
+                       Vec& grad) const;
+  /// Whether the images lie along a wire.
+  bool isWire() const {return wire;}
+private:
+  /// Number of table dimensions and values per grid point.
+  int ntable, nvalue;
+  /// Images along the first axis only.
+  bool wire;
+  /// Grid origin, spacing and number of points along each table dimension.
+  double origin[NDIM], delta[NDIM], deltaInv[NDIM];
+  int npoint[NDIM];
+  /// Values at each grid point: action, tau derivative and the
+  /// derivatives along each table dimension.
+  std::vector<double> table;
+  /// Map a separation to table coordinates.
+  void getCoordinates(const Vec& r, double *x) const;
+  /// Interpolate the first nval values at table coordinates x.
+  void interpolate(const double *x, int nval, double *value) const;
+};
+#endif
@@ -203,14 +203,13 @@ std::cout << "species1= " <<  s1 << "species2= " <<  s2 << std::endl;
     integrator.integrate(r);
     Array u = integrator.getU();
     for (int idata=0; idata<ndata; ++idata) ugrid(i,0,idata) = u(idata);
+    // Take the difference in double before storing it in the table.
     integrator.integrate(r,1.01);
-    u = integrator.getU();
-    for (int idata=0; idata<ndata; ++idata) ugrid(i,1,idata) = u(idata);
+    Array uplus = integrator.getU().copy();
     integrator.integrate(r,0.99);
     u = integrator.getU();
     for (int idata=0; idata<ndata; ++idata) {
-      ugrid(i,1,idata) -= u(idata);
-      ugrid(i,1,idata) /= 0.02*tau;
+      ugrid(i,1,idata) = (uplus(idata)-u(idata))/(0.02*tau);
     }
   }
 }
@@ -503,7 +502,76 @@ double PairAction::getActionDifference(const Paths &paths,
 }
 
 double PairAction::getTotalAction(const Paths& paths, int level) const {
-  return 0;
+  const SuperCell& cell=paths.getSuperCell();
+  const int nStride = 1 << level;
+  const bool isSameSpecies = (&species1==&species2);
+  double total=0;
+  for (int islice=paths.getLowestOwnedSlice(false);
+       islice<=paths.getHighestOwnedSlice(false); islice+=nStride) {
+    for (int i=ifirst1; i<ifirst1+npart1; ++i) {
+      // Count each pair once.
+      const int jbegin = isSameSpecies ? i+1 : ifirst2;
+      for (int j=jbegin; j<ifirst2+npart2; ++j) {
+        total+=linkAction(paths(i,islice),paths(i,islice,-nStride),
+                          paths(j,islice),paths(j,islice,-nStride),
+                          cell,level);
+      }
+    }
+  }
+  return total;
+}
+
+double PairAction::linkAction(const Vec& r1, const Vec& r1p,
+    const Vec& r2, const Vec& r2p, const SuperCell& cell, int level) const {
+  const int nStride = 1 << level;
+  const double invTauEff = 1./(tau*nStride);
+  Vec delta=r1-r2;
+  cell.pbc(delta);
+  Vec prevDelta=r1p-r2p;
+  cell.pbc(prevDelta);
+  double r=sqrt(dot(delta,delta));
+  double prevR=sqrt(dot(prevDelta,prevDelta));
+  double q=0.5*(r+prevR);
+  double action=0.;
+  if (level<3 && norder>0) {
+    Vec svec=delta-prevDelta; double s2=dot(svec,svec)/(q*q);
+    if (hasZ) {
+      double z=(r-prevR)/q;
+      action+=uk0(q,s2,z*z)*nStride;
+    } else {
+      action+=uk0(q,s2)*nStride;
+    }
+  } else {
+    action+=u00(q)*nStride;
+  }
+  if (level<=exLevel) {//Include exchange effect if requested.
+    Vec d1 = r1-r1p; Vec d2 = r2-r2p; Vec e1 = r1-r2p; Vec e2 = r2-r1p;
+    cell.pbc(d1); cell.pbc(d2); cell.pbc(e1); cell.pbc(e2);
+    double g0  = exp(-0.5*mass*(dot(d1,d1)+dot(d2,d2))*invTauEff);
+    double g0X = exp(-0.5*mass*(dot(e1,e1)+dot(e2,e2))*invTauEff);
+    if (g0X/g0 > 1e-100) {
+      double actX=0.;
+      if (level<3 && norder>0) {
+        Vec svec=delta+prevDelta; double s2=dot(svec,svec)/(q*q);
+        if (hasZ) {
+          double z=(r-prevR)/q;
+          actX+=uk0(q,s2,z*z)*nStride;
+        } else {
+          actX+=uk0(q,s2)*nStride;
+        }
+      } else {
+        actX+=u00(q)*nStride;
+      }
+      double gfull = g0*exp(-action)-g0X*exp(-actX);
+      double g0full = g0-g0X;
+      if (gfull>0 && g0full >0 && gfull<g0full) {
+        action = -log(gfull/g0full);
+      } else {
+        action = 0;
+      }
+    }
+  }
+  return action;
 }
 
 void PairAction::getBeadAction(const Paths& paths, int ipart, int islice,
@@ -21,7 +21,9 @@ class Paths;
 class Species;
 class SimulationInfo;
 class PairIntegrator;
+class SuperCell;
 #include "Action.h"
+#include "util/TableReal.h"
 #include <cstdlib>
 #include <blitz/array.h>
 
@@ -64,6 +66,7 @@ public:
   typedef blitz::Array<double,1> Array;
   typedef blitz::Array<double,2> Array2;
   typedef blitz::Array<double,3> Array3;
+  typedef blitz::Array<TableReal,3> TableArray3;
   /// Helper class for constructing from emprical action.
   class EmpiricalPairAction{public: 
     virtual double u(double r, int iorder) const=0;
@@ -99,9 +102,16 @@ public:
   /// Calculate the action and derivatives at a bead.
   virtual void getBeadAction(const Paths&, const int ipart, const int islice,
     double& u, double& utau, double& ulambda, Vec& fm, Vec& fp) const;
+  /// The total action is implemented.
+  virtual bool hasTotalAction() const {return true;}
   /// Write data tables to disk (defaults to speciesNames.dm[eu]).
     void write(const std::string &filename, const bool hasZ) const;
+  /// Only moves of the two species change this action.
+  virtual bool dependsOnSpecies(const Species& s) const {
+    return &s==&species1 || &s==&species2;
+  }
   friend class EwaldAction;
+  friend class ImageSumTable;
 protected:
   /// The timestep.
   const double tau;
@@ -112,13 +122,16 @@ protected:
   /// The log of the ratio of consecutive grid points.
   double logrratioinv;
   /// The action grid (radial coord is logrithmic).
-  Array3 ugrid;
+  TableArray3 ugrid;
   /// Evalute the diagonal action from the grid.
   double u00(double r) const;
   /// Evalute the off-diagonal action from the grid.
   double uk0(double q, double s2) const;
   /// Evalute the off-diagonal action from the grid.
   double uk0(double q, double s2, double z2) const;
+  /// Pair action on one link, from the separations at both ends.
+  double linkAction(const Vec& r1, const Vec& r1p, const Vec& r2,
+                    const Vec& r2p, const SuperCell&, int level) const;
   /// Evaluate the derivatives of the action from the grid.
   void uk0CalcDerivatives(double q, double s2, double &u,
             double &utau, double &uq, double &us2) const;
@@ -57,9 +57,30 @@ double PrimSHOAction::getActionDifference(
     return deltaAction;
 }
 
+bool PrimSHOAction::dependsOnSpecies(const Species& species) const {
+    return species.ifirst < ifirst + npart
+            && ifirst < species.ifirst + species.count;
+}
+
 double PrimSHOAction::getTotalAction(
         const Paths& paths, const int level) const {
-    return 0;
+    const SuperCell& cell = paths.getSuperCell();
+    const int nStride = 1 << level;
+    double ktstride = tau * nStride;
+    double total = 0;
+    for (int islice = paths.getLowestOwnedSlice(false);
+            islice <= paths.getHighestOwnedSlice(false); islice += nStride) {
+        for (int i = ifirst; i < ifirst + npart; ++i) {
+            Vec delta = paths(i, islice);
+            cell.pbc(delta);
+            double x2 = 0;
+            for (int idim = NDIM - ndim; idim < NDIM; ++idim) {
+                x2 += delta[idim] * delta[idim];
+            }
+            total += (a * x2 + b * x2 * x2) * ktstride;
+        }
+    }
+    return total;
 }
 
 void PrimSHOAction::getBeadAction(const Paths& paths, int ipart, int islice,
@@ -43,9 +43,13 @@ public:
                                      int level);
   /// Calculate the total action.
   virtual double getTotalAction(const Paths&, const int level) const;
+  /// The total action is implemented.
+  virtual bool hasTotalAction() const {return true;}
   /// Calculate the action and derivatives at a bead.
   virtual void getBeadAction(const Paths&, int ipart, int islice,
     double& u, double& utau, double& ulambda, Vec &fm, Vec &fp) const;
+  /// Only moves of this species change the action.
+  virtual bool dependsOnSpecies(const Species&) const;
 private:
   /// The timestep.
   const double tau;
@@ -64,8 +64,36 @@ double SHOAction::getActionDifference(const SectionSamplerInterface& sampler,
   return deltaAction;
 }
 
+bool SHOAction::dependsOnSpecies(const Species& species) const {
+  return species.ifirst<ifirst+npart && ifirst<species.ifirst+species.count;
+}
+
 double SHOAction::getTotalAction(const Paths& paths, const int level) const {
-  return 0;
+  const int nStride = 1 << level;
+  double wt=omega*tau*nStride;
+  double sinhwt=sinh(wt);
+  double coshwt=cosh(wt);
+  double m=mass;
+  double div1=1.0/(2.0*sinhwt);
+  double div2=1.0/(2.0*tau*nStride);
+  double total=0;
+  for (int islice=paths.getLowestOwnedSlice(false);
+       islice<=paths.getHighestOwnedSlice(false); islice+=nStride) {
+    for (int i=ifirst; i<ifirst+npart; ++i) {
+      Vec r1=paths(i,islice)-center;
+      Vec r0=paths(i,islice,-nStride)-center;
+      Vec delta=r1-r0;
+      double r0r0=0, r0r1=0, r1r1=0, delta2=0;
+      for (int idim=(NDIM-ndim); idim<NDIM; ++idim) {
+        r0r0+=r0[idim]*r0[idim];
+        r0r1+=r0[idim]*r1[idim];
+        r1r1+=r1[idim]*r1[idim];
+        delta2+=delta[idim]*delta[idim];
+      }
+      total+=m*omega*((r1r1+r0r0)*coshwt-2.0*r0r1)*div1-m*delta2*div2;
+    }
+  }
+  return total;
 }
 
 void SHOAction::getBeadAction(const Paths& paths, int ipart, int islice,
@@ -51,8 +51,12 @@ public:
             const VArray &displacement, int nmoving, const IArray &movingIndex,
             int iFirstSlice, int iLastSlice);
     virtual double getTotalAction(const Paths&, const int level) const;
+    virtual bool hasTotalAction() const {
+        return true;
+    }
     virtual void getBeadAction(const Paths&, int ipart, int islice, double& u,
             double& utau, double& ulambda, Vec& fm, Vec& fp) const;
+    virtual bool dependsOnSpecies(const Species&) const;
 private:
     const double tau;
     const double omega;
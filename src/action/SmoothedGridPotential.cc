@@ -1,12 +1,23 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
 #include <cstdlib>
 #include "SmoothedGridPotential.h"
 #include "base/Beads.h"
+#include "stats/MPIManager.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 
 SmoothedGridPotential::SmoothedGridPotential(const SimulationInfo& simInfo, const int maxLevel,
-                                             const std::string& filename)
+                                             const std::string& filename,
+                                             const std::string& cacheFile,
+                                             const std::string& wisdomFile,
+                                             const MPIManager* mpi)
   : tau(simInfo.getTau()), npart(simInfo.getNPart()), nlevel(maxLevel), vindex(npart) {
   std::cout << "Smoothed Grid Potential nlevel = " << nlevel << std::endl;
   // Read the bandoffsets from grid.h5.
@@ -27,10 +38,9 @@ SmoothedGridPotential::SmoothedGridPotential(const SimulationInfo& simInfo, cons
   H5Sget_simple_extent_dims(dataSpaceID, dims, NULL);
   H5Sclose(dataSpaceID);
   n(0)=dims[0]; n(1)=dims[1]; n(2)=dims[2];
-  vhtemp.resize(n);
+  Array3 vhtemp(n), vetemp(n);
   H5Dread(dataSetID, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
           vhtemp.data()); 
-  vetemp.resize(n);
   H5Dclose(dataSetID);
 #if (H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>=8))
   dataSetID = H5Dopen2(groupID, "ve", H5P_DEFAULT );
@@ -61,11 +71,6 @@ SmoothedGridPotential::SmoothedGridPotential(const SimulationInfo& simInfo, cons
   if(filename=="emagrids.h5")
     vhtemp*=-1;
 
-  CArray3 kvegrid, kvhgrid, vesmooth, vhsmooth;
-  kvegrid.resize(n);
-  kvhgrid.resize(n);
-  vesmooth.resize(n);
-  vhsmooth.resize(n);
   vegrid.resize(nlevel+1);
   vhgrid.resize(nlevel+1);
   //what do I do if only one e or h?
@@ -84,153 +89,250 @@ SmoothedGridPotential::SmoothedGridPotential(const SimulationInfo& simInfo, cons
   Vec e_m(0.067, 0.067, 0.067), h_m(0.08, 0.08, 0.45); //need to read these in
   std::cout<<"e_m = ["<<e_m(0)<<", "<<e_m(1)<<", "<<e_m(2)<<"]"<<std::endl;
   std::cout<<"h_m = ["<<h_m(0)<<", "<<h_m(1)<<", "<<h_m(2)<<"]"<<std::endl;
-  //FFT
-  fftw_plan phin = fftw_plan_dft(3, n.data(), (fftw_complex*)kvhgrid.data(), (fftw_complex*)kvhgrid.data(), FFTW_FORWARD, FFTW_MEASURE);
-  fftw_plan pein = fftw_plan_dft(3, n.data(), (fftw_complex*)kvegrid.data(), (fftw_complex*)kvegrid.data(), FFTW_FORWARD, FFTW_MEASURE);
-  fftw_plan phout = fftw_plan_dft(3, n.data(), (fftw_complex*)vhsmooth.data(), (fftw_complex*)vhsmooth.data(), FFTW_BACKWARD, FFTW_MEASURE);
-  fftw_plan peout = fftw_plan_dft(3, n.data(), (fftw_complex*)vesmooth.data(), (fftw_complex*)vesmooth.data(), FFTW_BACKWARD, FFTW_MEASURE);
-  for(int i=0; i<n(0); i++){
-    for(int j=0; j<n(1); j++){
-      for(int k=0; k<n(2); k++){
-        kvhgrid(i,j,k)=std::complex<double>(vhtemp(i,j,k),0.);
-        kvegrid(i,j,k)=std::complex<double>(vetemp(i,j,k),0.);
-      }
+  unsigned long long key=hashInput(vhtemp, vetemp, h_m, e_m);
+  // Only the main process writes the cache and the wisdom file; the others
+  // wait for it and then read the cache back.
+  const bool isMain=(mpi==0 || mpi->isMain());
+  if (isMain) {
+    if (readCache(cacheFile, key)) {
+      std::cout << "Read smoothed grids from " << cacheFile << std::endl;
+    } else {
+      smooth(vhtemp, vetemp, h_m, e_m, wisdomFile, true);
+      writeCache(cacheFile, key, h_m, e_m);
     }
   }
-  fftw_execute(phin);
-  fftw_execute(pein);
-  std::string name;
+#ifdef ENABLE_MPI
+  if (mpi) MPI::COMM_WORLD.Barrier();
+#endif
+  if (!isMain && !readCache(cacheFile, key)) {
+    smooth(vhtemp, vetemp, h_m, e_m, wisdomFile, false);
+  }
 
-  //loop over levels
-  std::cout<<"Smoothing level " << std::flush;
+  // Setup the vindex.
+  for(int i=0; i<simInfo.getNPart(); i++) {
+    std::string name=simInfo.getPartSpecies(i).name;
+    if(name.substr(0,1)=="h")
+      vindex(i)=0;
+    else if(name.substr(0,1)=="e")
+      vindex(i)=1;
+  }
+}
+
+SmoothedGridPotential::~SmoothedGridPotential(){
+}
+
+void SmoothedGridPotential::smooth(const Array3& vh, const Array3& ve,
+    const Vec& h_m, const Vec& e_m, const std::string& wisdomFile,
+    const bool saveWisdom) {
+  // Real-to-complex transforms only store the last dimension up to n/2.
+  const int nk2=n(2)/2+1;
+  const int nreal=blitz::product(n);
+  const int ncomplex=n(0)*n(1)*nk2;
+  double *real=(double*)fftw_malloc(sizeof(double)*nreal);
+  fftw_complex *kvh=(fftw_complex*)fftw_malloc(sizeof(fftw_complex)*ncomplex);
+  fftw_complex *kve=(fftw_complex*)fftw_malloc(sizeof(fftw_complex)*ncomplex);
+  fftw_complex *work=(fftw_complex*)fftw_malloc(sizeof(fftw_complex)*ncomplex);
+  // Plan once; FFTW_MEASURE is cheap when the wisdom file already has it.
+  fftw_import_wisdom_from_filename(wisdomFile.c_str());
+  fftw_plan fwd=fftw_plan_dft_r2c(3, n.data(), real, kvh, FFTW_MEASURE);
+  fftw_plan rev=fftw_plan_dft_c2r(3, n.data(), work, real, FFTW_MEASURE);
+  if (saveWisdom && !fftw_export_wisdom_to_filename(wisdomFile.c_str())) {
+    std::cout << "WARNING: could not write FFTW wisdom to "
+              << wisdomFile << std::endl;
+  }
+  std::copy(vh.data(), vh.data()+nreal, real);
+  fftw_execute_dft_r2c(fwd, real, kvh);
+  std::copy(ve.data(), ve.data()+nreal, real);
+  fftw_execute_dft_r2c(fwd, real, kve);
+
+  // Tabulate the separable Gaussian factors for every level and direction,
+  // so each level is a single sweep of products over k-space.
+  const double TWObPI=b*TWOPI;
+  blitz::Array<double,3> hfactor(nlevel+1,3,blitz::max(n)),
+                         efactor(nlevel+1,3,blitz::max(n));
   for(int ilevel=0; ilevel<=nlevel; ++ilevel){
-    std::cout << ilevel << " " << std::flush;
-    vhgrid(ilevel).resize(n);
-    vegrid(ilevel).resize(n);
-    vhsmooth=0., vesmooth=0.;
-    //smooth
-    Vec h_alpha=0., e_alpha=0.;
-    Vec h_norm=0., e_norm=0.;
     double sigma = (1 << ilevel) * tau / 24.0;
-    for(int i=0; i<3; i++){
-      h_alpha(i)=sigma/h_m(i);
-      e_alpha(i)=sigma/e_m(i);
-    }
-    double TWObPI=b*TWOPI;
-    //initialize periodic guassians and normalize
-    for (int i=0; i<3; i++) {
-      pgh(i) = new PeriodicGaussian(h_alpha(i),TWObPI);
-      pge(i) = new PeriodicGaussian(e_alpha(i),TWObPI);
-      pgh(i)->evaluate(0.0);
-      h_norm(i) = 1.0 / pgh(i)->getValue();
-      pge(i)->evaluate(0.0);
-      e_norm(i) = 1.0 / pge(i)->getValue();
-    }
-    double xhfactor=0., yhfactor=0., xefactor=0., yefactor=0.;
-    double ki, kj, kk;
-    for(int i=0; i<n(0); i++){
-      ki=((i<=n(0)/2)?i*TWObPI/n(0):(n(0)-i)*TWObPI/n(0));
-      pgh(0)->evaluate(ki);
-      pge(0)->evaluate(ki);
-      xhfactor = pgh(0)->getValue();
-      xefactor = pge(0)->getValue();
-      for(int j=0; j<n(1); j++){
-        kj=((j<=n(1)/2)?j*TWObPI/n(1):(n(1)-j)*TWObPI/n(1));
-        pgh(1)->evaluate(kj);
-        pge(1)->evaluate(kj);
-        xhfactor = pgh(1)->getValue();
-        xefactor = pge(1)->getValue();
-        for(int k=0; k<n(2); k++){
-          kk=((k<=n(2)/2)?k*TWObPI/n(2):(n(2)-k)*TWObPI/n(2));
-          pgh(2)->evaluate(kk);
-          pge(2)->evaluate(kk);
-          vhsmooth(i,j,k)=kvhgrid(i,j,k)*blitz::product(h_norm)*xhfactor*yhfactor*pgh(2)->getValue();
-          vesmooth(i,j,k)=kvegrid(i,j,k)*blitz::product(e_norm)*xefactor*yefactor*pge(2)->getValue();
-        }
+    for(int idim=0; idim<3; ++idim){
+      PeriodicGaussian pgh(sigma/h_m(idim),TWObPI);
+      PeriodicGaussian pge(sigma/e_m(idim),TWObPI);
+      double h_norm=1.0/pgh.evaluate(0.0);
+      double e_norm=1.0/pge.evaluate(0.0);
+      for(int i=0; i<n(idim); ++i){
+        double k=((i<=n(idim)/2)?i:(n(idim)-i))*TWObPI/n(idim);
+        hfactor(ilevel,idim,i)=h_norm*pgh.evaluate(k);
+        efactor(ilevel,idim,i)=e_norm*pge.evaluate(k);
       }
     }
-    //iFFT
-    fftw_execute(peout);
-    fftw_execute(phout);
-    for(int i=0; i<n(0); i++){
-      for(int j=0; j<n(1); j++){
-        for(int k=0; k<n(2); k++){
-          vegrid(ilevel)(i,j,k)=vesmooth(i,j,k).real();
-          vhgrid(ilevel)(i,j,k)=vhsmooth(i,j,k).real();
+  }
+
+  const double norm=1./(double)nreal;
+  std::cout<<"Smoothing level " << std::flush;
+  for(int ilevel=0; ilevel<=nlevel; ++ilevel){
+    std::cout << ilevel << " " << std::flush;
+    for(int ispec=0; ispec<2; ++ispec){
+      const fftw_complex *kv=(ispec==0)?kvh:kve;
+      const blitz::Array<double,3>& factor((ispec==0)?hfactor:efactor);
+      for(int i=0; i<n(0); i++){
+        const double fi=factor(ilevel,0,i);
+        for(int j=0; j<n(1); j++){
+          const double fij=fi*factor(ilevel,1,j);
+          const int ij=(i*n(1)+j)*nk2;
+          for(int k=0; k<nk2; k++){
+            const double f=fij*factor(ilevel,2,k);
+            work[ij+k][0]=kv[ij+k][0]*f;
+            work[ij+k][1]=kv[ij+k][1]*f;
+          }
         }
       }
+      fftw_execute(rev);
+      Array3& grid((ispec==0)?vhgrid(ilevel):vegrid(ilevel));
+      grid.resize(n);
+      double *g=grid.data();
+      for(int i=0; i<nreal; ++i) g[i]=real[i]*norm;
     }
-    double norm=1./(double)blitz::product(n);
-    vhgrid(ilevel)*=norm;
-    vegrid(ilevel)*=norm;
-    /*std::cout << "\tmin (eV)\tmean (eV)\tmax (eV)" <<std::endl;
-    std::cout << "h\t" << HATOEV*min(vhgrid(ilevel))
-              << "\t" << HATOEV*mean(vhgrid(ilevel))
-              << "\t" << HATOEV*max(vhgrid(ilevel)) << std::endl;
-    std::cout << "e\t" << HATOEV*min(vegrid(ilevel))
-              << "\t" << HATOEV*mean(vegrid(ilevel))
-              << "\t" << HATOEV*max(vegrid(ilevel)) << std::endl;*/
-
   }
   std::cout << std::endl << std::endl;
-  //clean up
-  fftw_destroy_plan(phin);
-  fftw_destroy_plan(pein);
-  fftw_destroy_plan(phout);
-  fftw_destroy_plan(peout);
-  fftw_cleanup();
+  fftw_destroy_plan(fwd);
+  fftw_destroy_plan(rev);
+  fftw_free(real);
+  fftw_free(kvh);
+  fftw_free(kve);
+  fftw_free(work);
+}
 
-  // Setup the vindex.
-  for(int i=0; i<simInfo.getNPart(); i++) {
-    std::string name=simInfo.getPartSpecies(i).name;
-    if(name.substr(0,1)=="h")
-      vindex(i)=0;
-    else if(name.substr(0,1)=="e")
-      vindex(i)=1;
-  }
-  //writeout
-  /*{
-    std::cout << "Writing the smoothed band offsets to emagrids.smoothed.h5" << std::endl;
-    system("cp emagrids.h5 emagrids.smoothed.h5");
-    std::string name;
-    H5::H5File file("emagrids.smoothed.h5", H5F_ACC_RDWR);
-    H5::Group Group(file.createGroup("boffset/smoothed"));
-    hsize_t dims[] = {n(0),n(1),n(2)};
-    hsize_t dims1[] = {1};
-    hsize_t dims3[] = {3};
-    H5::DataSpace dataSpace1(1,dims1);
-    H5::DataSpace dataSpace3(1,dims3);
-    H5::DataSpace dataSpace(3,dims);
-    double a=1./b;
-    H5::DataSet(Group.createDataSet("a", H5::PredType::NATIVE_DOUBLE, dataSpace1)).write(&a,H5::PredType::NATIVE_DOUBLE);
-    H5::DataSet(Group.createDataSet("tau", H5::PredType::NATIVE_DOUBLE, dataSpace1)).write(&tau,H5::PredType::NATIVE_DOUBLE);
-    H5::DataSet(Group.createDataSet("nlevel", H5::PredType::NATIVE_INT, dataSpace1)).write(&nlevel,H5::PredType::NATIVE_INT);
-    H5::DataSet(Group.createDataSet("m_e", H5::PredType::NATIVE_DOUBLE, dataSpace3)).write(e_m.data(),H5::PredType::NATIVE_DOUBLE);
-    H5::DataSet(Group.createDataSet("m_h", H5::PredType::NATIVE_DOUBLE, dataSpace3)).write(h_m.data(),H5::PredType::NATIVE_DOUBLE);
-    std::cout << "Writing level " << std::flush;
-    //loop over levels
-    for(int ilevel=0; ilevel<=nlevel; ++ilevel){
-      std::cout << ilevel << " " << std::flush;
-      std::ostringstream temp;
-      temp << ilevel;
-      name=temp.str();
-      H5::Group GroupS(Group.createGroup(name.c_str()));
-      H5::DataSet(GroupS.createDataSet("vh", H5::PredType::NATIVE_DOUBLE, dataSpace)).write(vhgrid(ilevel).data(),
-                                      H5::PredType::NATIVE_DOUBLE);
-      H5::DataSet(GroupS.createDataSet("ve", H5::PredType::NATIVE_DOUBLE, dataSpace)).write(vegrid(ilevel).data(),
-                                      H5::PredType::NATIVE_DOUBLE);
-      H5::DataSet(GroupS.createDataSet("level", H5::PredType::NATIVE_INT, dataSpace1)).write(&ilevel,
-                                      H5::PredType::NATIVE_INT);
+unsigned long long SmoothedGridPotential::hashInput(const Array3& vh,
+    const Array3& ve, const Vec& h_m, const Vec& e_m) const {
+  // 64-bit FNV-1a over the raw words of the inputs.
+  unsigned long long hash=14695981039346656037ULL;
+  const unsigned long long prime=1099511628211ULL;
+  const int nreal=blitz::product(n);
+  const Array3* grids[2]={&vh, &ve};
+  for(int igrid=0; igrid<2; ++igrid){
+    const double *data=grids[igrid]->data();
+    for(int i=0; i<nreal; ++i){
+      unsigned long long word;
+      std::memcpy(&word, data+i, sizeof(word));
+      hash=(hash^word)*prime;
     }
-    std::cout << std::endl;
-  }*/
+  }
+  double param[9]={b, tau, double(nlevel),
+                   h_m(0), h_m(1), h_m(2), e_m(0), e_m(1), e_m(2)};
+  for(int i=0; i<9; ++i){
+    unsigned long long word;
+    std::memcpy(&word, param+i, sizeof(word));
+    hash=(hash^word)*prime;
+  }
+  for(int i=0; i<3; ++i) hash=(hash^(unsigned long long)n(i))*prime;
+  return hash;
 }
 
-SmoothedGridPotential::~SmoothedGridPotential(){
-  for(int i=0; i<3; i++){
-    delete pgh(i);
-    delete pge(i);
+bool SmoothedGridPotential::readCache(const std::string& cacheFile,
+    unsigned long long key) {
+  if (!std::ifstream(cacheFile.c_str())) return false;
+  hid_t fileID = H5Fopen(cacheFile.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  if (fileID<0) return false;
+  unsigned long long cachedKey=0;
+#if (H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>=8))
+  hid_t dataSetID = H5Dopen2(fileID, "key", H5P_DEFAULT);
+#else
+  hid_t dataSetID = H5Dopen(fileID, "key");
+#endif
+  if (dataSetID<0) {
+    H5Fclose(fileID);
+    return false;
+  }
+  H5Dread(dataSetID, H5T_NATIVE_ULLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+          &cachedKey);
+  H5Dclose(dataSetID);
+  if (cachedKey!=key) {
+    H5Fclose(fileID);
+    return false;
   }
+  for(int ilevel=0; ilevel<=nlevel; ++ilevel){
+    std::ostringstream name;
+    name << ilevel;
+#if (H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>=8))
+    hid_t groupID = H5Gopen2(fileID, name.str().c_str(), H5P_DEFAULT);
+#else
+    hid_t groupID = H5Gopen(fileID, name.str().c_str());
+#endif
+    vhgrid(ilevel).resize(n);
+    vegrid(ilevel).resize(n);
+#if (H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>=8))
+    dataSetID = H5Dopen2(groupID, "vh", H5P_DEFAULT);
+#else
+    dataSetID = H5Dopen(groupID, "vh");
+#endif
+    H5Dread(dataSetID, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+            vhgrid(ilevel).data());
+    H5Dclose(dataSetID);
+#if (H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>=8))
+    dataSetID = H5Dopen2(groupID, "ve", H5P_DEFAULT);
+#else
+    dataSetID = H5Dopen(groupID, "ve");
+#endif
+    H5Dread(dataSetID, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+            vegrid(ilevel).data());
+    H5Dclose(dataSetID);
+    H5Gclose(groupID);
+  }
+  H5Fclose(fileID);
+  return true;
+}
+
+namespace {
+void writeCacheDataSet(hid_t locID, const char* name, hid_t typeID,
+                       int rank, const hsize_t* dims, const void* data) {
+  hid_t dataSpaceID = H5Screate_simple(rank, dims, NULL);
+#if (H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>=8))
+  hid_t dataSetID = H5Dcreate2(locID, name, typeID, dataSpaceID,
+                               H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+#else
+  hid_t dataSetID = H5Dcreate(locID, name, typeID, dataSpaceID, H5P_DEFAULT);
+#endif
+  H5Dwrite(dataSetID, typeID, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+  H5Dclose(dataSetID);
+  H5Sclose(dataSpaceID);
+}
+}
+
+void SmoothedGridPotential::writeCache(const std::string& cacheFile,
+    unsigned long long key, const Vec& h_m, const Vec& e_m) const {
+  hid_t fileID = H5Fcreate(cacheFile.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT,
+                           H5P_DEFAULT);
+  if (fileID<0) {
+    std::cout << "WARNING: could not write smoothed grid cache "
+              << cacheFile << std::endl;
+    return;
+  }
+  std::cout << "Writing smoothed grids to " << cacheFile << std::endl;
+  hsize_t dims1[] = {1};
+  hsize_t dims3[] = {3};
+  hsize_t dims[] = {(hsize_t)n(0),(hsize_t)n(1),(hsize_t)n(2)};
+  double a=1./b;
+  writeCacheDataSet(fileID, "a", H5T_NATIVE_DOUBLE, 1, dims1, &a);
+  writeCacheDataSet(fileID, "tau", H5T_NATIVE_DOUBLE, 1, dims1, &tau);
+  writeCacheDataSet(fileID, "nlevel", H5T_NATIVE_INT, 1, dims1, &nlevel);
+  writeCacheDataSet(fileID, "m_e", H5T_NATIVE_DOUBLE, 1, dims3, e_m.data());
+  writeCacheDataSet(fileID, "m_h", H5T_NATIVE_DOUBLE, 1, dims3, h_m.data());
+  for(int ilevel=0; ilevel<=nlevel; ++ilevel){
+    std::ostringstream name;
+    name << ilevel;
+#if (H5_VERS_MAJOR>1)||((H5_VERS_MAJOR==1)&&(H5_VERS_MINOR>=8))
+    hid_t groupID = H5Gcreate2(fileID, name.str().c_str(), H5P_DEFAULT,
+                               H5P_DEFAULT, H5P_DEFAULT);
+#else
+    hid_t groupID = H5Gcreate(fileID, name.str().c_str(), 0);
+#endif
+    writeCacheDataSet(groupID, "vh", H5T_NATIVE_DOUBLE, 3, dims,
+                      vhgrid(ilevel).data());
+    writeCacheDataSet(groupID, "ve", H5T_NATIVE_DOUBLE, 3, dims,
+                      vegrid(ilevel).data());
+    H5Gclose(groupID);
+  }
+  // Write the key last so an interrupted write is never mistaken for a hit.
+  writeCacheDataSet(fileID, "key", H5T_NATIVE_ULLONG, 1, dims1, &key);
+  H5Fclose(fileID);
 }
 
 double SmoothedGridPotential::getActionDifference(
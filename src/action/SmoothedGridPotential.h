@@ -24,6 +24,7 @@ class Paths;
 template <int TDIM> class Beads;
 class SimulationInfo;
 class PeriodicGuassian;
+class MPIManager;
 
 /** Class for getting action and potential from a grid with quantum smoothing.
   * As described in section 3.5 of Feynman's <em>Statistical Mechanics</em>,
@@ -32,10 +33,16 @@ class PeriodicGuassian;
   * U(r;\tau) = \left({\frac{6m}{\pi\tau}}\right)^{3/2}
   *        \int V(r-r')\exp\left[-\frac{6m(r-r')^2}{\tau}\right]\;d^3r'
   * @f]
+  *
+  * The smoothing uses one real-to-complex forward plan and one
+  * complex-to-real backward plan, with FFTW wisdom read from and saved to
+  * wisdomFile. The smoothed grids for all levels are written to cacheFile
+  * together with a hash of the input grids, @f$\tau@f$ and the masses,
+  * so later runs with the same inputs read them back instead of smoothing.
+  * Under MPI only the main process smooths and writes these files; the
+  * other processes read the cache once it has been written.
   * @todo Set up a potential table.
   * @todo Have simInfo contain the maximum number of levels.
-  * @todo use advanced FFTW interface to only plan once (one FFT, one iFFT)
-  * @todo use real DFT
   * @todo read in mass
   * @todo make scalar and vector mass routines
   * @bug Hard coded for SiGe ve and vh input.
@@ -65,7 +72,10 @@ public:
 
   /// Constructor by providing an HDF5 file name and SimulationInfo.
   SmoothedGridPotential(const SimulationInfo& simInfo, const int maxLevel,
-                        const std::string& filename);
+                        const std::string& filename,
+                        const std::string& cacheFile="smoothedgrids.h5",
+                        const std::string& wisdomFile="fftw.wisdom",
+                        const MPIManager* mpi=0);
   /// Destructor.
   ~SmoothedGridPotential();
   /// Calculate the difference in action.
@@ -87,10 +97,6 @@ private:
   double b;
   /// The number of levels stored on grids.
   int nlevel;
-  /// temporary electron grids.
-  Array3 vetemp;
-  ///temporary hole grids.
-  Array3 vhtemp;
   /// The electron action grids.
   Array3Array vegrid;
   /// The hole action grids.
@@ -99,9 +105,17 @@ private:
   double v(Vec, const int ipart, int ilevel) const;
   /// The grid index that associates the particles and temperatures to the grids.
   IArray vindex;
-  ///Peridic Gaussians for hole smoothing
-  PGVec pgh;
-  ///Peridic Gaussians for electron smoothing
-  PGVec pge;
+  /// Smooth the hole and electron grids for every level.
+  void smooth(const Array3& vh, const Array3& ve, const Vec& h_m,
+              const Vec& e_m, const std::string& wisdomFile,
+              bool saveWisdom);
+  /// Read the smoothed grids from the cache, returning false on a miss.
+  bool readCache(const std::string& cacheFile, unsigned long long key);
+  /// Write the smoothed grids to the cache.
+  void writeCache(const std::string& cacheFile, unsigned long long key,
+                  const Vec& h_m, const Vec& e_m) const;
+  /// Hash the input grids and the smoothing parameters.
+  unsigned long long hashInput(const Array3& vh, const Array3& ve,
+                               const Vec& h_m, const Vec& e_m) const;
 };
 #endif
@@ -0,0 +1,77 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "SpeciesRouting.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+
+SpeciesRouting::SpeciesRouting() : nspecies(0), ntable(0) {
+}
+
+void SpeciesRouting::setup(const SimulationInfo& simInfo,
+                           const std::vector<bool>& dependsOn) {
+  nspecies=simInfo.getNSpecies();
+  ntable=(nspecies>0) ? dependsOn.size()/nspecies : 0;
+  this->dependsOn=dependsOn;
+  const int npart=simInfo.getNPart();
+  partSpecies.resize(npart);
+  for (int i=0; i<npart; ++i) {
+    const Species* species=&simInfo.getPartSpecies(i);
+    partSpecies[i]=0;
+    for (int ispec=0; ispec<nspecies; ++ispec) {
+      if (species==&simInfo.getSpecies(ispec)) partSpecies[i]=ispec;
+    }
+  }
+  moving.assign(nspecies,false);
+  lastMoving.clear();
+  lastRoute.clear();
+}
+
+const std::vector<int>& SpeciesRouting::route(const IArray& index,
+    const int nmoving, const int naction) {
+  // Fall back to every action if the table is missing or out of date.
+  if (nspecies==0 || naction!=ntable) return routeAll(naction);
+  moving.assign(nspecies,false);
+  for (int i=0; i<nmoving; ++i) moving[partSpecies[index(i)]]=true;
+  return routeMoving(naction);
+}
+
+const std::vector<int>& SpeciesRouting::route(const IArray& index1,
+    const IArray& index2, const int naction) {
+  if (nspecies==0 || naction!=ntable) return routeAll(naction);
+  moving.assign(nspecies,false);
+  for (int i=0; i<index1.size(); ++i) moving[partSpecies[index1(i)]]=true;
+  for (int i=0; i<index2.size(); ++i) moving[partSpecies[index2(i)]]=true;
+  return routeMoving(naction);
+}
+
+const std::vector<int>& SpeciesRouting::routeMoving(const int naction) {
+  if (moving==lastMoving) return lastRoute;
+  lastMoving=moving;
+  lastRoute.clear();
+  for (int iaction=0; iaction<naction; ++iaction) {
+    for (int ispec=0; ispec<nspecies; ++ispec) {
+      if (moving[ispec] && dependsOn[iaction*nspecies+ispec]) {
+        lastRoute.push_back(iaction);
+        break;
+      }
+    }
+  }
+  return lastRoute;
+}
+
+const std::vector<int>& SpeciesRouting::getLastRoute(const int naction) {
+  if (nspecies==0 || naction!=ntable || lastMoving.empty()) {
+    return routeAll(naction);
+  }
+  return lastRoute;
+}
+
+const std::vector<int>& SpeciesRouting::routeAll(const int naction) {
+  lastMoving.clear();
+  if ((int)lastRoute.size()!=naction) {
+    lastRoute.resize(naction);
+    for (int iaction=0; iaction<naction; ++iaction) lastRoute[iaction]=iaction;
+  }
+  return lastRoute;
+}
@@ -0,0 +1,54 @@
+#ifndef __SpeciesRouting_h_
+#define __SpeciesRouting_h_
+class SimulationInfo;
+#include <cstdlib>
+#include <blitz/array.h>
+#include <vector>
+
+/** Table of the actions in a composite that involve each species.
+  * CompositeAction and CompositeDoubleAction use it so that a trial move
+  * only calls the actions that depend on the species of the moving
+  * particles, instead of every action scanning the moving index for
+  * particles it does not interact with. The route of the last move is
+  * kept, both so a move of the same species reuses it and so
+  * acceptLastMove goes to the same actions that computed the difference.
+  * Until setup is called every action is on the route. */
+class SpeciesRouting {
+public:
+  typedef blitz::Array<int,1> IArray;
+  SpeciesRouting();
+  /// Set the species of each particle and, in dependsOn[iaction*nspecies
+  /// +ispecies], whether each action depends on each species.
+  void setup(const SimulationInfo&, const std::vector<bool>& dependsOn);
+  /// Actions to call for a move of the first nmoving particles in index.
+  const std::vector<int>& route(const IArray& index, int nmoving,
+                                int naction);
+  /// Actions to call for a move of all particles in index.
+  const std::vector<int>& route(const IArray& index, int naction) {
+    return route(index,index.size(),naction);
+  }
+  /// Actions to call for a move of all particles in two indices, as when
+  /// a double sampler moves both sections.
+  const std::vector<int>& route(const IArray& index1, const IArray& index2,
+                                int naction);
+  /// Actions on the route of the last move.
+  const std::vector<int>& getLastRoute(int naction);
+private:
+  /// Number of species (zero until setup).
+  int nspecies;
+  /// Number of actions the table was built for.
+  int ntable;
+  /// Species index of each particle.
+  std::vector<int> partSpecies;
+  /// Dependence of each action on each species.
+  std::vector<bool> dependsOn;
+  /// Species moved in the current and last routed moves.
+  std::vector<bool> moving, lastMoving;
+  /// Actions on the last route.
+  std::vector<int> lastRoute;
+  /// Put every action on the route.
+  const std::vector<int>& routeAll(int naction);
+  /// Route the species flagged in moving.
+  const std::vector<int>& routeMoving(int naction);
+};
+#endif
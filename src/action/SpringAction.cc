@@ -106,7 +106,26 @@ double SpringAction::getActionDifference(const Paths &paths,
 
 
 double SpringAction::getTotalAction(const Paths& paths, int level) const {
-  return 0;
+  const int nStride = 1 << level;
+  const int npart=paths.getNPart();
+  double total=0;
+  for (int islice=paths.getLowestOwnedSlice(false);
+       islice<=paths.getHighestOwnedSlice(false); islice+=nStride) {
+    for (int i=0; i<npart; ++i) {
+      if (isStatic(i)) continue;
+      const int ispec=specIndex(i);
+      const double inv2Sigma2 = 0.25/(lambda(i)*tau*nStride);
+      Vec delta=paths.delta(i,islice,-nStride);
+      for (int idim=0;idim<NDIM;++idim) {
+        if (pg(level,ispec,idim)) {
+          total-=log(pg(level,ispec,idim)->evaluate(delta[idim]));
+        } else {
+          total+=delta[idim]*delta[idim]*inv2Sigma2;
+        }
+      }
+    }
+  }
+  return total;
 }
 
 void SpringAction::getBeadAction(const Paths& paths, int ipart, int islice,
@@ -52,6 +52,8 @@ public:
     int nmoving, const IArray &movingIndex, int iFirstSlice, int iLastSlice);
   /// Calculate the total action.
   virtual double getTotalAction(const Paths&, const int level) const;
+  /// The total action is implemented.
+  virtual bool hasTotalAction() const {return true;}
   /// Calculate action and derivatives at a bead (defaults to no
   /// contribution).
   virtual void getBeadAction(const Paths&, const int ipart, const int islice,
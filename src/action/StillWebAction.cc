@@ -6,6 +6,7 @@
 #include "base/Beads.h"
 #include "base/Paths.h"
 #include "base/SimulationInfo.h"
+#include "util/CellList.h"
 #include "util/SuperCell.h"
 #include <cstdlib>
 #include <blitz/tinyvec.h>
@@ -16,7 +17,8 @@ StillWebAction::StillWebAction(const SimulationInfo &simInfo,
     tau(simInfo.getTau()),
     npart(simInfo.getNPart()),
     A(7.049556277),
-    B(0.6022245584), p(4), q(0), a(1.80), gamma(1.20), param(3) {
+    B(0.6022245584), p(4), q(0), a(1.80), gamma(1.20), param(3),
+    slicePos(npart), cellSlice(-1), cellBeads(0), lastSampler(0) {
   // Si-Si:
   param[0].lambda=21.0;
   param[0].sigmainv=1./((2.347772155/0.529177)/pow(2,1./6));
@@ -29,6 +31,13 @@ StillWebAction::StillWebAction(const SimulationInfo &simInfo,
   param[2].lambda=31.0;
   param[2].sigmainv=1./((2.44598/0.529177)/pow(2,1./6));
   param[2].epsilon=(1.93/27.211);
+  // Both f2 and h vanish beyond a*sigma.
+  rcut=a/param[0].sigmainv;
+  sliceCells=new CellList(*simInfo.getSuperCell(),rcut,npart);
+}
+
+StillWebAction::~StillWebAction() {
+  delete sliceCells;
 }
 
 double StillWebAction::getActionDifference(const SectionSamplerInterface& sampler,
@@ -40,40 +49,30 @@ double StillWebAction::getActionDifference(const SectionSamplerInterface& sample
   const int nSlice=sectionBeads.getNSlice();
   const IArray& index=sampler.getMovingIndex(); 
   const int nMoving=index.size();
+  if (cellBeads!=&sectionBeads || (int)sectionCells.size()!=nSlice) {
+    buildSectionCells(sectionBeads,cell);
+  }
+  lastSampler=&sampler;
   double deltaAction=0;
   double taueff = tau*nStride;
+  double pairSum, tripletSum;
   for (int islice=nStride; islice<nSlice-nStride; islice+=nStride) {
     for (int iMoving=0; iMoving<nMoving; ++iMoving) {
       const int i=index(iMoving);
-      for (int jpart=0; jpart<npart; ++jpart) {
-        if (jpart==i) continue;
-        Vec deltaj=movingBeads(iMoving,islice)-sectionBeads(jpart,islice);
-        cell.pbc(deltaj);
-        double rij=sqrt(dot(deltaj,deltaj));
-        deltaAction+=f2(rij,0,0)*taueff;
-        for (int kpart=0; kpart<jpart; ++kpart) {
-          if (kpart==i) continue;
-          // Add action for moving beads.
-          Vec deltak=movingBeads(iMoving,islice)-sectionBeads(kpart,islice);
-          cell.pbc(deltak);
-          double rik=sqrt(dot(deltak,deltak));
-          double costheta=dot(deltaj,deltak)/(rij*rik);
-          deltaAction+=h(rij,rik,costheta,0,0,0)*taueff;
-        }
-        deltaj=sectionBeads(i,islice)-sectionBeads(jpart,islice);
-        cell.pbc(deltaj);
-        rij=sqrt(dot(deltaj,deltaj));
-        deltaAction-=f2(rij,0,0)*taueff;
-        for (int kpart=0; kpart<jpart; ++kpart) {
-          if (kpart==i) continue;
-          // Subtract action for old beads.
-          Vec deltak=sectionBeads(i,islice)-sectionBeads(kpart,islice);
-          cell.pbc(deltak);
-          double rik=sqrt(dot(deltak,deltak));
-          double costheta=dot(deltaj,deltak)/(rij*rik);
-          deltaAction-=h(rij,rik,costheta,0,0,0)*taueff;
-        }
-      }
+      // Add action for moving beads.
+      Vec ri=movingBeads(iMoving,islice);
+      candidates.clear();
+      sectionCells[islice].getCandidates(ri,candidates);
+      findNeighbors(ri,i,sectionBeads,islice,cell);
+      sumNeighbors(pairSum,tripletSum);
+      deltaAction+=(pairSum+tripletSum)*taueff;
+      // Subtract action for old beads.
+      ri=sectionBeads(i,islice);
+      candidates.clear();
+      sectionCells[islice].getCandidates(ri,candidates);
+      findNeighbors(ri,i,sectionBeads,islice,cell);
+      sumNeighbors(pairSum,tripletSum);
+      deltaAction-=(pairSum+tripletSum)*taueff;
     }
   }
   return deltaAction;
@@ -86,27 +85,94 @@ double StillWebAction::getTotalAction(const Paths& paths,
 
 void StillWebAction::getBeadAction(const Paths& paths, int ipart, int islice,
      double& u, double& utau, double& ulambda, Vec &fm, Vec &fp) const {
-  Vec ri=paths(ipart,islice);
   const SuperCell &cell = paths.getSuperCell();
-  utau=0.;
-  for (int jpart=0; jpart<npart; ++jpart) {
-    if (jpart==ipart) continue;
-    Vec deltaj=ri-paths(jpart,islice);
-    cell.pbc(deltaj);
-    double rij=sqrt(dot(deltaj,deltaj));
-    utau+=0.5*f2(rij,0,0);
-    for (int kpart=0; kpart<jpart; ++kpart) {
-      if (kpart==ipart) continue;
-      Vec deltak=ri-paths(kpart,islice);
-      cell.pbc(deltak);
-      double rik=sqrt(dot(deltak,deltak));
-      double costheta=dot(deltaj,deltak)/(rij*rik);
-      utau+=h(rij,rik,costheta,0,0,0);
+  // Bin the slice once, on the first particle.
+  if (ipart==0 || islice!=cellSlice) {
+    paths.getSlice(islice,slicePos);
+    sliceCells->clear();
+    for (int jpart=0; jpart<npart; ++jpart) {
+      sliceCells->move(jpart,slicePos(jpart));
     }
+    cellSlice=islice;
+  }
+  Vec ri=slicePos(ipart);
+  candidates.clear();
+  sliceCells->getCandidates(ri,candidates);
+  neighborDelta.clear();
+  neighborR.clear();
+  for (unsigned int n=0; n<candidates.size(); ++n) {
+    const int jpart=candidates[n];
+    if (jpart!=ipart) addNeighbor(ri-slicePos(jpart),cell);
   }
+  double pairSum, tripletSum;
+  sumNeighbors(pairSum,tripletSum);
+  utau=0.5*pairSum+tripletSum;
   u=utau*tau;
 }
 
+void StillWebAction::initialize(const SectionChooser&) {
+  // The section beads have been reloaded, so rebuild the cells when needed.
+  cellBeads=0;
+  lastSampler=0;
+}
+
+void StillWebAction::acceptLastMove() {
+  if (!lastSampler || !cellBeads) return;
+  const Beads<NDIM>& movingBeads=lastSampler->getMovingBeads();
+  const IArray& index=lastSampler->getMovingIndex();
+  const int nSlice=movingBeads.getNSlice();
+  for (int islice=0; islice<nSlice; ++islice) {
+    for (int iMoving=0; iMoving<index.size(); ++iMoving) {
+      sectionCells[islice].move(index(iMoving),movingBeads(iMoving,islice));
+    }
+  }
+}
+
+void StillWebAction::buildSectionCells(const Beads<NDIM>& sectionBeads,
+                                       const SuperCell& cell) const {
+  const int nSlice=sectionBeads.getNSlice();
+  sectionCells.assign(nSlice,CellList(cell,rcut,npart));
+  for (int islice=0; islice<nSlice; ++islice) {
+    for (int jpart=0; jpart<npart; ++jpart) {
+      sectionCells[islice].move(jpart,sectionBeads(jpart,islice));
+    }
+  }
+  cellBeads=&sectionBeads;
+}
+
+void StillWebAction::findNeighbors(const Vec& ri, const int ipart,
+    const Beads<NDIM>& beads, const int islice, const SuperCell& cell) const {
+  neighborDelta.clear();
+  neighborR.clear();
+  for (unsigned int n=0; n<candidates.size(); ++n) {
+    const int jpart=candidates[n];
+    if (jpart!=ipart) addNeighbor(ri-beads(jpart,islice),cell);
+  }
+}
+
+void StillWebAction::addNeighbor(Vec delta, const SuperCell& cell) const {
+  cell.pbc(delta);
+  double r=sqrt(dot(delta,delta));
+  if (r<rcut) {
+    neighborDelta.push_back(delta);
+    neighborR.push_back(r);
+  }
+}
+
+void StillWebAction::sumNeighbors(double& pairSum, double& tripletSum) const {
+  pairSum=tripletSum=0.;
+  const int nneighbor=neighborR.size();
+  for (int j=0; j<nneighbor; ++j) {
+    const double rij=neighborR[j];
+    pairSum+=f2(rij,0,0);
+    for (int k=0; k<j; ++k) {
+      const double rik=neighborR[k];
+      double costheta=dot(neighborDelta[j],neighborDelta[k])/(rij*rik);
+      tripletSum+=h(rij,rik,costheta,0,0,0);
+    }
+  }
+}
+
 
 double StillWebAction::h(const double r1, const double r2, 
                    const double costheta,
@@ -20,6 +20,8 @@ class SectionSamplerInterface;class DisplaceMoveSampler;
 template <int TDIM> class Beads;
 #include "Action.h"
 class SimulationInfo;
+class SuperCell;
+class CellList;
 #include <cstdlib>
 #include <blitz/array.h>
 #include <vector>
@@ -43,8 +45,13 @@ class SimulationInfo;
   *
   * Si-Si lattice paramters is 10.246 Bohr radii (T=0K). 
   *
+  * Both terms vanish beyond @f$r=a\sigma@f$, so neighbors come from
+  * cell lists with that cutoff. Each slice of a section has its own
+  * CellList, built when a new section is sampled and updated on accepted
+  * moves, and getBeadAction bins each slice once. Only triplets of
+  * actual neighbors are enumerated.
+  *
   * @bug Assumes only one particle is moving.
-  * @todo Add neighbor table.
   * @version $Revision$
   * @author John Shumway. */
 class StillWebAction : public Action {
@@ -56,7 +63,7 @@ public:
   /// file (for neighbor tables).
   StillWebAction(const SimulationInfo&, const std::string &filename);
   /// Virtual destructor.
-  virtual ~StillWebAction() {}
+  virtual ~StillWebAction();
   /// Calculate the difference in action.
   virtual double getActionDifference(const SectionSamplerInterface&,
                                      int level);
@@ -65,6 +72,10 @@ public:
   /// Calculate the action and derivatives at a bead.
   virtual void getBeadAction(const Paths&, int ipart, int islice,
      double& u, double& utau, double& ulambda, Vec &fm, Vec &fp) const;
+  /// Initialize for a sampling section.
+  virtual void initialize(const SectionChooser&);
+  /// Move the accepted beads in the section cell lists.
+  virtual void acceptLastMove();
 
   /// Evaluate the pair potential.
   virtual double f2(const double r, const int i, const int j) const;
@@ -94,9 +105,30 @@ private:
   double gamma;
   /// Parameters for SiSi, GeGe, SiGe. 
   std::vector<SWParam> param;
-  /// Neighbor tables.
-  Array2 nn;
-  /// Maximum number of neighbors in neighbor table.
-  int nnmax;
+  /// Cutoff distance of the potential.
+  double rcut;
+  /// Cell lists for each slice of the current section.
+  mutable std::vector<CellList> sectionCells;
+  /// Cell list and positions for the slice in getBeadAction.
+  CellList *sliceCells;
+  mutable VArray slicePos;
+  mutable int cellSlice;
+  /// Section beads the cell lists were built from (0 if out of date).
+  mutable const Beads<NDIM> *cellBeads;
+  /// Sampler of the last action difference, for acceptLastMove.
+  const SectionSamplerInterface *lastSampler;
+  /// Buffers for candidate and actual neighbors of a bead.
+  mutable std::vector<int> candidates;
+  mutable std::vector<Vec> neighborDelta;
+  mutable std::vector<double> neighborR;
+  /// Bin the section beads in the section cell lists.
+  void buildSectionCells(const Beads<NDIM>&, const SuperCell&) const;
+  /// Find the neighbors of position ri among the candidates.
+  void findNeighbors(const Vec& ri, const int ipart, const Beads<NDIM>&,
+                     const int islice, const SuperCell&) const;
+  /// Add a neighbor if it is within the cutoff.
+  void addNeighbor(Vec delta, const SuperCell&) const;
+  /// Sum f2 over the neighbors and h over pairs of neighbors.
+  void sumNeighbors(double& pairSum, double& tripletSum) const;
 };
 #endif
@@ -0,0 +1,172 @@
+#include "CoulombLinkTable.h"
+#include "Coulomb1DLinkAction.h"
+#include "Coulomb3DLinkAction.h"
+#include "CoulombLinkAction.h"
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <blitz/tinyvec-et.h>
+
+CoulombLinkTable::CoulombLinkTable(double q1q2, double epsilon, double mu,
+        double deltaTau, int norder, int ngrid) :
+        q1q2(q1q2),
+        epsilon(epsilon),
+        mu(mu),
+        deltaTau(deltaTau),
+        norder(norder),
+        ngrid(ngrid),
+        r0(sqrt(deltaTau / (2.0 * mu))),
+        maxError(0.),
+        value((ngrid + 1) * (norder + 1)),
+        secondDerivative((ngrid + 1) * (norder + 1)) {
+    const int n = norder + 1;
+    // The limits of U_k/x^2m at r=0 are taken slightly off the origin,
+    // where the fits lose precision; at t=1 (r infinite) every U_k vanishes.
+    calculateExact(1e-3 / ngrid, &value[0]);
+    double origin[5];
+    calculateExact(0., origin);
+    value[0] = origin[0];
+    for (int i = 1; i < ngrid; ++i) {
+        double t = (double) i / ngrid;
+        calculateExact(t / (1. - t), &value[i * n]);
+    }
+    for (int k = 0; k < n; ++k) value[ngrid * n + k] = 0.;
+    makeSplines();
+    checkAccuracy();
+}
+
+CoulombLinkTable::~CoulombLinkTable() {
+}
+
+const CoulombLinkTable* CoulombLinkTable::getTable(double q1q2,
+        double epsilon, double mu, double deltaTau, int norder) {
+    typedef std::map<std::vector<double>, CoulombLinkTable*> Cache;
+    static Cache cache;
+    std::vector<double> key(5);
+    key[0] = q1q2;
+    key[1] = epsilon;
+    key[2] = mu;
+    key[3] = deltaTau;
+    key[4] = norder;
+    Cache::iterator entry = cache.find(key);
+    if (entry != cache.end()) return entry->second;
+    CoulombLinkTable *table =
+            new CoulombLinkTable(q1q2, epsilon, mu, deltaTau, norder);
+    cache[key] = table;
+    return table;
+}
+
+double CoulombLinkTable::getValue(Vec delta1, Vec delta2) const {
+    double r = CoulombLinkAction::calculateAverageSeparation(delta1, delta2);
+    double s2 = CoulombLinkAction::calculateS2(delta1, delta2)
+            / (r * r + 1e-200);
+    double x = r / r0;
+    double g[5], w[5];
+    interpolate(x / (1. + x), g);
+    calculateWeights(x, w);
+    double u = 0.;
+    double s2k = 1.;
+    for (int k = 0; k <= norder; ++k) {
+        u += g[k] * w[k] * s2k;
+        s2k *= s2;
+    }
+    return u;
+}
+
+double CoulombLinkTable::getMaxError() const {
+    return maxError;
+}
+
+void CoulombLinkTable::calculateExact(double x, double *g) const {
+    double stau = q1q2 / epsilon * sqrt(2.0 * mu * deltaTau);
+    Coulomb1DLinkAction coulomb1D(stau);
+    Coulomb3DLinkAction coulomb3D(coulomb1D);
+    double reff = 2.0 * mu * q1q2 * x * r0 / epsilon;
+    double w[5];
+    calculateWeights(x, w);
+    g[0] = coulomb3D.calculateU0(reff);
+    if (norder > 0) g[1] = coulomb3D.calculateU1(reff);
+    if (norder > 1) g[2] = coulomb3D.calculateU2(reff);
+    if (norder > 2) g[3] = coulomb3D.calculateU3(reff);
+    if (norder > 3) g[4] = coulomb3D.calculateU4(reff);
+    for (int k = 1; k <= norder; ++k) g[k] = (x > 0.) ? g[k] / w[k] : 0.;
+}
+
+void CoulombLinkTable::calculateWeights(double x, double *w) const {
+    // U_k goes as x^2k for small x, except U_4, which goes as x^6.
+    double x2 = x * x;
+    double x2m = 1.;
+    w[0] = 1.;
+    for (int k = 1; k <= norder; ++k) {
+        if (k < 4) x2m *= x2;
+        w[k] = x2m / (1. + x2m);
+    }
+}
+
+void CoulombLinkTable::interpolate(double t, double *g) const {
+    const int n = norder + 1;
+    double s = t * ngrid;
+    int i = (int) s;
+    if (i > ngrid - 1) i = ngrid - 1;
+    double b = s - i;
+    double a = 1. - b;
+    double h2 = 1. / (6. * ngrid * ngrid);
+    double ca = (a * a * a - a) * h2;
+    double cb = (b * b * b - b) * h2;
+    const double *y = &value[i * n];
+    const double *y2 = &secondDerivative[i * n];
+    for (int k = 0; k < n; ++k) {
+        g[k] = a * y[k] + b * y[k + n] + ca * y2[k] + cb * y2[k + n];
+    }
+}
+
+void CoulombLinkTable::makeSplines() {
+    // Natural cubic splines on the uniform grid (tridiagonal solve).
+    const int n = norder + 1;
+    const double h = 1. / ngrid;
+    std::vector<double> c(ngrid + 1);
+    for (int k = 0; k < n; ++k) {
+        secondDerivative[k] = 0.;
+        c[0] = 0.;
+        for (int i = 1; i < ngrid; ++i) {
+            double rhs = 6. * (value[(i + 1) * n + k] - 2. * value[i * n + k]
+                    + value[(i - 1) * n + k]) / (h * h);
+            double denom = 4. - c[i - 1];
+            c[i] = 1. / denom;
+            secondDerivative[i * n + k] =
+                    (rhs - secondDerivative[(i - 1) * n + k]) / denom;
+        }
+        secondDerivative[ngrid * n + k] = 0.;
+        for (int i = ngrid - 1; i > 0; --i) {
+            secondDerivative[i * n + k] -=
+                    c[i] * secondDerivative[(i + 1) * n + k];
+        }
+    }
+}
+
+void CoulombLinkTable::checkAccuracy() {
+    const int n = norder + 1;
+    std::vector<double> scale(n, 0.);
+    for (int i = 0; i <= ngrid; ++i) {
+        for (int k = 0; k < n; ++k) {
+            scale[k] = std::max(scale[k], fabs(value[i * n + k]));
+        }
+    }
+    double exact[5], spline[5];
+    for (int i = 1; i < ngrid; ++i) {
+        double t = (i + 0.5) / ngrid;
+        calculateExact(t / (1. - t), exact);
+        interpolate(t, spline);
+        for (int k = 0; k < n; ++k) {
+            double error = fabs(spline[k] - exact[k]) / (scale[k] + 1e-200);
+            if (error > maxError) maxError = error;
+        }
+    }
+    std::cout << "CoulombLinkTable: " << ngrid << " points, relative error "
+              << maxError << std::endl;
+    // The fits themselves lose about 1e-6 to roundoff near r=0.
+    if (maxError > 1e-5) {
+        std::cout << "WARNING: CoulombLinkTable is less accurate than 1e-5."
+                  << std::endl;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef COULOMBLINKTABLE_H_
+#define COULOMBLINKTABLE_H_
+
+#include <config.h>
+#include <blitz/array.h>
+#include <vector>
+
+/** Tabulated form of CoulombLinkAction.
+ * The link action is @f$u=\sum_k U_k(r)(s^2/r^2)^k@f$, and evaluating the
+ * @f$U_k@f$ from the fits in Coulomb1DLinkAction and Coulomb3DLinkAction
+ * dominates the cost of each link. This class tabulates them once on a
+ * uniform grid in @f$t=x/(1+x)@f$, with @f$x=r/r_0@f$ and
+ * @f$r_0=\sqrt{\Delta\tau/2\mu}@f$, and uses cubic splines, so the whole
+ * range @f$0\le r<\infty@f$ is covered. Each @f$U_k@f$ is stored divided
+ * by its small-r power of x, so the (possibly large) factors of
+ * @f$s^2/r^2@f$ do not amplify interpolation errors.
+ *
+ * Tables are shared: getTable returns the same table for the same
+ * parameters, so actions and estimators for the same pair reuse it.
+ * The construction compares the splines with the analytic form at the
+ * midpoints of the grid and reports the largest error. */
+class CoulombLinkTable {
+public:
+    typedef blitz::TinyVector<double,NDIM> Vec;
+
+    CoulombLinkTable(double q1q2, double epsilon, double mu,
+            double deltaTau, int norder, int ngrid=2000);
+    virtual ~CoulombLinkTable();
+
+    /// Get the shared table for these parameters, building it if needed.
+    static const CoulombLinkTable* getTable(double q1q2, double epsilon,
+            double mu, double deltaTau, int norder);
+
+    double getValue(Vec delta1, Vec delta2) const;
+
+    /// Largest error found by the accuracy check.
+    double getMaxError() const;
+
+private:
+    const double q1q2;
+    const double epsilon;
+    const double mu;
+    const double deltaTau;
+    const int norder;
+    const int ngrid;
+    /// Reduced length scale.
+    const double r0;
+    double maxError;
+    /// Spline values and second derivatives, (norder+1) per grid point.
+    std::vector<double> value, secondDerivative;
+
+    /// Exact tabulated functions at x=r/r0.
+    void calculateExact(double x, double *g) const;
+    /// Small-r weight x^2m/(1+x^2m) for each order.
+    void calculateWeights(double x, double *w) const;
+    /// Interpolate all orders at t.
+    void interpolate(double t, double *g) const;
+    void makeSplines();
+    void checkAccuracy();
+};
+
+#endif
@@ -75,6 +75,7 @@ void CollectiveSectionSampler::updateSectionBeads() {
         movingBeads->copySlice(identityIndex, islice, *sectionBeads,
                 *movingIndex, islice);
     }
+    sectionChooser.markMoved(*movingIndex);
 }
 
 void CollectiveSectionSampler::reportAtempt() const {
@@ -14,6 +14,7 @@
 #include "base/Paths.h"
 #include "mover/Mover.h"
 #include "stats/AccRejEstimator.h"
+#include "util/AllocationCounter.h"
 #include "util/Permutation.h"
 #include "util/RandomNumGenerator.h"
 
@@ -47,7 +48,7 @@ DoubleMLSampler::DoubleMLSampler(int nmoving, Paths& paths,
     pMovingIndex2(nmoving),
     doubleSectionChooser(sectionChooser),
     samplingBoth(both), permutation1(nmoving),
-    permutation2(nmoving),
+    permutation2(nmoving), permScratch2(nmoving),
     particleChooser2(particleChooser2),
     permutationChooser2(permutationChooser2),
     nrepeat(nrepeat) {
@@ -107,7 +108,10 @@ void DoubleMLSampler::run() {
                 sectionBeads2->copySlice(pMovingIndex2, nsectionSlice - 1,
                         *movingBeads2, identityIndex, nsectionSlice - 1);
             }
-            if (tryMove(lnTranProb) && irepeat < nrepeat - 1) {
+            const long nalloc = AllocationCounter::getCount();
+            bool accepted = tryMove(lnTranProb);
+            checkAllocations(AllocationCounter::getCount() - nalloc);
+            if (accepted && irepeat < nrepeat - 1) {
 
                 permutationChooser->init();
                 if (samplingBoth) {
@@ -229,16 +233,17 @@ bool DoubleMLSampler::tryMove(double initialLnTranProb) {
     }
 
     // Append the current permutation to section permutation.
-    Permutation temp1(permutation1), temp2(permutation2);
     for (int i = 0; i < nmoving; ++i) {
-        temp1[i] = (*sectionPermutation1)[(*movingIndex1)(i)];
+        permScratch(i) = (*sectionPermutation1)[(*movingIndex1)(i)];
         if (samplingBoth)
-            temp2[i] = (*sectionPermutation2)[(*movingIndex2)(i)];
+            permScratch2(i) = (*sectionPermutation2)[(*movingIndex2)(i)];
     }
     for (int i = 0; i < nmoving; ++i) {
-        (*sectionPermutation1)[(*movingIndex1)(i)] = temp1[permutation1[i]];
+        (*sectionPermutation1)[(*movingIndex1)(i)] =
+                permScratch(permutation1[i]);
         if (samplingBoth)
-            (*sectionPermutation2)[(*movingIndex2)(i)] = temp2[permutation2[i]];
+            (*sectionPermutation2)[(*movingIndex2)(i)] =
+                    permScratch2(permutation2[i]);
     }
 
     return true;
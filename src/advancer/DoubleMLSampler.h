@@ -88,6 +88,8 @@ private:
     bool samplingBoth;
     /// The permutations.
     Permutation permutation1, permutation2;
+    /// Scratch for appending the second move permutation.
+    IArray permScratch2;
     /// The algorithm for selecting the particles to move.
     ParticleChooser* particleChooser2;
     /// The algorithm for selecting the permutation.
@@ -27,12 +27,13 @@ void MiddleSectionChooser::run() {
     // Copy coordinates from allBeads to section Beads.
     paths->getBeads(iFirstSlice, *beads);
     permutation->reset();
+    clearMoved();
     // Initialize the action.
     action->initialize(*this);
     // Run the sampling algorithm.
     CompositeAlgorithm::run();
     // Copy moved coordinates from sectionBeads to allBeads.
-    paths->putBeads(iFirstSlice, *beads, *permutation);
+    putMovedBeads();
     // Refresh the buffer slices.
     paths->setBuffers();
 }
@@ -13,6 +13,7 @@
 #include "base/BeadFactory.h"
 #include "base/Paths.h"
 #include "mover/Mover.h"
+#include "util/AllocationCounter.h"
 #include "util/RandomNumGenerator.h"
 #include "util/Permutation.h"
 #include "stats/AccRejEstimator.h"
@@ -37,6 +38,7 @@ MultiLevelSampler::MultiLevelSampler(int nmoving, Paths& paths,
     movingIndex(new IArray(nmoving)),
     identityIndex(nmoving),
     pMovingIndex(nmoving),
+    permScratch(nmoving),
     particleChooser(particleChooser),
     permutationChooser(permutationChooser),
     sectionChooser(sectionChooser),
@@ -49,7 +51,8 @@ MultiLevelSampler::MultiLevelSampler(int nmoving, Paths& paths,
             0),
     newFactor(newFactor),
     defaultFactor(defaultFactor),
-    shouldDeletePermutationChooser(shouldDeletePermutationChooser) {
+    shouldDeletePermutationChooser(shouldDeletePermutationChooser),
+    nmoveChecked(0) {
     for (int i = 0; i < nmoving; ++i)
         (*movingIndex)(i) = identityIndex(i) = i;
     factor = 1;
@@ -71,7 +74,8 @@ void MultiLevelSampler::run() {
     for (int irepeat = 0; irepeat < nrepeat; ++irepeat) {
         bool isNewPerm = permutationChooser->choosePermutation();
         if (isNewPerm) {
-            Permutation permutation(permutationChooser->getPermutation());
+            const Permutation&
+                    permutation(permutationChooser->getPermutation());
             particleChooser->chooseParticles();
             double lnTranProb = permutationChooser->getLnTranProb();
             for (int i = 0; i < nmoving; ++i)
@@ -91,7 +95,10 @@ void MultiLevelSampler::run() {
 //          =(*sectionBeads)(particleChooser[permutation[imoving] ],
 //                        nsectionSlice-1);
 //      }
-            if (tryMove(lnTranProb) && irepeat < nrepeat - 1)
+            const long nalloc = AllocationCounter::getCount();
+            bool accepted = tryMove(lnTranProb);
+            checkAllocations(AllocationCounter::getCount() - nalloc);
+            if (accepted && irepeat < nrepeat - 1)
                 permutationChooser->init();
         }
     }
@@ -164,18 +171,34 @@ bool MultiLevelSampler::tryMove(double initialLnTranProb) {
                 *movingIndex, islice);
 
     }
+    sectionChooser.markMoved(*movingIndex);
     // Append the current permutation to section permutation.
     const Permutation& perm(permutationChooser->getPermutation());
-    Permutation temp(perm);
     for (int i = 0; i < nmoving; ++i) {
-        temp[i] = (*sectionPermutation)[(*particleChooser)[i]];
+        permScratch(i) = (*sectionPermutation)[(*particleChooser)[i]];
     }
     for (int i = 0; i < nmoving; ++i) {
-        (*sectionPermutation)[(*particleChooser)[i]] = temp[perm[i]];
+        (*sectionPermutation)[(*particleChooser)[i]] = permScratch(perm[i]);
     }
     return true;
 }
 
+void MultiLevelSampler::checkAllocations(const long nalloc) {
+    if (!AllocationCounter::isEnabled())
+        return;
+    if (nmoveChecked < NWARMUP) {
+        ++nmoveChecked;
+        return;
+    }
+    if (nalloc == 0)
+        return;
+    std::cout << "ERROR: " << nalloc << " heap allocations in a move after "
+            << NWARMUP << " warm-up moves" << std::endl;
+    std::exit(-1);
+}
+
+const int MultiLevelSampler::NWARMUP = 100;
+
 void MultiLevelSampler::setAction(Action* act, const int level) {
     action = act;
 }
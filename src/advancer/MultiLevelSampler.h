@@ -131,6 +131,9 @@ public:
 protected:
     /// Attempt a move on the beads.
     bool tryMove(double initialTranProb);
+    /// Report heap allocations made by a move after warm-up.
+    /// Only active when configured with ENABLE_ALLOC_COUNT.
+    void checkAllocations(const long nalloc);
     /// Number of levels.
     const int nlevel;
     /// Number of moving particles.
@@ -151,6 +154,8 @@ protected:
     IArray *movingIndex;
     /// More indicies for moving particles.
     IArray identityIndex, pMovingIndex;
+    /// Scratch for appending the move permutation to the section.
+    IArray permScratch;
     /// The algorithm for selecting the particles to move.
     ParticleChooser* particleChooser;
     /// The algorithm for selecting the permutation.
@@ -170,5 +175,9 @@ protected:
     const double defaultFactor;
     double factor;
     int shouldDeletePermutationChooser;
+    /// Number of moves checked by checkAllocations.
+    int nmoveChecked;
+    /// Moves allowed to allocate while scratch storage warms up.
+    static const int NWARMUP;
 };
 #endif
@@ -0,0 +1,88 @@
+#include "config.h"
+#include "NeighborGrid.h"
+#include "base/Beads.h"
+#include "util/SuperCell.h"
+#include <algorithm>
+#include <cmath>
+
+NeighborGrid::NeighborGrid(const SuperCell& cell, double cutoff) :
+        cell(cell), totalCells(1) {
+    for (int idim = 0; idim < NDIM; ++idim) {
+        ncell[idim] = (int) floor(cell.a[idim] / cutoff);
+        if (ncell[idim] < 1)
+            ncell[idim] = 1;
+        totalCells *= ncell[idim];
+    }
+    cellStart.resize(totalCells + 1);
+}
+
+void NeighborGrid::bin(const Beads<NDIM>& beads, int islice, int ifirst,
+        int npart) {
+    cellMember.resize(npart);
+    cellOfPart.resize(npart);
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    // Count particles in each cell, then convert counts to offsets.
+    for (int ipart = 0; ipart < npart; ++ipart) {
+        int icell = getCellIndex(getCellCoords(beads(ipart + ifirst, islice)));
+        cellOfPart[ipart] = icell;
+        ++cellStart[icell + 1];
+    }
+    for (int icell = 0; icell < totalCells; ++icell) {
+        cellStart[icell + 1] += cellStart[icell];
+    }
+    std::vector<int> next(cellStart.begin(), cellStart.end() - 1);
+    for (int ipart = 0; ipart < npart; ++ipart) {
+        cellMember[next[cellOfPart[ipart]]++] = ipart;
+    }
+}
+
+void NeighborGrid::findNeighbors(const Vec& r,
+        std::vector<int>& neighbors) const {
+    neighbors.clear();
+    IVec center = getCellCoords(r);
+    IVec lo, n;
+    for (int idim = 0; idim < NDIM; ++idim) {
+        if (ncell[idim] < 3) {
+            lo[idim] = 0;
+            n[idim] = ncell[idim];
+        } else {
+            lo[idim] = center[idim] - 1;
+            n[idim] = 3;
+        }
+    }
+    int nsearch = 1;
+    for (int idim = 0; idim < NDIM; ++idim)
+        nsearch *= n[idim];
+    for (int isearch = 0; isearch < nsearch; ++isearch) {
+        IVec coords;
+        int k = isearch;
+        for (int idim = 0; idim < NDIM; ++idim) {
+            coords[idim] = (lo[idim] + k % n[idim] + ncell[idim])
+                    % ncell[idim];
+            k /= n[idim];
+        }
+        int icell = getCellIndex(coords);
+        neighbors.insert(neighbors.end(), cellMember.begin() + cellStart[icell],
+                cellMember.begin() + cellStart[icell + 1]);
+    }
+}
+
+NeighborGrid::IVec NeighborGrid::getCellCoords(const Vec& r) const {
+    IVec coords;
+    for (int idim = 0; idim < NDIM; ++idim) {
+        double s = r[idim] * cell.b[idim];
+        s -= floor(s);
+        coords[idim] = (int) (s * ncell[idim]);
+        if (coords[idim] >= ncell[idim])
+            coords[idim] = ncell[idim] - 1;
+    }
+    return coords;
+}
+
+int NeighborGrid::getCellIndex(const IVec& coords) const {
+    int icell = 0;
+    for (int idim = NDIM - 1; idim >= 0; --idim) {
+        icell = icell * ncell[idim] + coords[idim];
+    }
+    return icell;
+}
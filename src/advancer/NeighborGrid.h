@@ -0,0 +1,43 @@
+#ifndef __NeighborGrid_h_
+#define __NeighborGrid_h_
+
+#include <cstdlib>
+#include <blitz/array.h>
+#include <blitz/tinyvec.h>
+#include <vector>
+class SuperCell;
+template<int TDIM> class Beads;
+
+/** Cell list for finding particles near a point in a periodic supercell.
+ * The supercell is divided into cells at least one cutoff wide in each
+ * direction, so every particle within the cutoff of a point lies in
+ * the cell of that point or one of its nearest neighbor cells.
+ * Binning is a counting sort, so both binning and a neighbor
+ * query cost time proportional to the number of particles found,
+ * not to the square of the total number of particles.
+ * If a direction has fewer than three cells, all cells along that
+ * direction are searched.
+ */
+class NeighborGrid {
+public:
+    typedef blitz::TinyVector<double, NDIM> Vec;
+    typedef blitz::TinyVector<int, NDIM> IVec;
+    NeighborGrid(const SuperCell&, double cutoff);
+    /// Bin particles ifirst..ifirst+npart-1 of a slice; stores local indices.
+    void bin(const Beads<NDIM>&, int islice, int ifirst, int npart);
+    /// Collect local indices of particles in cells near a point.
+    void findNeighbors(const Vec& r, std::vector<int>& neighbors) const;
+    int getCellCount() const {
+        return totalCells;
+    }
+private:
+    IVec getCellCoords(const Vec& r) const;
+    int getCellIndex(const IVec& coords) const;
+    const SuperCell& cell;
+    IVec ncell;
+    int totalCells;
+    std::vector<int> cellStart;
+    std::vector<int> cellMember;
+    std::vector<int> cellOfPart;
+};
+#endif
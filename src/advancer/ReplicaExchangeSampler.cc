@@ -0,0 +1,122 @@
+#include "config.h"
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+#include "ReplicaExchangeSampler.h"
+#include "action/ActionChoice.h"
+#include "base/EnumeratedModelState.h"
+#include "base/Paths.h"
+#include "stats/AccRejEstimator.h"
+#include "stats/MPIManager.h"
+#include "util/RandomNumGenerator.h"
+#include <cmath>
+#include <iostream>
+
+ReplicaExchangeSampler::ReplicaExchangeSampler(Paths& paths,
+        ActionChoiceBase* actionChoice, const MPIManager* mpi)
+    :   paths(paths),
+        actionChoice(actionChoice),
+        modelState(dynamic_cast<EnumeratedModelState&>(
+                actionChoice->getModelState())),
+        nmodel(modelState.getModelCount()),
+        accRejEst(0),
+        mpi(mpi),
+        parity(0) {
+    int nclone = (mpi) ? mpi->getNClone() : 1;
+    if (nclone % nmodel != 0) {
+        std::cout << "ERROR: ReplicaExchange needs a multiple of " << nmodel
+                  << " clones, but nclone=" << nclone << std::endl;
+        exit(-1);
+    }
+    int cloneID = (mpi) ? mpi->getCloneID() : 0;
+    modelState.setModelState(cloneID % nmodel);
+}
+
+ReplicaExchangeSampler::~ReplicaExchangeSampler() {
+}
+
+void ReplicaExchangeSampler::run() {
+    tryMove();
+    parity = 1 - parity;
+}
+
+int ReplicaExchangeSampler::findPartnerClone(int& jmodel) {
+    int partner = -1;
+    jmodel = -1;
+#ifdef ENABLE_MPI
+    int nclone = mpi->getNClone();
+    int cloneID = mpi->getCloneID();
+    int imodel = modelState.getModelState();
+    std::vector<int> models(nclone);
+    mpi->getCloneComm().Allgather(&imodel, 1, MPI::INT,
+            &models[0], 1, MPI::INT);
+    // Pair model m with m+1 for m of the current parity.
+    jmodel = ((imodel % 2) == parity) ? imodel + 1 : imodel - 1;
+    if (jmodel < 0 || jmodel >= nmodel) {
+        jmodel = -1;
+        return -1;
+    }
+    int firstClone = (cloneID / nmodel) * nmodel;
+    for (int iclone = firstClone; iclone < firstClone + nmodel; ++iclone) {
+        if (models[iclone] == jmodel) partner = iclone;
+    }
+#endif
+    return partner;
+}
+
+bool ReplicaExchangeSampler::tryMove() {
+#ifdef ENABLE_MPI
+    if (!mpi || mpi->getNClone() < 2) return false;
+    int workerID = mpi->getWorkerID();
+    int nworker = mpi->getNWorker();
+
+    int jmodel = -1;
+    int partner = -1;
+    if (workerID == 0) {
+        partner = findPartnerClone(jmodel);
+    }
+    if (nworker > 1) {
+        mpi->getWorkerComm().Bcast(&jmodel, 1, MPI::INT, 0);
+    }
+    if (jmodel < 0) return false;
+
+    if (workerID == 0) accRejEst->tryingMove(0);
+
+    // Action change if this clone's paths used the partner's model.
+    double deltaAction = actionChoice->getActionChoiceDifference(paths, jmodel);
+    if (nworker > 1) {
+        double totalDeltaAction = 0;
+        mpi->getWorkerComm().Reduce(&deltaAction, &totalDeltaAction,
+                1, MPI::DOUBLE, MPI::SUM, 0);
+        deltaAction = totalDeltaAction;
+    }
+
+    int accept = 0;
+    if (workerID == 0) {
+        double partnerDeltaAction = 0;
+        mpi->getCloneComm().Sendrecv(&deltaAction, 1, MPI::DOUBLE, partner, 0,
+                &partnerDeltaAction, 1, MPI::DOUBLE, partner, 0);
+        // The holder of the lower model decides for the pair.
+        if (jmodel > modelState.getModelState()) {
+            double acceptProb = exp(-deltaAction - partnerDeltaAction);
+            accept = (RandomNumGenerator::getRand() < acceptProb) ? 1 : 0;
+            mpi->getCloneComm().Send(&accept, 1, MPI::INT, partner, 1);
+        } else {
+            mpi->getCloneComm().Recv(&accept, 1, MPI::INT, partner, 1);
+        }
+        if (accept) {
+            modelState.setModelState(jmodel);
+            accRejEst->moveAccepted(0);
+        }
+    }
+    modelState.broadcastToMPIWorkers(mpi);
+    return modelState.getModelState() == jmodel;
+#else
+    return false;
+#endif
+}
+
+AccRejEstimator*
+ReplicaExchangeSampler::getAccRejEstimator(const std::string& name) {
+    return accRejEst = new AccRejEstimator(name.c_str(), 1);
+}
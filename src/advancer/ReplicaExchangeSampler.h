@@ -0,0 +1,51 @@
+#ifndef __ReplicaExchangeSampler_h_
+#define __ReplicaExchangeSampler_h_
+class ActionChoiceBase;
+class Paths;
+class AccRejEstimator;
+class MPIManager;
+class EnumeratedModelState;
+
+#include "algorithm/Algorithm.h"
+#include <string>
+#include <vector>
+
+/// Replica exchange (parallel tempering) of action models across clones.
+/// Each clone runs one model of an ActionChoice, for example a different
+/// coupling constant or external field. Clones holding neighboring
+/// models attempt to swap models, alternating between even and odd
+/// pairs on successive calls. Only the action differences and the
+/// accept decision are sent over the clone communicator; the paths
+/// stay in place. With splitOverStates the estimators are then
+/// reported per model in the HDF5 partition groups.
+///
+/// If there are more clones than models, clones are grouped into
+/// independent sets of getModelCount() replicas.
+class ReplicaExchangeSampler: public Algorithm {
+public:
+    ReplicaExchangeSampler(Paths&, ActionChoiceBase*, const MPIManager* mpi);
+    virtual ~ReplicaExchangeSampler();
+
+    virtual void run();
+    /// Get a pointer to the accept/reject statistic estimator.
+    /// (You are responsible for deleting this new object.)
+    virtual AccRejEstimator* getAccRejEstimator(const std::string& name);
+protected:
+    /// A reference to the paths.
+    Paths& paths;
+    /// The action choice whose models are exchanged.
+    ActionChoiceBase *actionChoice;
+    EnumeratedModelState &modelState;
+    const int nmodel;
+    /// A pointer to the accept-reject estimator.
+    AccRejEstimator* accRejEst;
+    /// A pointer to the MPI manager, zero if MPI is not used.
+    const MPIManager* mpi;
+    /// Alternates between pairing even and odd models.
+    int parity;
+    /// Method to atempt a swap, return true if accepted.
+    virtual bool tryMove();
+    /// Find the clone holding the neighboring model for this step.
+    int findPartnerClone(int& jmodel);
+};
+#endif
@@ -18,7 +18,8 @@ SectionChooser::SectionChooser(int nlevel, int npart, Paths &paths,
         CompositeAlgorithm(0), paths(&paths), action(&action), beads(
                 beadFactory.getNewBeads(npart, (1 << nlevel) + 1)),
                 permutation(new Permutation(npart)), nlevel(nlevel),
-                qrng(gsl_qrng_alloc(gsl_qrng_sobol, 1)) {
+                qrng(gsl_qrng_alloc(gsl_qrng_sobol, 1)), movedIndex(npart),
+                isMoved(npart, false), nmoved(0) {
 }
 
 SectionChooser::~SectionChooser() {
@@ -37,12 +38,36 @@ void SectionChooser::run() {
     // Copy coordinates from allBeads to section Beads.
     paths->getBeads(iFirstSlice, *beads);
     permutation->reset();
+    clearMoved();
     // Initialize the action.
     action->initialize(*this);
     // Run the sampling algorithm.
     CompositeAlgorithm::run();
     // Copy moved coordinates from sectionBeads to allBeads.
-    paths->putBeads(iFirstSlice, *beads, *permutation);
+    putMovedBeads();
     // Refresh the buffer slices.
     paths->setBuffers();
 }
+
+void SectionChooser::markMoved(const blitz::Array<int, 1>& index) {
+    for (int i = 0; i < index.size(); ++i) {
+        if (!isMoved[index(i)]) {
+            isMoved[index(i)] = true;
+            movedIndex(nmoved++) = index(i);
+        }
+    }
+}
+
+void SectionChooser::clearMoved() {
+    for (int i = 0; i < nmoved; ++i)
+        isMoved[movedIndex(i)] = false;
+    nmoved = 0;
+}
+
+void SectionChooser::putMovedBeads() {
+    // Unmoved particles still match the paths, so skip them.
+    if (nmoved == 0)
+        return;
+    blitz::Array<int, 1> moved(movedIndex(blitz::Range(0, nmoved - 1)));
+    paths->putMovedBeads(iFirstSlice, *beads, *permutation, moved);
+}
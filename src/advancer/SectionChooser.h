@@ -3,6 +3,9 @@
 
 #include "algorithm/CompositeAlgorithm.h"
 #include <gsl/gsl_qrng.h>
+#include <cstdlib>
+#include <blitz/array.h>
+#include <vector>
 template<int TDIM> class Beads;
 class Paths;
 class Permutation;
@@ -33,8 +36,15 @@ public:
     const Paths& getPaths() const {
         return *paths;
     }
+    /// Record particles whose section beads were changed by a sampler.
+    void markMoved(const blitz::Array<int, 1>& index);
 
 protected:
+    /// Forget the moved particles before sampling a new section.
+    void clearMoved();
+    /// Copy beads of the moved particles back to the paths.
+    void putMovedBeads();
+
     Paths *paths;
     Action *action;
     mutable Beads<NDIM> *beads;
@@ -42,5 +52,9 @@ protected:
     const int nlevel;
     int iFirstSlice;
     gsl_qrng *qrng;
+private:
+    blitz::Array<int, 1> movedIndex;
+    std::vector<bool> isMoved;
+    int nmoved;
 };
 #endif
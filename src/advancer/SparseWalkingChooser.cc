@@ -0,0 +1,140 @@
+#include "config.h"
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+#include "SparseWalkingChooser.h"
+#include "MultiLevelSampler.h"
+#include "NeighborGrid.h"
+#include "base/Beads.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+#include "util/PeriodicGaussian.h"
+#include "util/Permutation.h"
+#include "util/SuperCell.h"
+#include "util/RandomNumGenerator.h"
+#include <blitz/tinyvec-et.h>
+#include <algorithm>
+#include <cmath>
+
+SparseWalkingChooser::SparseWalkingChooser(const int nsize,
+        const Species &species, const int nlevel,
+        const SimulationInfo& simInfo, const double cutoffLambda) :
+        PermutationChooser(nsize), SpeciesParticleChooser(species, nsize),
+        multiLevelSampler(0), pg(NDIM), grid(0), nsize(nsize), prob(1.),
+        rowStart(npart + 1), h(npart) {
+    double alpha = species.mass / (2 * simInfo.getTau() * (1 << nlevel));
+    for (int idim = 0; idim < NDIM; ++idim) {
+        double length = (*simInfo.getSuperCell())[idim];
+        pg(idim) = new PeriodicGaussian(alpha, length);
+    }
+    // The thermal wavelength of the section is sqrt(pi/alpha).
+    cutoff2 = cutoffLambda * cutoffLambda * M_PI / alpha;
+    grid = new NeighborGrid(*simInfo.getSuperCell(), sqrt(cutoff2));
+    // Initialize permutation to an n-cycle.
+    for (int i = 0; i < nsize; ++i)
+        (*permutation)[i] = (i + 1) % nsize;
+}
+
+SparseWalkingChooser::~SparseWalkingChooser() {
+    for (PGArray::iterator i = pg.begin(); i != pg.end(); ++i)
+        delete *i;
+    delete grid;
+}
+
+void SparseWalkingChooser::chooseParticles() {
+}
+
+bool SparseWalkingChooser::choosePermutation() {
+    double tranProb = 0, revTranProb = 0;
+    index(0) = (int) (npart * RandomNumGenerator::getRand());
+    if (index(0) == npart)
+        index(0) = npart - 1;
+    for (int ipart = 1; ipart <= nsize; ++ipart) {
+        int k = index(ipart - 1);
+        double tkk = getT(k, k);
+        if (h[k] == 0. || tkk == 0.)
+            return false;
+        double tnext = 0.;
+        if (ipart < nsize) {
+            // Select subsequent particle from t(k1,k2)/h(k1).
+            int pos = alias.sample(rowStart[k], rowStart[k + 1],
+                    RandomNumGenerator::getRand());
+            index(ipart) = column[pos];
+            tnext = value[pos];
+            // Reject if repeated (not a nsize permutiaton cycle).
+            for (int jpart = 0; jpart < ipart; ++jpart) {
+                if (index(ipart) == index(jpart))
+                    return false;
+            }
+        } else {
+            // Close the cycle; reject if the link is beyond the cutoff.
+            tnext = getT(k, index(0));
+            if (tnext == 0.)
+                return false;
+        }
+        // Accumulate inverse probabilities.
+        revTranProb += h[k] / tkk;
+        tranProb += h[k] / tnext;
+    }
+    double accept = revTranProb / tranProb;
+
+    prob = 1;
+    for (int i = 0; i < nsize; ++i)
+        prob *= getT(index(i), index(i))
+                / getT(index(i), index((i + 1) % nsize));
+    // Add ifirst to particle IDs to convert to absolute IDs.
+    index += ifirst;
+    return RandomNumGenerator::getRand() < accept;
+}
+
+void SparseWalkingChooser::init() {
+    // Setup the sparse table of free particle propagator values.
+    const Beads<NDIM> &sectionBeads = multiLevelSampler->getSectionBeads();
+    const SuperCell &cell = multiLevelSampler->getSuperCell();
+    const int nslice = sectionBeads.getNSlice();
+    grid->bin(sectionBeads, nslice - 1, ifirst, npart);
+
+    column.clear();
+    value.clear();
+    for (int ipart = 0; ipart < npart; ++ipart) {
+        rowStart[ipart] = column.size();
+        h[ipart] = 0.;
+        grid->findNeighbors(sectionBeads(ipart + ifirst, 0), neighbors);
+        std::sort(neighbors.begin(), neighbors.end());
+        for (unsigned int k = 0; k < neighbors.size(); ++k) {
+            int jpart = neighbors[k];
+            Vec delta = sectionBeads(ipart + ifirst, 0);
+            delta -= sectionBeads(jpart + ifirst, nslice - 1);
+            cell.pbc(delta);
+            if (dot(delta, delta) > cutoff2)
+                continue;
+            double t = 1;
+            for (int idim = 0; idim < NDIM; ++idim) {
+                t *= pg(idim)->evaluate(delta[idim]);
+            }
+            column.push_back(jpart);
+            value.push_back(t);
+            h[ipart] += t;
+        }
+    }
+    rowStart[npart] = column.size();
+
+    alias.resize(value.size());
+    for (int ipart = 0; ipart < npart; ++ipart) {
+        if (h[ipart] > 0.)
+            alias.build(value, rowStart[ipart], rowStart[ipart + 1]);
+    }
+}
+
+double SparseWalkingChooser::getT(int ipart, int jpart) const {
+    std::vector<int>::const_iterator begin = column.begin() + rowStart[ipart];
+    std::vector<int>::const_iterator end = column.begin() + rowStart[ipart + 1];
+    std::vector<int>::const_iterator it = std::lower_bound(begin, end, jpart);
+    if (it == end || *it != jpart)
+        return 0.;
+    return value[it - column.begin()];
+}
+
+void SparseWalkingChooser::setMLSampler(const MultiLevelSampler *mls) {
+    multiLevelSampler = mls;
+}
@@ -0,0 +1,59 @@
+#ifndef __SparseWalkingChooser_h_
+#define __SparseWalkingChooser_h_
+
+#include "PermutationChooser.h"
+#include "SpeciesParticleChooser.h"
+#include "util/AliasTable.h"
+#include <cstdlib>
+#include <blitz/array.h>
+#include <blitz/tinyvec.h>
+#include <vector>
+class MultiLevelSampler;
+class SimulationInfo;
+class PeriodicGaussian;
+class NeighborGrid;
+
+/** Walking permutation chooser with sparse, neighbor-restricted tables.
+ * This makes the same moves as the WalkingChooser, but only keeps
+ * free particle propagator values t(i,j) for ends j within a cutoff
+ * of particle i, given in units of the thermal wavelength
+ * @f$ \lambda = \sqrt{2\pi\tau_s/m} @f$ of the section.
+ * Candidates come from a NeighborGrid, each row of t is stored in
+ * compressed form with an alias table, so init costs
+ * O(N k) and each step of the walk costs O(1) to sample and
+ * O(log k) to look up, where k is the number of neighbors.
+ * Links beyond the cutoff are exactly zero in both the forward
+ * and reverse transition probabilities, so detailed balance holds.
+ */
+class SparseWalkingChooser:
+    public PermutationChooser, public SpeciesParticleChooser {
+public:
+    typedef blitz::TinyVector<double, NDIM> Vec;
+    typedef blitz::Array<PeriodicGaussian*, 1> PGArray;
+    SparseWalkingChooser(const int nsize, const Species&, const int nlevel,
+            const SimulationInfo&, const double cutoffLambda = 4.7);
+    virtual ~SparseWalkingChooser();
+    virtual void setMLSampler(const MultiLevelSampler*);
+    virtual bool choosePermutation();
+    virtual void chooseParticles();
+    virtual void init();
+    virtual double getLnTranProb() const {
+        return log(prob);
+    }
+    /// Table value t(ipart,jpart), zero beyond the cutoff.
+    double getT(int ipart, int jpart) const;
+private:
+    const MultiLevelSampler *multiLevelSampler;
+    PGArray pg;
+    NeighborGrid *grid;
+    int nsize;
+    double cutoff2;
+    double prob;
+    std::vector<int> rowStart;
+    std::vector<int> column;
+    std::vector<double> value;
+    std::vector<double> h;
+    AliasTable alias;
+    std::vector<int> neighbors;
+};
+#endif
@@ -0,0 +1,120 @@
+#include "config.h"
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+#include "SwapChooser.h"
+#include "MultiLevelSampler.h"
+#include "NeighborGrid.h"
+#include "base/Beads.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+#include "util/PeriodicGaussian.h"
+#include "util/Permutation.h"
+#include "util/SuperCell.h"
+#include "util/RandomNumGenerator.h"
+#include <blitz/tinyvec-et.h>
+#include <cmath>
+
+SwapChooser::SwapChooser(const Species &species, const int nlevel,
+        const SimulationInfo& simInfo) :
+        PermutationChooser(2), SpeciesParticleChooser(species, 2),
+        sampler(0), pg(NDIM), grid(0), prob(1.) {
+    double alpha = species.mass / (2 * simInfo.getTau() * (1 << nlevel));
+    for (int idim = 0; idim < NDIM; ++idim) {
+        double length = (*simInfo.getSuperCell())[idim];
+        pg(idim) = new PeriodicGaussian(alpha, length);
+    }
+    // Links below exp(-70) (about 1e-30) are neglected.
+    cutoff2 = 70. / alpha;
+    grid = new NeighborGrid(*simInfo.getSuperCell(), sqrt(cutoff2));
+    (*permutation)[0] = 1;
+    (*permutation)[1] = 0;
+}
+
+SwapChooser::~SwapChooser() {
+    for (PGArray::iterator i = pg.begin(); i != pg.end(); ++i)
+        delete *i;
+    delete grid;
+}
+
+void SwapChooser::chooseParticles() {
+}
+
+bool SwapChooser::choosePermutation() {
+    int i = (int) (npart * RandomNumGenerator::getRand());
+    if (i == npart)
+        i = npart - 1;
+    // Select j from t(i,j)/h(i) over the neighbors of i.
+    double hi = sumLinks(i);
+    if (hi == 0.)
+        return false;
+    double x = hi * RandomNumGenerator::getRand();
+    int j = neighbors.back();
+    double tij = weights.back();
+    for (unsigned int k = 0; k < neighbors.size(); ++k) {
+        x -= weights[k];
+        if (x < 0) {
+            j = neighbors[k];
+            tij = weights[k];
+            break;
+        }
+    }
+    if (j == i)
+        return false;
+    double tii = link(i, i);
+    double hj = sumLinks(j);
+    double tji = link(j, i);
+    double tjj = link(j, j);
+    if (tii * tjj == 0.)
+        return false;
+    // Either end of the swap could have been picked first.
+    double accept = (hi * tjj + hj * tii) * tij * tji
+            / ((hi * tji + hj * tij) * tii * tjj);
+    prob = tii * tjj / (tij * tji);
+    // Add ifirst to particle IDs to convert to absolute IDs.
+    index(0) = i + ifirst;
+    index(1) = j + ifirst;
+    return RandomNumGenerator::getRand() < accept;
+}
+
+void SwapChooser::init() {
+    const Beads<NDIM> &sectionBeads = sampler->getSectionBeads();
+    const int nslice = sectionBeads.getNSlice();
+    grid->bin(sectionBeads, nslice - 1, ifirst, npart);
+}
+
+double SwapChooser::link(int ipart, int jpart) const {
+    const Beads<NDIM> &sectionBeads = sampler->getSectionBeads();
+    const SuperCell &cell = sampler->getSuperCell();
+    const int nslice = sectionBeads.getNSlice();
+    Vec delta = sectionBeads(ipart + ifirst, 0);
+    delta -= sectionBeads(jpart + ifirst, nslice - 1);
+    cell.pbc(delta);
+    if (dot(delta, delta) > cutoff2)
+        return 0.;
+    double t = 1.;
+    for (int idim = 0; idim < NDIM; ++idim) {
+        t *= pg(idim)->evaluate(delta[idim]);
+    }
+    return t;
+}
+
+double SwapChooser::sumLinks(int ipart) {
+    const Beads<NDIM> &sectionBeads = sampler->getSectionBeads();
+    grid->findNeighbors(sectionBeads(ipart + ifirst, 0), neighbors);
+    weights.resize(neighbors.size());
+    double h = 0.;
+    for (unsigned int k = 0; k < neighbors.size(); ++k) {
+        weights[k] = link(ipart, neighbors[k]);
+        h += weights[k];
+    }
+    return h;
+}
+
+void SwapChooser::setMLSampler(const MultiLevelSampler *mls) {
+    setSampler(mls);
+}
+
+void SwapChooser::setSampler(const SectionSamplerInterface *sampler) {
+    this->sampler = sampler;
+}
@@ -0,0 +1,55 @@
+#ifndef __SwapChooser_h_
+#define __SwapChooser_h_
+
+#include "PermutationChooser.h"
+#include "SpeciesParticleChooser.h"
+#include <cstdlib>
+#include <blitz/array.h>
+#include <blitz/tinyvec.h>
+#include <vector>
+class MultiLevelSampler;
+class SectionSamplerInterface;
+class SimulationInfo;
+class PeriodicGaussian;
+class NeighborGrid;
+
+/** Local swap (transposition) chooser for large systems.
+ * This is the closed-path analogue of the worm algorithm swap update:
+ * each move exchanges the end links of particle i and a neighbor j
+ * chosen with probability t(i,j)/h(i), where t is the free particle
+ * propagator over the section and h(i) is its sum over neighbors of i.
+ * Repeated swaps grow and shrink exchange cycles of any length.
+ * Only neighbors within a cutoff of the Gaussian width are tabulated,
+ * using a NeighborGrid, so init and each move cost O(local) work
+ * instead of the O(N^2) table of the WalkingChooser.
+ */
+class SwapChooser:
+    public PermutationChooser, public SpeciesParticleChooser {
+public:
+    typedef blitz::TinyVector<double, NDIM> Vec;
+    typedef blitz::Array<PeriodicGaussian*, 1> PGArray;
+    SwapChooser(const Species&, const int nlevel, const SimulationInfo&);
+    virtual ~SwapChooser();
+    virtual void setMLSampler(const MultiLevelSampler*);
+    /// Use the section beads of any sampler (all the chooser needs).
+    void setSampler(const SectionSamplerInterface*);
+    virtual bool choosePermutation();
+    virtual void chooseParticles();
+    virtual void init();
+    virtual double getLnTranProb() const {
+        return log(prob);
+    }
+private:
+    /// Free propagator from the start of ipart to the end of jpart.
+    double link(int ipart, int jpart) const;
+    /// Sum of links from the start of ipart to neighboring ends.
+    double sumLinks(int ipart);
+    const SectionSamplerInterface *sampler;
+    PGArray pg;
+    NeighborGrid *grid;
+    double cutoff2;
+    double prob;
+    std::vector<int> neighbors;
+    std::vector<double> weights;
+};
+#endif
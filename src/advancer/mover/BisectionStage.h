@@ -0,0 +1,180 @@
+#ifndef __BisectionStage_h_
+#define __BisectionStage_h_
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <blitz/array.h>
+#include "base/Beads.h"
+#include "util/RandomNumGenerator.h"
+
+/** Free-particle bisection of all moving beads on one level at once.
+ * The beads at the midpoint slices of a level are staged in a
+ * structure-of-arrays buffer, one contiguous array per dimension with
+ * element j=k*nMoving+iMoving for the k-th midpoint slice. All Gaussian
+ * deviates for the level are drawn in one call, and a single pass over
+ * each dimension computes the new positions and the forward and reverse
+ * displacements, so the loops vectorize. Periodic wrapping, if cell
+ * lengths are given, is done per component, which is the same as
+ * SuperCell::pbc for a rectangular cell.
+ *
+ * A mover calls load, setSigma for each moving particle and dimension,
+ * sample and store. Dimensions given a zero weight are left out of the
+ * Gaussian transition probability, so the mover can use periodic
+ * Gaussians on getForwardDelta and getReverseDelta instead. */
+template <int N>
+class BisectionStage {
+public:
+    typedef blitz::Array<int, 1> IArray;
+    typedef blitz::TinyVector<double, N> Vec;
+    BisectionStage() :
+            nMoving(0), nMid(0), nStride(0), forwardSum(0.) {
+    }
+    /// Gather the end points of each midpoint slice for a level.
+    /// Pass length=0 for no periodic boundary conditions.
+    void load(const Beads<N>& movingBeads, const Beads<N>& sectionBeads,
+            const IArray& index, const int level, const double* length) {
+        nMoving = index.size();
+        nStride = 1 << level;
+        const int nSlice = sectionBeads.getNSlice();
+        nMid = 0;
+        for (int islice = nStride; islice < nSlice - nStride;
+                islice += 2 * nStride)
+            ++nMid;
+        const int n = nMid * nMoving;
+        for (int idim = 0; idim < N; ++idim) {
+            a[idim] = length ? length[idim] : 0.;
+            b[idim] = length ? 1. / length[idim] : 0.;
+            movingMid[idim].resize(n);
+            sectionMid[idim].resize(n);
+            sectionBead[idim].resize(n);
+            forward[idim].resize(n);
+            reverse[idim].resize(n);
+            sigma[idim].assign(nMoving, 0.);
+            weight[idim].assign(nMoving, 0.);
+        }
+        for (int k = 0; k < nMid; ++k) {
+            const int islice = nStride * (2 * k + 1);
+            for (int iMoving = 0; iMoving < nMoving; ++iMoving) {
+                const int i = index(iMoving);
+                const int j = k * nMoving + iMoving;
+                Vec prev = movingBeads(iMoving, islice - nStride);
+                Vec next = movingBeads(iMoving, islice + nStride);
+                Vec sprev = sectionBeads(i, islice - nStride);
+                Vec snext = sectionBeads(i, islice + nStride);
+                Vec s = sectionBeads(i, islice);
+                for (int idim = 0; idim < N; ++idim) {
+                    // Hold the end-point separation until sample.
+                    movingMid[idim][j] = next[idim] - prev[idim];
+                    forward[idim][j] = prev[idim];
+                    sectionMid[idim][j] = snext[idim] - sprev[idim];
+                    reverse[idim][j] = sprev[idim];
+                    sectionBead[idim][j] = s[idim];
+                }
+            }
+        }
+    }
+    /// Set the width of the Gaussian for a moving particle along idim,
+    /// and the weight 1/(2 sigma^2) of its transition probability.
+    void setSigma(const int iMoving, const int idim, const double s,
+            const double w) {
+        sigma[idim][iMoving] = s;
+        weight[idim][iMoving] = w;
+    }
+    /// Draw the new positions and return the log of the ratio of reverse
+    /// to forward transition probabilities for the weighted dimensions.
+    double sample() {
+        const int n = nMid * nMoving;
+        double logRatio = 0.;
+        forwardSum = 0.;
+        if (n == 0)
+            return logRatio;
+        gaussRand.resize(N * n);
+        RandomNumGenerator::makeGaussRand(gaussRand);
+        for (int idim = 0; idim < N; ++idim) {
+            const double ai = a[idim], bi = b[idim];
+            const double* g = gaussRand.data() + idim * n;
+            const double* s = &sigma[idim][0];
+            const double* w = &weight[idim][0];
+            double* mid = &movingMid[idim][0];
+            double* fwd = &forward[idim][0];
+            const double* smid = &sectionMid[idim][0];
+            double* rev = &reverse[idim][0];
+            const double* sb = &sectionBead[idim][0];
+            for (int k = 0; k < nMid; ++k) {
+                const int j0 = k * nMoving;
+                double fsum = 0., rsum = 0.;
+#ifdef _OPENMP
+#pragma omp simd reduction(+:fsum,rsum)
+#endif
+                for (int m = 0; m < nMoving; ++m) {
+                    const int j = j0 + m;
+                    double d = mid[j];
+                    d -= ai * floor(d * bi + 0.5);
+                    double x = fwd[j] + 0.5 * d;
+                    x -= ai * floor(x * bi + 0.5);
+                    double dx = s[m] * g[j];
+                    dx -= ai * floor(dx * bi + 0.5);
+                    double xnew = x + dx;
+                    mid[j] = xnew - ai * floor(xnew * bi + 0.5);
+                    fwd[j] = dx;
+                    double ds = smid[j];
+                    ds -= ai * floor(ds * bi + 0.5);
+                    double xs = rev[j] + 0.5 * ds;
+                    xs -= ai * floor(xs * bi + 0.5);
+                    double dr = sb[j] - xs;
+                    dr -= ai * floor(dr * bi + 0.5);
+                    rev[j] = dr;
+                    fsum += w[m] * dx * dx;
+                    rsum += w[m] * dr * dr;
+                }
+                forwardSum += fsum;
+                logRatio += fsum - rsum;
+            }
+        }
+        return logRatio;
+    }
+    /// Write the new positions into the moving beads.
+    void store(Beads<N>& movingBeads) const {
+        for (int k = 0; k < nMid; ++k) {
+            const int islice = nStride * (2 * k + 1);
+            for (int iMoving = 0; iMoving < nMoving; ++iMoving) {
+                const int j = k * nMoving + iMoving;
+                Vec& x = movingBeads(iMoving, islice);
+                for (int idim = 0; idim < N; ++idim)
+                    x[idim] = movingMid[idim][j];
+            }
+        }
+    }
+    /// Weighted sum of squared forward displacements from the last sample.
+    double getForwardSum() const {
+        return forwardSum;
+    }
+    /// Forward displacements along idim, element k*nMoving+iMoving.
+    const double* getForwardDelta(const int idim) const {
+        return forward[idim].empty() ? 0 : &forward[idim][0];
+    }
+    /// Reverse displacements of the section beads along idim.
+    const double* getReverseDelta(const int idim) const {
+        return reverse[idim].empty() ? 0 : &reverse[idim][0];
+    }
+    int getMovingCount() const {
+        return nMoving;
+    }
+    int getMidpointCount() const {
+        return nMid;
+    }
+private:
+    int nMoving, nMid, nStride;
+    /// Cell lengths and their inverses (zero for no wrapping).
+    double a[N], b[N];
+    /// Staged coordinates; movingMid holds the new positions after sample.
+    std::vector<double> movingMid[N], sectionMid[N], sectionBead[N];
+    /// Staged previous beads, then forward and reverse displacements.
+    std::vector<double> forward[N], reverse[N];
+    /// Gaussian widths and transition weights per moving particle.
+    std::vector<double> sigma[N], weight[N];
+    /// Gaussian deviates for the whole level.
+    blitz::Array<double, 1> gaussRand;
+    double forwardSum;
+};
+#endif
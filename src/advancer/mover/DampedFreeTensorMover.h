@@ -1,6 +1,7 @@
 #ifndef __DampedFreeTensorMover_h_
 #define __DampedFreeTensorMover_h_
 #include "Mover.h"
+#include "BisectionStage.h"
 class SimulationInfo;
 #include <cstdlib>
 #include <blitz/array.h>
@@ -40,5 +41,7 @@ private:
     double tau;
     /// The level at which lambda saturation occurs.
     int saturationLevel;
+    /// Staging buffer for the bisection moves of a level.
+    BisectionStage<NDIM> stage;
 };
 #endif
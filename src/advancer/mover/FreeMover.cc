@@ -61,65 +61,41 @@ double FreeMover::makeMove(MultiLevelSampler& sampler, const int level) {
     Beads<NDIM>& movingBeads = sampler.getMovingBeads();
     const SuperCell& cell = sampler.getSuperCell();
     const int nStride = 1 << level;
-    const int nSlice = sectionBeads.getNSlice();
     double factor = sampler.getFactor();
     const blitz::Array<int, 1>& index = sampler.getMovingIndex();
     const int nMoving = index.size();
-    blitz::Array<Vec, 1> gaussRand(nMoving);
-    gaussRand = 0.0;
-    double toldOverTnew = 0;
-    forwardProb = 0;
-    for (int islice = nStride; islice < nSlice - nStride;
-            islice += 2 * nStride) {
-        RandomNumGenerator::makeGaussRand(gaussRand);
+    const bool hasPG = level < pg.extent(0);
+    stage.load(movingBeads, sectionBeads, index, level, cell.a.data());
+    for (int iMoving = 0; iMoving < nMoving; ++iMoving) {
+        const int i = index(iMoving);
+        double sigma = factor * sqrt(lambda(i) * tau * nStride);
+        double inv2Sigma2 = 0.5 / (sigma * sigma);
+        for (int idim = 0; idim < NDIM; ++idim) {
+            bool periodic = hasPG && pg(level, specIndex(i), idim);
+            stage.setSigma(iMoving, idim, sigma, periodic ? 0. : inv2Sigma2);
+        }
+    }
+    double toldOverTnew = stage.sample();
+    forwardProb = stage.getForwardSum();
+    // Periodic Gaussians along short cell dimensions.
+    const int nMid = stage.getMidpointCount();
+    for (int idim = 0; hasPG && idim < NDIM; ++idim) {
+        const double* forward = stage.getForwardDelta(idim);
+        const double* reverse = stage.getReverseDelta(idim);
         for (int iMoving = 0; iMoving < nMoving; ++iMoving) {
-            const int i = index(iMoving);
-            const int ispec = specIndex(i);
-            double sigma = factor * sqrt(lambda(i) * tau * nStride);
-            double inv2Sigma2 = 0.5 / (sigma * sigma);
-            // Calculate the new position.
-            Vec midpoint = movingBeads.delta(iMoving, islice + nStride,
-                    -2 * nStride);
-            cell.pbc(midpoint) *= 0.5;
-            midpoint += movingBeads(iMoving, islice - nStride);
-            cell.pbc(midpoint);
-            Vec delta = gaussRand(iMoving);
-            delta *= sigma;
-            cell.pbc(delta);
-            (movingBeads(iMoving, islice) = midpoint) += delta;
-            cell.pbc(movingBeads(iMoving, islice));
-            // Calculate 1/transition probability for move
-            double temp = 1.0;
-            for (int idim = 0; idim < NDIM; ++idim) {
-                if (pg(level, ispec, idim)) {
-                    temp *= pg(level, ispec, idim)->evaluate(delta[idim]);
-                } else {
-                    double tmp = delta[idim] * delta[idim] * inv2Sigma2;
-                    forwardProb += tmp;
-                    toldOverTnew += tmp;
-                }
+            const PeriodicGaussian* g = pg(level, specIndex(index(iMoving)),
+                    idim);
+            if (!g)
+                continue;
+            for (int k = 0; k < nMid; ++k) {
+                const int j = k * nMoving + iMoving;
+                double forwardLog = log(g->evaluate(forward[j]));
+                forwardProb -= forwardLog;
+                toldOverTnew += log(g->evaluate(reverse[j])) - forwardLog;
             }
-            temp = 1.0 / temp;
-            forwardProb += log(temp);
-
-            // Calculate and add reverse transition probability.
-            midpoint = sectionBeads.delta(i, islice + nStride, -2 * nStride);
-            cell.pbc(midpoint) *= 0.5;
-            midpoint += sectionBeads(i, islice - nStride);
-            cell.pbc(midpoint);
-            delta = sectionBeads(i, islice);
-            delta -= midpoint;
-            cell.pbc(delta);
-            for (int idim = 0; idim < NDIM; ++idim) {
-                if (pg(level, ispec, idim)) {
-                    temp *= pg(level, ispec, idim)->evaluate(delta[idim]);
-                } else {
-                    toldOverTnew -= delta[idim] * delta[idim] * inv2Sigma2;
-                }
-            }
-            toldOverTnew += log(temp);
         }
     }
+    stage.store(movingBeads);
     return toldOverTnew; //Return the log of the probability.
 }
 
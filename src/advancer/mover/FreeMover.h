@@ -4,6 +4,7 @@
 #include <blitz/array.h>
 #include <vector>
 #include "Mover.h"
+#include "BisectionStage.h"
 class SimulationInfo;
 class PeriodicGaussian;
 /** Select a trial move for beads by free particle sampling.
@@ -43,5 +44,7 @@ private:
     IArray specIndex;
     /// forward transition prob
     double forwardProb;
+    /// Staging buffer for the bisection moves of a level.
+    BisectionStage<NDIM> stage;
 };
 #endif
@@ -65,7 +65,7 @@ double FreeMoverPBC::makeMove(MultiLevelSampler& sampler, const int level) {
     double factor = sampler.getFactor();
     const blitz::Array<int, 1>& index = sampler.getMovingIndex();
     const int nMoving = index.size();
-    blitz::Array<Vec, 1> gaussRand(nMoving);
+    gaussRand.resize(nMoving);
     gaussRand = 0.0;
     double toldOverTnew = 0.;
     for (int islice = nStride; islice < nSlice - nStride;
@@ -53,5 +53,7 @@ private:
     IArray specIndex;
     /// forward transition prob
     double forwardProb;
+    /// Gaussian random numbers, reused between moves.
+    blitz::Array<Vec, 1> gaussRand;
 };
 #endif
@@ -24,53 +24,18 @@ double FreeTensorMover::makeMove(MultiLevelSampler& sampler, const int level) {
     Beads<NDIM>& movingBeads = sampler.getMovingBeads();
     const SuperCell& cell = sampler.getSuperCell();
     const int nStride = 1 << level;
-    const int nSlice = sectionBeads.getNSlice();
     const blitz::Array<int, 1>& index = sampler.getMovingIndex();
     const int nMoving = index.size();
-    blitz::Array<Vec, 1> gaussRand(nMoving);
-    double toldOverTnew = 0;
-    for (int islice = nStride; islice < nSlice - nStride;
-            islice += 2 * nStride) {
-        RandomNumGenerator::makeGaussRand(gaussRand);
-        for (int iMoving = 0; iMoving < nMoving; ++iMoving) {
-            const int i = index(iMoving);
-            Vec& lambdai = lambda(i);
-            double sigmax = sqrt(lambdai[0] * tau * nStride);
-            double sigmay = sqrt(lambdai[1] * tau * nStride);
-            double sigmaz = sqrt(lambdai[2] * tau * nStride);
-            double inv2Sigma2x = 0.5 / (sigmax * sigmax);
-            double inv2Sigma2y = 0.5 / (sigmay * sigmay);
-            double inv2Sigma2z = 0.5 / (sigmaz * sigmaz);
-            // Calculate the new position.
-
-            Vec midpoint = movingBeads(iMoving, islice + nStride);
-            cell.pbc(midpoint -= movingBeads(iMoving, islice - nStride)) *= 0.5;
-            midpoint += movingBeads(iMoving, islice - nStride);
-            cell.pbc(midpoint);
-            Vec delta = gaussRand(iMoving);
-            delta[0] *= sigmax; // cell.pbc(delta[0]);
-            delta[1] *= sigmay; // cell.pbc(delta[1]);
-            delta[2] *= sigmaz;
-            cell.pbc(delta);
-            (movingBeads(iMoving, islice) = midpoint) += delta;
-            cell.pbc(movingBeads(iMoving, islice));
-            // Add transition probability for move.
-            toldOverTnew += delta[0] * delta[0] * inv2Sigma2x
-                    + delta[1] * delta[1] * inv2Sigma2y
-                    + delta[2] * delta[2] * inv2Sigma2z;
-            // Calculate and add reverse transition probability.
-            midpoint = sectionBeads(i, islice + nStride);
-            cell.pbc(midpoint -= sectionBeads(i, islice - nStride)) *= 0.5;
-            midpoint += sectionBeads(i, islice - nStride);
-            cell.pbc(midpoint);
-            delta = sectionBeads(i, islice);
-            delta -= midpoint;
-            cell.pbc(delta);
-            toldOverTnew -= delta[0] * delta[0] * inv2Sigma2x
-                    + delta[1] * delta[1] * inv2Sigma2y
-                    + delta[2] * delta[2] * inv2Sigma2z;
+    stage.load(movingBeads, sectionBeads, index, level, cell.a.data());
+    for (int iMoving = 0; iMoving < nMoving; ++iMoving) {
+        const Vec& lambdai = lambda(index(iMoving));
+        for (int idim = 0; idim < NDIM; ++idim) {
+            double sigma = sqrt(lambdai[idim] * tau * nStride);
+            stage.setSigma(iMoving, idim, sigma, 0.5 / (sigma * sigma));
         }
     }
+    double toldOverTnew = stage.sample();
+    stage.store(movingBeads);
     ///toldOverTnew=exp(toldOverTnew);
     return toldOverTnew; // return log of probability.
 }
@@ -1,6 +1,7 @@
 #ifndef __FreeTensorMover_h_
 #define __FreeTensorMover_h_
 #include "Mover.h"
+#include "BisectionStage.h"
 class SimulationInfo;
 #include <cstdlib>
 #include <blitz/array.h>
@@ -37,5 +38,7 @@ private:
     blitz::Array<blitz::TinyVector<double, NDIM>, 1> lambda;
     /// The timestep.
     double tau;
+    /// Staging buffer for the bisection moves of a level.
+    BisectionStage<NDIM> stage;
 };
 #endif
@@ -88,7 +88,7 @@ double HyperbolicMover::makeMove(MultiLevelSampler& sampler, const int level) {
     const int nSlice = sectionBeads.getNSlice();
     const blitz::Array<int, 1>& index = sampler.getMovingIndex();
     const int nMoving = index.size();
-    blitz::Array<Vec, 1> gaussRand(nMoving);
+    gaussRand.resize(nMoving);
     double toldOverTnew = 1;
     for (int islice = nStride; islice < nSlice - nStride;
             islice += 2 * nStride) {
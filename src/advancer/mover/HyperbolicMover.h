@@ -55,6 +55,8 @@ private:
     static const double pi;
     /// Norm for g and g2.
     Array normG, normG2;
+    /// Gaussian random numbers, reused between moves.
+    blitz::Array<Vec, 1> gaussRand;
     /// Sample the displacement from a midpoint.
     Vec sampleDelta(Vec& deltaOver2, const double teff, const int ilevel);
     /// Calculate the sampling probability.
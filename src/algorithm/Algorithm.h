@@ -5,5 +5,7 @@ class Algorithm {
 public:
     virtual ~Algorithm() {}
     virtual void run()=0;
+    /// Write any state needed to restart, e.g. before an early stop.
+    virtual void checkpoint() {}
 };
 #endif
@@ -0,0 +1,186 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "BinaryPathFile.h"
+#include "base/ModelState.h"
+#include "base/Paths.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char BinaryPathFile::MAGIC[8]={'P','I','Q','M','C','P','T','H'};
+const unsigned int BinaryPathFile::BYTE_ORDER_MARK;
+const unsigned int BinaryPathFile::VERSION;
+
+namespace {
+template <class T>
+void put(std::string& s, const T& value) {
+  s.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+T get(const char*& p) {
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  p+=sizeof(T);
+  return value;
+}
+}
+
+BinaryPathFile::BinaryPathFile(const std::string& filename, long long offset)
+  : npart(0), nslice(0), permutation(0), map(0), mapLength(0), data(0) {
+  int fd=open(filename.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd<0 || fstat(fd,&st)!=0) {
+    std::cout << "ERROR: could not open path file " << filename << std::endl;
+    exit(-1);
+  }
+  // mmap offsets must be page aligned.
+  long long page=sysconf(_SC_PAGESIZE);
+  long long start=(offset/page)*page;
+  mapLength=st.st_size-start;
+  if (offset<0 || offset+32>st.st_size) {
+    std::cout << "ERROR: no path snapshot at byte " << offset
+              << " of " << filename << std::endl;
+    exit(-1);
+  }
+  map=mmap(0, mapLength, PROT_READ, MAP_SHARED, fd, start);
+  close(fd);
+  if (map==MAP_FAILED) {
+    std::cout << "ERROR: could not map path file " << filename << std::endl;
+    exit(-1);
+  }
+  const char *frame=static_cast<const char*>(map)+(offset-start);
+  const char *p=frame;
+  if (std::memcmp(p, MAGIC, 8)!=0) {
+    std::cout << "ERROR: " << filename << " is not a binary path file"
+              << std::endl;
+    exit(-1);
+  }
+  p+=8;
+  if (get<unsigned int>(p)!=BYTE_ORDER_MARK) {
+    std::cout << "ERROR: " << filename << " was written with a different "
+              << "byte order" << std::endl;
+    exit(-1);
+  }
+  unsigned int version=get<unsigned int>(p);
+  long long dataOffset=get<long long>(p);
+  npart=get<int>(p);
+  nslice=get<int>(p);
+  int ndim=get<int>(p);
+  int nspecies=get<int>(p);
+  if (version!=VERSION || ndim!=NDIM) {
+    std::cout << "ERROR: " << filename << " has version " << version
+              << " and " << ndim << " dimensions, expected version "
+              << VERSION << " and " << NDIM << std::endl;
+    exit(-1);
+  }
+  if (offset+dataOffset+(long long)nslice*npart*NDIM*(long long)sizeof(double)
+      > (long long)st.st_size) {
+    std::cout << "ERROR: path file " << filename << " is truncated"
+              << std::endl;
+    exit(-1);
+  }
+  for (int ispec=0; ispec<nspecies; ++ispec) {
+    speciesCount.push_back(get<int>(p));
+    get<int>(p);
+    int length=get<int>(p);
+    speciesName.push_back(std::string(p,length));
+    p+=length;
+  }
+  permutation=new Permutation(npart);
+  for (int i=0; i<npart; ++i) (*permutation)[i]=get<int>(p);
+  int length=get<int>(p);
+  modelState=std::string(p,length);
+  data=reinterpret_cast<const double*>(frame+dataOffset);
+}
+
+BinaryPathFile::~BinaryPathFile() {
+  if (map) munmap(map, mapLength);
+  delete permutation;
+}
+
+bool BinaryPathFile::isBinary(const std::string& filename) {
+  std::ifstream file(filename.c_str(), std::ios::binary);
+  char magic[8];
+  if (!file.read(magic,8)) return false;
+  return std::memcmp(magic, MAGIC, 8)==0;
+}
+
+std::string BinaryPathFile::makeHeader(const SimulationInfo& simInfo,
+    const Paths& paths, const Permutation& perm) {
+  const int npart=paths.getNPart();
+  std::string header(MAGIC, 8);
+  put(header, BYTE_ORDER_MARK);
+  put(header, VERSION);
+  const int offsetPosition=header.size();
+  put(header, (long long)0);
+  put(header, npart);
+  put(header, paths.getNSlice());
+  put(header, (int)NDIM);
+  put(header, simInfo.getNSpecies());
+  for (int ispec=0; ispec<simInfo.getNSpecies(); ++ispec) {
+    const Species& species(simInfo.getSpecies(ispec));
+    put(header, species.count);
+    put(header, species.ifirst);
+    put(header, (int)species.name.size());
+    header.append(species.name);
+  }
+  for (int i=0; i<npart; ++i) put(header, perm[i]);
+  std::ostringstream state;
+  if (paths.getModelState()) paths.getModelState()->write(state);
+  put(header, (int)state.str().size());
+  header.append(state.str());
+  // Pad so that the coordinates are aligned doubles.
+  header.append((8-header.size()%8)%8, '\0');
+  long long dataOffset=header.size();
+  std::memcpy(&header[offsetPosition], &dataOffset, sizeof(dataOffset));
+  return header;
+}
+
+void BinaryPathFile::writeAt(int fd, const void* buf, long long nbyte,
+    long long offset, const std::string& filename) {
+  const char *p=static_cast<const char*>(buf);
+  while (nbyte>0) {
+    ssize_t n=pwrite(fd, p, nbyte, offset);
+    if (n<0) {
+      std::cout << "ERROR: could not write to " << filename << std::endl;
+      exit(-1);
+    }
+    p+=n; nbyte-=n; offset+=n;
+  }
+}
+
+std::string BinaryPathFile::getIndexName(const std::string& movieName) {
+  return movieName+".idx";
+}
+
+int BinaryPathFile::getFrameCount(const std::string& movieName) {
+  struct stat st;
+  if (stat(getIndexName(movieName).c_str(),&st)!=0) return 0;
+  return st.st_size/sizeof(long long);
+}
+
+long long BinaryPathFile::getFrameOffset(const std::string& movieName,
+    int iframe) {
+  if (iframe==0) return 0;
+  int nframe=getFrameCount(movieName);
+  if (iframe<0) iframe+=nframe;
+  if (iframe<0 || iframe>=nframe) {
+    std::cout << "ERROR: frame " << iframe << " is not in the "
+              << nframe << " frames of " << movieName << std::endl;
+    exit(-1);
+  }
+  std::ifstream index(getIndexName(movieName).c_str(), std::ios::binary);
+  index.seekg((long long)iframe*sizeof(long long));
+  long long offset=0;
+  index.read(reinterpret_cast<char*>(&offset), sizeof(offset));
+  return offset;
+}
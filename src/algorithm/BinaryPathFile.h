@@ -0,0 +1,78 @@
+#ifndef __BinaryPathFile_h_
+#define __BinaryPathFile_h_
+
+#include "util/Permutation.h"
+#include <blitz/tinyvec.h>
+#include <string>
+#include <vector>
+class Paths;
+class SimulationInfo;
+
+/// Memory-mapped reader and layout helpers for binary path snapshots.
+///
+/// A snapshot is a header followed by raw doubles in slice-major order,
+/// coordinate(islice,ipart,idim), in the byte order of the host that
+/// wrote it; the reader uses the byte-order mark to reject files from a
+/// host with a different byte order.
+/// The header holds a magic string, a byte-order mark, the offset of
+/// the coordinate data, npart, nslice, NDIM, the species layout,
+/// the global permutation and the model state string,
+/// padded to a multiple of eight bytes.
+///
+/// Because the data offset is known from the header size alone, each
+/// worker can write its own slices at a computed offset with pwrite.
+/// A movie is a sequence of snapshots appended to one file, with
+/// an index file (the movie name plus ".idx") holding the byte offset
+/// of each frame as a 64-bit integer.
+class BinaryPathFile {
+public:
+  typedef blitz::TinyVector<double,NDIM> Vec;
+  /// Map the snapshot starting at byte offset in the file.
+  BinaryPathFile(const std::string& filename, long long offset=0);
+  /// Unmap the file.
+  ~BinaryPathFile();
+  /// Check the magic string to see if a file is a binary snapshot.
+  static bool isBinary(const std::string& filename);
+  /// Build the header for a snapshot of the paths.
+  static std::string makeHeader(const SimulationInfo&, const Paths&,
+                                const Permutation&);
+  /// Write a buffer at an offset, exiting on error.
+  static void writeAt(int fd, const void* buf, long long nbyte,
+                      long long offset, const std::string& filename);
+  /// Name of the index file for a movie.
+  static std::string getIndexName(const std::string& movieName);
+  /// Number of frames in a movie.
+  static int getFrameCount(const std::string& movieName);
+  /// Byte offset of a frame in a movie, counting from the end if negative.
+  static long long getFrameOffset(const std::string& movieName, int iframe);
+  int getNPart() const {return npart;}
+  int getNSlice() const {return nslice;}
+  int getNSpecies() const {return speciesCount.size();}
+  const std::string& getSpeciesName(int i) const {return speciesName[i];}
+  int getSpeciesCount(int i) const {return speciesCount[i];}
+  const Permutation& getPermutation() const {return *permutation;}
+  const std::string& getModelState() const {return modelState;}
+  /// Get a bead position.
+  Vec operator()(int ipart, int islice) const {
+    const double *p=data+((long long)islice*npart+ipart)*NDIM;
+    Vec v;
+    for (int idim=0; idim<NDIM; ++idim) v[idim]=p[idim];
+    return v;
+  }
+  static const char MAGIC[8];
+  static const unsigned int BYTE_ORDER_MARK=0x01020304;
+  static const unsigned int VERSION=1;
+private:
+  int npart;
+  int nslice;
+  std::vector<std::string> speciesName;
+  std::vector<int> speciesCount;
+  Permutation *permutation;
+  std::string modelState;
+  /// Start of the mapping and its length.
+  void *map;
+  long long mapLength;
+  /// Start of the coordinate data.
+  const double *data;
+};
+#endif
@@ -35,6 +35,10 @@ public:
   virtual void run() {
     for(unsigned int i=0;i<step.size();++i)   if (step[i]) step[i]->run();
   }
+  /// Checkpoint all steps of the algorithm.
+  virtual void checkpoint() {
+    for(unsigned int i=0;i<step.size();++i) if (step[i]) step[i]->checkpoint();
+  }
   /// Resize the number of steps in the algorithm.
   void resize(const int n) {
     for(unsigned int i=0;i<step.size();++i) delete step[i];
@@ -42,6 +46,10 @@ public:
   }
   /// Set algorithm for step i.
   void set(const int i, Algorithm* a) {step[i]=a;}
+  /// Get the number of steps.
+  int getNStep() const {return step.size();}
+  /// Get algorithm for step i.
+  Algorithm* get(const int i) const {return step[i];}
 private:
   /// Steps in the algorithm.
   std::vector<Algorithm*> step;
@@ -6,6 +6,9 @@
 #include "base/Species.h"
 #include <blitz/tinyvec-et.h>
 #include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 ConditionalDensityGrid::ConditionalDensityGrid(const IVec n,
   const double a, const SimulationInfo& simInfo,
@@ -14,6 +17,16 @@ ConditionalDensityGrid::ConditionalDensityGrid(const IVec n,
     ilast(species.ifirst+species.count), center(center), radius(radius) {
 }
 
+void ConditionalDensityGrid::initCalc(const int nslice,
+    const int firstSlice) {
+  ProbDensityGrid::initCalc(nslice,firstSlice);
+  int nthread=1;
+#ifdef _OPENMP
+  nthread=omp_get_max_threads();
+#endif
+  threadNorm.assign(nthread*NORM_STRIDE,0.);
+}
+
 void ConditionalDensityGrid::handleLink(const Vec& start, const Vec& end,
   const int ipart, const int islice, const Paths& paths) {
   // Bin the density for this slice if we meet the condition.
@@ -34,12 +47,21 @@ void ConditionalDensityGrid::handleLink(const Vec& start, const Vec& end,
           i[idim]=(int)floor(dot(point,b[idim])+n[idim]/2);
           if (i[idim]<0||i[idim]>=n[idim]) break;
           // Increment the bin if we made it through all dimensions.
-          if (idim==NDIM-1) ++((*grid[index[jpart]])(i));
+          if (idim==NDIM-1) ++(shards[index[jpart]]->get()(i));
         }
       }
-      ++norm; 
+      int ithread=0;
+#ifdef _OPENMP
+      ithread=omp_get_thread_num();
+#endif
+      ++threadNorm[ithread*NORM_STRIDE];
     }
   }
 }
 
-void ConditionalDensityGrid::endCalc(const int nslice) {;}
+void ConditionalDensityGrid::endCalc(const int nslice) {
+  reduceShards();
+  for (unsigned int i=0; i<threadNorm.size(); i+=NORM_STRIDE) {
+    norm+=threadNorm[i];
+  }
+}
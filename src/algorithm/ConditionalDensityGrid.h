@@ -39,6 +39,8 @@ public:
 		  const Species&, Vec center, const double radius);
   /// Virtual destructor.
   virtual ~ConditionalDensityGrid() {;}
+  /// Initialize the calculation.
+  virtual void initCalc(const int nslice, const int firstSlice);
   /// Add contribution from a link.
   virtual void handleLink(const Vec& start, const Vec& end,
                           const int ipart, const int islice, const Paths&);
@@ -51,5 +53,8 @@ private:
   const Vec center;
   /// Radius of the conditoinal region.
   const double radius;
+  /// Per-thread normalization counts, one cache line apart.
+  std::vector<double> threadNorm;
+  static const int NORM_STRIDE=8;
 };
 #endif
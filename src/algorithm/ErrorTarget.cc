@@ -0,0 +1,35 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "ErrorTarget.h"
+#include "stats/ScalarEstimator.h"
+#include <cmath>
+#include <iostream>
+
+ErrorTarget::ErrorTarget(const ScalarEstimator &estimator, double absError,
+        double relError)
+    :   estimator(estimator),
+        absError(absError),
+        relError(relError) {
+}
+
+ErrorTarget::~ErrorTarget() {
+}
+
+bool ErrorTarget::isMet() const {
+    if (!estimator.hasError()) return false;
+    double error = estimator.getError();
+    if (absError > 0 && error > absError) return false;
+    if (relError > 0 && error > relError * fabs(estimator.getMean())) {
+        return false;
+    }
+    return true;
+}
+
+void ErrorTarget::print() const {
+    std::cout << estimator.getName() << " = " << estimator.getMean()
+            << " +- " << estimator.getError();
+    if (absError > 0) std::cout << " (target " << absError << ")";
+    if (relError > 0) std::cout << " (relative target " << relError << ")";
+    std::cout << std::endl;
+}
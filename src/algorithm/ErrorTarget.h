@@ -0,0 +1,25 @@
+#ifndef __ErrorTarget_h_
+#define __ErrorTarget_h_
+
+class ScalarEstimator;
+
+/** Target error bar on a scalar estimator, used to end a Loop early.
+
+ The target is met when the blocked error of the run average is below
+ the absolute target and below the relative target times the magnitude
+ of the average. A target of zero is ignored.
+ @see Loop */
+class ErrorTarget {
+public:
+    ErrorTarget(const ScalarEstimator &estimator, double absError,
+            double relError);
+    virtual ~ErrorTarget();
+
+    bool isMet() const;
+    void print() const;
+private:
+    const ScalarEstimator &estimator;
+    const double absError;
+    const double relError;
+};
+#endif
@@ -22,10 +22,17 @@
 #include "stats/MPIManager.h"
 
 #include "CompositeAlgorithm.h"
+#include "ErrorTarget.h"
 #include <iostream> ////////// dak
 #include <string>   ////////// sak
+#include <vector>
 #include <time.h>
 /** Algorithm class for looping.
+ * If ErrorTarget objects are added, the loop also stops once all
+ * targets are met, after checkpointing the steps of the loop.
+ * The decision is made on the main process and shared with all clones;
+ * to keep that broadcast out of the inner loop, the targets are only
+ * checked every errorCheckInterval iterations (10 by default).
  * @version $Revision$
  * @author John Shumway */
 class Loop : public CompositeAlgorithm {
@@ -33,10 +40,18 @@ public:
   Loop(const int nrepeat, const int totalSimTime, const std::string timer,
        const MPIManager* mpi, const int nsteps=0) 
     : CompositeAlgorithm(nsteps), nrepeat(nrepeat), totalSimTime(totalSimTime),
-      timer(timer), mpi(mpi) {
+      timer(timer), mpi(mpi), errorCheckInterval(10), iteration(0) {
   }
     
-    virtual ~Loop() {}
+    virtual ~Loop() {
+      for(unsigned int i=0;i<errorTarget.size();++i) delete errorTarget[i];
+    }
+
+    /// Add an error target; the loop takes ownership.
+    void addErrorTarget(ErrorTarget* target) {errorTarget.push_back(target);}
+
+    /// Set how many iterations pass between checks of the error targets.
+    void setErrorCheckInterval(int interval) {errorCheckInterval=interval;}
 
     virtual void run() {
 
@@ -68,6 +83,7 @@ public:
 	printElapsedTime(dif);	  
 	printAlgorithmTime(dt);
 #endif
+	  if (hasMetErrorTargets()) break;
 
 	//	std :: cout << mpi->getCloneID()<<" cid. "<<mpi->getWorkerID()<<" iw. "<<dt<<" "<<  dif<<std :: endl<<std::flush;
 	}
@@ -93,7 +109,7 @@ public:
       	if (timer=="" && totalSimTime==0){
 	  for(int i=0;  i<nrepeat; ++i )	 {
 	    CompositeAlgorithm::run();
-
+	    if (hasMetErrorTargets()) break;
 	  }
 	}
       }
@@ -114,10 +130,34 @@ public:
       std :: cout << "Time spent inside loop ["<<timer<< "] ..... :: "<<mn<<" min(s), "<<sc<<" sec(s), or total time in seconds :: "<<dt<<" secs."<<std :: endl<<std::flush;
     }
     
+    /// Check the error targets, checkpointing if they have all been met.
+    bool hasMetErrorTargets() {
+      if (errorTarget.empty()) return false;
+      if (++iteration%errorCheckInterval!=0) return false;
+      int isMet = 1;
+      for(unsigned int i=0;i<errorTarget.size();++i) {
+        if (!errorTarget[i]->isMet()) isMet = 0;
+      }
+#ifdef ENABLE_MPI
+      if (mpi) MPI::COMM_WORLD.Bcast(&isMet,1,MPI::INT,0);
+#endif
+      if (isMet) {
+        if (!mpi || mpi->isMain()) {
+          std::cout << "Error targets met, stopping loop." << std::endl;
+          for(unsigned int i=0;i<errorTarget.size();++i) errorTarget[i]->print();
+        }
+        checkpoint();
+      }
+      return isMet;
+    }
+
  private:
     const int nrepeat;
     const int totalSimTime;
     const std::string timer;
     const MPIManager* mpi;
+    std::vector<ErrorTarget*> errorTarget;
+    int errorCheckInterval;
+    int iteration;
 };
 #endif
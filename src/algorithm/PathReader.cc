@@ -3,6 +3,7 @@
 #include <mpi.h>
 #endif
 #include "PathReader.h"
+#include "BinaryPathFile.h"
 #include "base/Beads.h"
 #include "base/BeadFactory.h"
 #include "base/ModelState.h"
@@ -19,6 +20,14 @@ void PathReader::run() {
   int workerID=(mpi)?mpi->getWorkerID():0;
   int nclone=(mpi)?mpi->getNClone():1;
   int cloneID=(mpi)?mpi->getCloneID():0;
+  {
+    std::stringstream ext;
+    if (nclone>1) ext << cloneID;
+    if (BinaryPathFile::isBinary(filename+ext.str())) {
+      readBinary(filename+ext.str());
+      return;
+    }
+  }
   std::ifstream *infile=0;
   if (workerID==0){
     /// Add cloneID to name if there are clones.
@@ -139,3 +148,49 @@ void PathReader::run() {
     }
 */
 }
+
+void PathReader::readBinary(const std::string& name) {
+  int workerID=(mpi)?mpi->getWorkerID():0;
+  if (workerID==0) {
+    std::cout << "Reading binary paths from file " << name << std::endl;
+  }
+  BinaryPathFile file(name,BinaryPathFile::getFrameOffset(name,frame));
+  int npart=paths.getNPart();
+  int nslice=paths.getNSlice();
+  int nfslice=nslice/bfactor;
+  if (file.getNPart()!=npart || file.getNSlice()!=nfslice) {
+    std::cout << "ERROR: " << name << " has " << file.getNPart()
+              << " particles and " << file.getNSlice() << " slices, expected "
+              << npart << " and " << nfslice << std::endl;
+    exit(-1);
+  }
+  if (paths.hasModelState()) {
+    paths.getModelState()->read(file.getModelState());
+  }
+  Beads<NDIM> &slice(*beadFactory.getNewBeads(npart,1));
+  Permutation pidentity(npart);
+  // Only touch the pages of slices this worker owns.
+  for (int islice=0; islice<nfslice; ++islice) {
+    bool isOwned=false;
+    for (int ib=0; ib<bfactor; ++ib) {
+      if (paths.isOwnedSlice(islice+ib*nfslice)) isOwned=true;
+    }
+    if (!isOwned) continue;
+    for (int i=0; i<npart; ++i) slice(i,0)=file(i,islice);
+    if (islice<nfslice-1) {
+      for (int ib=0; ib<bfactor; ++ib) {
+        int jslice=islice+ib*nfslice;
+        if (paths.isOwnedSlice(jslice)) paths.putBeads(jslice,slice,pidentity);
+      }
+    } else {
+      for (int ib=bfactor-1; ib>=0; --ib) {
+        int jslice=islice+ib*nfslice;
+        if (paths.isOwnedSlice(jslice)) {
+          paths.putBeads(jslice,slice,file.getPermutation());
+        }
+      }
+    }
+  }
+  paths.setBuffers();
+  delete &slice;
+}
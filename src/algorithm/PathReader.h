@@ -23,7 +23,11 @@ class Paths;
 class MPIManager;
 class BeadFactory;
 
-/** Class for positioning particles in a cubic lattice.
+/** Class for reading paths from a file.
+ * Files in the BinaryPathFile format are detected by their magic string
+ * and memory mapped by every worker, which copies only its own slices.
+ * For a binary movie, frame selects the snapshot (negative counts from
+ * the end).
  * @version $Revision$
  * @author John Shumway */
 class PathReader : public Positioner {
@@ -31,9 +35,9 @@ public:
   /// Constructor.
   PathReader(Paths& paths, std::string& filename, 
              const BeadFactory &beadFactory,
-             const int bfactor=1, MPIManager *mpi=0)
+             const int bfactor=1, MPIManager *mpi=0, const int frame=0)
    : paths(paths), filename(filename), beadFactory(beadFactory),
-     bfactor(bfactor), mpi(mpi) {}
+     bfactor(bfactor), mpi(mpi), frame(frame) {}
   /// Virtual destructor.
   virtual ~PathReader() {}
   /// Algorithm run method.
@@ -49,6 +53,10 @@ private:
   const int bfactor;
   /// Pointer to the MPI manager. 
   MPIManager *mpi;
+  /// Frame to read from a binary movie.
+  const int frame;
+  /// Read paths from a binary file.
+  void readBinary(const std::string& name);
 };
 
 #endif
@@ -7,7 +7,7 @@
 
 ProbDensityGrid::ProbDensityGrid(const IVec n,
   const double a, const SimulationInfo& simInfo, const Paths* paths)
-  : grid(simInfo.getNSpecies()), paths(paths),
+  : grid(simInfo.getNSpecies()), shards(simInfo.getNSpecies()), paths(paths),
     norm(0), n(n), a(a), b(3), index(simInfo.getNPart(),0) {
   for (int i=0; i<NDIM; ++i) {
     b[i]=0.0;
@@ -16,6 +16,7 @@ ProbDensityGrid::ProbDensityGrid(const IVec n,
   for (int ispec=0; ispec<simInfo.getNSpecies(); ++ispec) {
     grid[ispec]=new LIArray(n);
     (*grid[ispec])=0;
+    shards[ispec]=new HistogramShards<long int,NDIM>();
     for (int ipart=0; ipart<simInfo.getNPart(); ++ipart) {
       if (&simInfo.getPartSpecies(ipart) == &simInfo.getSpecies(ispec)) {
         index[ipart]=ispec; 
@@ -26,6 +27,7 @@ ProbDensityGrid::ProbDensityGrid(const IVec n,
 
 ProbDensityGrid::~ProbDensityGrid() {
   for (unsigned int i=0; i<grid.size(); ++i) delete grid[i];
+  for (unsigned int i=0; i<shards.size(); ++i) delete shards[i];
 }
 
 void ProbDensityGrid::bin() {
@@ -33,6 +35,10 @@ void ProbDensityGrid::bin() {
   paths->sumOverLinks(*this);
 }
 
+void ProbDensityGrid::initCalc(const int nslice, const int firstSlice) {
+  for (unsigned int i=0; i<grid.size(); ++i) shards[i]->init(*grid[i]);
+}
+
 void ProbDensityGrid::handleLink(const Vec& start, const Vec& end,
   const int ipart, const int islice, const Paths& paths) {
   IVec i;
@@ -40,7 +46,14 @@ void ProbDensityGrid::handleLink(const Vec& start, const Vec& end,
     i[idim]=(int)floor(dot(start,b[idim])+n[idim]/2);
     if (i[idim]<0||i[idim]>=n[idim]) return;
   }
-  ++((*grid[index[ipart]])(i));
+  ++(shards[index[ipart]]->get()(i));
 }
 
-void ProbDensityGrid::endCalc(const int nslice) {norm+=nslice;}
+void ProbDensityGrid::endCalc(const int nslice) {
+  reduceShards();
+  norm+=nslice;
+}
+
+void ProbDensityGrid::reduceShards() {
+  for (unsigned int i=0; i<shards.size(); ++i) shards[i]->reduce();
+}
@@ -3,6 +3,7 @@
 
 #include "Algorithm.h"
 #include "base/LinkSummable.h"
+#include "util/HistogramShards.h"
 #include <vector>
 #include <cstdlib>
 #include <blitz/array.h>
@@ -35,14 +36,22 @@ public:
   IVec getGridDim() const {return n;}
   /// Add the current path positions to bins.
   void bin();
+  /// Initialize the calculation.
+  virtual void initCalc(const int nslice, const int firstSlice);
   /// Add contribution from a link.
   virtual void handleLink(const Vec& start, const Vec& end,
                           int ipart, const int islice, const Paths&);
   /// Finalize the calculation.
   virtual void endCalc(const int nslice);
+  /// Links are binned into per-thread shards.
+  virtual bool isThreadSafe() const {return true;}
 protected:
   /// The grids for storing probability densities.
   std::vector<LIArray*> grid;
+  /// Per-thread shards of each grid.
+  std::vector<HistogramShards<long int,NDIM>*> shards;
+  /// Add the shards into the grids.
+  void reduceShards();
   /// The path storage.
   const Paths* paths;
   /// The normalization. 
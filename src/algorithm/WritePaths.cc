@@ -3,6 +3,7 @@
 #include <mpi.h>
 #endif
 #include "WritePaths.h"
+#include "BinaryPathFile.h"
 #include "base/Beads.h"
 #include "base/BeadFactory.h"
 #include "base/ModelState.h"
@@ -12,14 +13,19 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
 
 WritePaths::WritePaths(Paths& paths, const std::string& filename, int dumpFreq,
   int maxConfigs,  bool writeMovie, const SimulationInfo& simInfo, 
-  MPIManager *mpi, const BeadFactory& beadFactory)
+  MPIManager *mpi, const BeadFactory& beadFactory, bool binary)
   : filename(filename), paths(paths), mpi(mpi), beadFactory(beadFactory), 
     dumpFreq(dumpFreq), simInfo(simInfo), maxConfigs(maxConfigs),
-    writeMovie(writeMovie) {
-  if (writeMovie) movieFile = new std::ofstream("pathMovie", std::ios::out);
+    writeMovie(writeMovie), binary(binary), movieOffset(0),
+    movieFrameCount(0) {
+  if (writeMovie && !binary) {
+    movieFile = new std::ofstream("pathMovie", std::ios::out);
+  }
 }
 
 void WritePaths::run() {
@@ -30,8 +36,24 @@ void WritePaths::run() {
     return;
   }
   dumpPathCounter=0;
+  write(true);
+}
+
+void WritePaths::checkpoint() {
+  write(false);
+}
+
+void WritePaths::write(bool isMovieFrame) {
   static int dumpMovieCounter=0;
-  dumpMovieCounter++;
+  if (isMovieFrame) dumpMovieCounter++;
+  bool writeMovie = this->writeMovie && isMovieFrame;
+
+  if (binary) {
+    bool restartMovie = writeMovie && dumpMovieCounter > maxConfigs;
+    if (restartMovie) dumpMovieCounter=0;
+    writeBinary(writeMovie, restartMovie);
+    return;
+  }
 
   //Prepare file handlers 
   int workerID=(mpi)?mpi->getWorkerID():0;
@@ -112,3 +134,105 @@ void WritePaths::run() {
   }
   if (workerID==0) delete file;
 }
+
+void WritePaths::writeBinary(bool writeMovie, bool restartMovie) {
+  int workerID=(mpi)?mpi->getWorkerID():0;
+  int nclone=(mpi)?mpi->getNClone():1;
+  int cloneID=(mpi)?mpi->getCloneID():0;
+  const int npart=paths.getNPart();
+  const int nslice=paths.getNSlice();
+
+  Permutation perm(paths.getGlobalPermutation());
+  // Each worker's beads are labeled by the permutations of the workers
+  // before it; pass the accumulated relabeling down the line.
+  Permutation relabel(npart);
+#ifdef ENABLE_MPI
+  int nworker=(mpi)?mpi->getNWorker():1;
+  if (mpi && nworker>1) {
+    if (workerID>0) {
+      mpi->getWorkerComm().Recv(&relabel[0],npart,MPI::INT,workerID-1,3);
+    }
+    if (workerID<nworker-1) {
+      Permutation next(relabel);
+      next.append(paths.getPermutation());
+      mpi->getWorkerComm().Send(&next[0],npart,MPI::INT,workerID+1,3);
+    }
+  }
+#endif
+  std::string header;
+  if (workerID==0) header=BinaryPathFile::makeHeader(simInfo,paths,perm);
+  long long headerSize=header.size();
+#ifdef ENABLE_MPI
+  if (mpi && nworker>1) {
+    mpi->getWorkerComm().Bcast(&headerSize,1,MPI::LONG_LONG,0);
+  }
+#endif
+
+  // Pack the owned slices.
+  int ifirst=paths.getLowestOwnedSlice(false);
+  int ilast=paths.getHighestOwnedSlice(false);
+  slab.resize((ilast-ifirst+1)*npart*NDIM);
+  int k=0;
+  for (int islice=ifirst; islice<=ilast; ++islice) {
+    for (int ipart=0; ipart<npart; ++ipart) {
+      const Paths::Vec& p(paths(relabel[ipart],islice));
+      for (int idim=0; idim<NDIM; ++idim) slab[k++]=p[idim];
+    }
+  }
+  long long dataOffset=headerSize+(long long)ifirst*npart*NDIM*sizeof(double);
+
+  std::stringstream ext;
+  if (nclone>1) ext << cloneID;
+  writeFrame(filename+ext.str(),0,true,header,dataOffset);
+
+  if (cloneID==0 && writeMovie) {
+    if (restartMovie) {
+      movieOffset=0;
+      movieFrameCount=0;
+    }
+    std::string movieName("pathMovie.bin");
+    writeFrame(movieName,movieOffset,movieFrameCount==0,header,
+               movieOffset+dataOffset);
+    if (workerID==0) {
+      std::string indexName=BinaryPathFile::getIndexName(movieName);
+      int flags=O_WRONLY|O_CREAT|((movieFrameCount==0)?O_TRUNC:0);
+      int fd=open(indexName.c_str(),flags,0644);
+      BinaryPathFile::writeAt(fd,&movieOffset,sizeof(movieOffset),
+          movieFrameCount*(long long)sizeof(movieOffset),indexName);
+      close(fd);
+    }
+    movieOffset+=headerSize+(long long)nslice*npart*NDIM*sizeof(double);
+    ++movieFrameCount;
+  }
+}
+
+void WritePaths::writeFrame(const std::string& name, long long frameOffset,
+    bool truncate, const std::string& header, long long dataOffset) {
+  int workerID=(mpi)?mpi->getWorkerID():0;
+  int fd=-1;
+  // The first worker creates the file and writes the header before
+  // the other workers open it.
+  if (workerID==0) {
+    int flags=O_WRONLY|O_CREAT|(truncate?O_TRUNC:0);
+    fd=open(name.c_str(),flags,0644);
+    if (fd<0) {
+      std::cout << "ERROR: could not open " << name << std::endl;
+      exit(-1);
+    }
+    BinaryPathFile::writeAt(fd,header.data(),header.size(),frameOffset,name);
+  }
+#ifdef ENABLE_MPI
+  int nworker=(mpi)?mpi->getNWorker():1;
+  if (mpi && nworker>1) mpi->getWorkerComm().Barrier();
+#endif
+  if (workerID!=0) {
+    fd=open(name.c_str(),O_WRONLY);
+    if (fd<0) {
+      std::cout << "ERROR: could not open " << name << std::endl;
+      exit(-1);
+    }
+  }
+  BinaryPathFile::writeAt(fd,&slab[0],slab.size()*sizeof(double),
+                          dataOffset,name);
+  close(fd);
+}
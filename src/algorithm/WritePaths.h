@@ -19,6 +19,7 @@
 
 #include "Algorithm.h"
 #include <string>
+#include <vector>
 template <int TDIM> class Beads;
 class Paths;
 class MPIManager;
@@ -40,6 +41,12 @@ class SimulationInfo;
 ///
 /// Because of the uni-directionality of shift, beads are written
 /// in reverse time order.
+///
+/// With the binary flag, paths are written in the BinaryPathFile format
+/// instead. There is no shifting: each worker relabels its own slices
+/// to the particle labels of the first worker and writes them at their
+/// offset in the file. The movie is written to pathMovie.bin, with frame
+/// offsets in pathMovie.bin.idx.
 /// 
 /// @version $Revision$
 /// @bug Reading and writting are done backwards because of Paths::shift
@@ -49,11 +56,13 @@ public:
   /// Construct by providing the paths to write.
   WritePaths(Paths&, const std::string&, int dumpFreq, int maxConfigs, 
     bool writeMovie, const SimulationInfo& simInfo, MPIManager*, 
-    const BeadFactory&);
+    const BeadFactory&, bool binary=false);
   /// Virtual destructor.
   virtual ~WritePaths() {}
-  /// Write the paths.
+  /// Write the paths every dumpFreq calls.
   virtual void run();
+  /// Write the paths now.
+  virtual void checkpoint();
 private:
   /// The filename to write to.
   std::string filename;
@@ -68,6 +77,21 @@ private:
   const int maxConfigs;
   const bool writeMovie;
   std::ofstream *movieFile;
+  /// Flag for the binary path format.
+  const bool binary;
+  /// Byte offset and number of frames of the binary movie.
+  long long movieOffset;
+  int movieFrameCount;
+  /// This worker's slices, packed for writing.
+  std::vector<double> slab;
+  /// Gather and write the paths, optionally as a frame of the movie.
+  void write(bool isMovieFrame);
+  /// Write the paths in the binary format from every worker.
+  void writeBinary(bool writeMovie, bool restartMovie);
+  /// Write one snapshot at an offset in a binary file.
+  void writeFrame(const std::string& name, long long frameOffset,
+                  bool truncate, const std::string& header,
+                  long long dataOffset);
   
 };
 #endif
@@ -175,7 +175,10 @@ public:
   /// Return a pointer to the supercell.
   const SuperCell* getSuperCell() const {return cell;}
   /// Permute the beads.
-  void permute(const Permutation&);
+  void permute(const Permutation& p) {permute(p,0,nslice);}
+  /// Permute the beads on slices [ifirstSlice,iendSlice).
+  /// Only particles moved by the permutation are touched.
+  void permute(const Permutation&, int ifirstSlice, int iendSlice);
   /// Return a reference to the coordinate array (for MPI calls).
   VArray2& getCoordArray() {return coord;}
 protected:
@@ -215,6 +218,9 @@ private:
   VArray2 coord;
   /// The super cell.
   const SuperCell* cell;
+  /// Scratch storage for permute.
+  IArray permMoved;
+  VArray permBuffer;
 };
 
 
@@ -222,14 +228,16 @@ private:
 template <int TDIM>
 Beads<TDIM>::Beads(const int npart, const int nslice) 
  : BeadsBase(npart, nslice),
-   coord(npart,nslice,blitz::ColumnMajorArray<2>()), cell(0) {
+   coord(npart,nslice,blitz::ColumnMajorArray<2>()), cell(0),
+   permMoved(npart), permBuffer(npart) {
  auxBeads[0]=this;
  coord=0.0;
 }
 
 template <int TDIM>
 Beads<TDIM>::Beads(const Beads& b) 
- : BeadsBase(b.npart,b.nslice), coord(b.coord.copy()), cell(b.cell) {
+ : BeadsBase(b.npart,b.nslice), coord(b.coord.copy()), cell(b.cell),
+   permMoved(b.npart), permBuffer(b.npart) {
 }
 
 template <int TDIM>
@@ -251,12 +259,16 @@ void Beads<TDIM>::print(std::ostream& out) const {
 }
 
 template <int TDIM>
-void Beads<TDIM>::permute(const Permutation& p) {
-  VArray buffer(npart);
-  for (int islice=0; islice<nslice; ++islice) {
+void Beads<TDIM>::permute(const Permutation& p, 
+                          int ifirstSlice, int iendSlice) {
+  // Exchange moves only change a few particles, so skip the fixed points.
+  int nmoved=0;
+  for (int i=0; i<npart; ++i) if (p[i]!=i) permMoved(nmoved++)=i;
+  if (nmoved==0) return;
+  for (int islice=ifirstSlice; islice<iendSlice; ++islice) {
     // Swap paths.
-    for (int i=0; i<npart; ++i) buffer(i)=coord(p[i],islice);
-    for (int i=0; i<npart; ++i) coord(i,islice)=buffer(i);
+    for (int k=0; k<nmoved; ++k) permBuffer(k)=coord(p[permMoved(k)],islice);
+    for (int k=0; k<nmoved; ++k) coord(permMoved(k),islice)=permBuffer(k);
   }
 }
 #endif
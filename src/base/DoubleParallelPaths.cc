@@ -43,12 +43,19 @@ DoubleParallelPaths::~DoubleParallelPaths() {
 
 void DoubleParallelPaths::sumOverLinks(LinkSummable& estimator) const {
   estimator.initCalc(2*nprocSlice,1+ifirst);
+#ifdef _OPENMP
+  const bool threaded=estimator.isThreadSafe();
+#pragma omp parallel for schedule(static) if(threaded)
+#endif
   for (int islice=1; islice<=nprocSlice; ++islice) {
     for (int ipart=0; ipart<npart; ++ipart) {
       estimator.handleLink(beads1(ipart,islice-1), beads1(ipart,islice),
                            ipart, islice+ifirst, *this);
     }
   }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if(threaded)
+#endif
   for (int islice=1; islice<=nprocSlice; ++islice) {
     for (int ipart=0; ipart<npart; ++ipart) {
       estimator.handleLink(beads2(ipart,islice-1), beads2(ipart,islice),
@@ -161,12 +168,7 @@ void DoubleParallelPaths::putBeads(int ifirstSlice, const Beads<NDIM>& inBeads,
   // Now permute the following beads.
   int jlastSlice=nsectionSlice+jfirstSlice;
   if (!inPermutation.isIdentity()){
-    for (int islice=jlastSlice; islice<nprocSlice+2; ++islice) {
-      // Swap paths.
-      VArray buffer(npart);
-      for (int i=0; i<npart; ++i) buffer(i)=beads(inPermutation[i],islice);
-      for (int i=0; i<npart; ++i) beads(i,islice)=buffer(i);
-    }
+    beads.permute(inPermutation,jlastSlice,nprocSlice+2);
     permutation.prepend(inPermutation);
     inversePermutation.setToInverse(permutation);
   }
@@ -235,13 +237,8 @@ void DoubleParallelPaths::shift(const int ishift) {
        sendbuf2,(ishift+2)*NDIM*npart,MPI::DOUBLE,idest,2,
        recvbuf2,(ishift+2)*NDIM*npart,MPI::DOUBLE,isrc,2);
   // Permute the ishift beads that we got from the next worker.
-  for (int islice=nprocSlice-ishift; islice<=nprocSlice+1; ++islice) {
-    VArray buffer(npart);
-    for (int i=0; i<npart; ++i) buffer(i)=buffer1(permutation1[i],islice);
-    for (int i=0; i<npart; ++i) buffer1(i,islice)=buffer(i);
-    for (int i=0; i<npart; ++i) buffer(i)=buffer2(permutation2[i],islice);
-    for (int i=0; i<npart; ++i) buffer2(i,islice)=buffer(i);
-  }
+  buffer1.permute(permutation1,nprocSlice-ishift,nprocSlice+2);
+  buffer2.permute(permutation2,nprocSlice-ishift,nprocSlice+2);
   // Shift the remaining beads that are in this worker.
   for (int j=0; j<nprocSlice-ishift; ++j) {
     for (int i=0; i<npart; ++i) {
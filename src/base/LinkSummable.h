@@ -19,5 +19,10 @@ public:
             int islice, const Paths&) = 0;
     virtual void endCalc(int nslice) {
     }
+    /// Return true if handleLink may be called from several OpenMP threads
+    /// at once, as long as each slice is handled by a single thread.
+    virtual bool isThreadSafe() const {
+        return false;
+    }
 };
 #endif
@@ -36,6 +36,10 @@ ParallelPaths::~ParallelPaths() {
 
 void ParallelPaths::sumOverLinks(LinkSummable& estimator) const {
   estimator.initCalc(nprocSlice,1+ifirst);
+#ifdef _OPENMP
+  const bool threaded=estimator.isThreadSafe();
+#pragma omp parallel for schedule(static) if(threaded)
+#endif
   for (int islice=1; islice<=nprocSlice; ++islice) {
     for (int ipart=0; ipart<npart; ++ipart) {
       estimator.handleLink(beads(ipart,islice-1), beads(ipart,islice),
@@ -123,14 +127,27 @@ void ParallelPaths::putBeads(int ifirstSlice, const Beads<NDIM>& inBeads,
     }
   }
   // Now permute the following beads.
-  int jlastSlice=jfirstSlice+nsectionSlice;
-  if (!inPermutation.isIdentity()){
-    for (int islice=jlastSlice; islice<nprocSlice+2; ++islice) {
-      // Swap paths.
-      VArray buffer(npart);
-      for (int i=0; i<npart; ++i) buffer(i)=beads(inPermutation[i],islice);
-      for (int i=0; i<npart; ++i) beads(i,islice)=buffer(i);
+  permuteFollowing(jfirstSlice+nsectionSlice, inPermutation);
+}
+
+void ParallelPaths::putMovedBeads(int ifirstSlice, const Beads<NDIM>& inBeads,
+         const Permutation& inPermutation, const IArray& moved) const {
+  // Only the moved particles differ from the stored beads.
+  int jfirstSlice=(ifirstSlice-ifirst+nslice)%nslice;
+  int nsectionSlice=inBeads.getNSlice();
+  for (int isectionSlice=0; isectionSlice<nsectionSlice; ++isectionSlice) {
+    int islice=isectionSlice+jfirstSlice;
+    for (int i=0; i<moved.size(); ++i) {
+      beads(moved(i),islice)=inBeads(moved(i),isectionSlice);
     }
+  }
+  permuteFollowing(jfirstSlice+nsectionSlice, inPermutation);
+}
+
+void ParallelPaths::permuteFollowing(int jlastSlice,
+                                     const Permutation& inPermutation) const {
+  if (!inPermutation.isIdentity()){
+    beads.permute(inPermutation,jlastSlice,nprocSlice+2);
     permutation.prepend(inPermutation);
     inversePermutation.setToInverse(permutation);
   }
@@ -176,11 +193,7 @@ void ParallelPaths::shift(const int ishift) {
        sendbuf,(ishift+2)*NDIM*npart,MPI::DOUBLE,idest,1,
        recvbuf,(ishift+2)*NDIM*npart,MPI::DOUBLE,isrc,1);
   // Permute the ishift beads that we got from the next worker.
-  for (int islice=nprocSlice-ishift; islice<nprocSlice+2; ++islice) {
-    VArray vbuffer(npart);
-    for (int i=0; i<npart; ++i) vbuffer(i)=buffer(permutation[i],islice);
-    for (int i=0; i<npart; ++i) buffer(i,islice)=vbuffer(i);
-  }
+  buffer.permute(permutation,nprocSlice-ishift,nprocSlice+2);
   // Shift the remaining beads that are in this worker.
   for (int j=0; j<nprocSlice-ishift; ++j) {
     for (int i=0; i<npart; ++i) {
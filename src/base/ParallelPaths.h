@@ -100,6 +100,9 @@ public:
   /// Put beads.
   virtual void putBeads(int ifirstSlice,
                         const Beads<NDIM>&, const Permutation&) const;
+  /// Put beads of only the moved particles.
+  virtual void putMovedBeads(int ifirstSlice, const Beads<NDIM>&,
+                             const Permutation&, const IArray& moved) const;
   virtual void putDoubleBeads(
                  int ifirstSlice1,Beads<NDIM>&, Permutation&,
                  int ifirstSlice2,Beads<NDIM>&, Permutation&) const;
@@ -118,6 +121,8 @@ public:
   virtual bool is() const {return true;}
   virtual void clearPermutation();
 private:
+  /// Permute the slices following a section.
+  void permuteFollowing(int jlastSlice, const Permutation&) const;
   /// Worker nubmer.
   const int iworker;
   /// Number of workers.
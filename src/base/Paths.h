@@ -45,6 +45,7 @@ public:
   /// Constants and typedefs.
   typedef blitz::TinyVector<double,NDIM> Vec;
   typedef blitz::Array<Vec,1> VArray;
+  typedef blitz::Array<int,1> IArray;
   /// Constructor.
   Paths(int npart, int nslice, double tau, const SuperCell& cell);
   /// Destructor.
@@ -86,6 +87,12 @@ public:
   /// Put beads.
   virtual void putBeads(int ifirstSlice,
                         const Beads<NDIM>&, const Permutation&) const=0;
+  /// Put beads of only the listed particles, then apply the permutation.
+  /// Particles not listed must be unchanged in the section beads.
+  virtual void putMovedBeads(int ifirstSlice, const Beads<NDIM>& beads,
+      const Permutation& p, const IArray& moved) const {
+    putBeads(ifirstSlice, beads, p);
+  }
   virtual void putDoubleBeads(
             int ifirstSlice1,Beads<NDIM>&, Permutation&,
             int ifirstSlice2,Beads<NDIM>&, Permutation&) const=0;
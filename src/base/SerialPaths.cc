@@ -35,7 +35,8 @@ SerialPaths::SerialPaths(int npart, int nslice, double tau,
     buffer1(*beadFactory.getNewBeads(npart,(nslice>1000)?1000:nslice)),
     buffer2(*beadFactory.getNewBeads(npart,(nslice>1000)?1000:nslice)),
     permutation(*new Permutation(npart)),
-    inversePermutation(*new Permutation(npart)) {
+    inversePermutation(*new Permutation(npart)),
+    scratchPermutation(*new Permutation(npart)) {
   std::cout << "Creating serial paths with " 
             << nslice << " slices." << std::endl;
 }
@@ -43,18 +44,21 @@ SerialPaths::SerialPaths(int npart, int nslice, double tau,
 SerialPaths::~SerialPaths() {
   delete &beads; delete &buffer1; delete &buffer2;
   delete &permutation; delete &inversePermutation;
+  delete &scratchPermutation;
 }
 
 void SerialPaths::sumOverLinks(LinkSummable& estimator) const {
   estimator.initCalc(nslice,0);
-  for (int ipart=0; ipart<npart; ++ipart) {
-    estimator.handleLink(beads(inversePermutation[ipart],nslice-1),
-                         beads(ipart,0), ipart, 0, *this);
-  }
-  for (int islice=1; islice<nslice; ++islice) {
+#ifdef _OPENMP
+  const bool threaded=estimator.isThreadSafe();
+#pragma omp parallel for schedule(static) if(threaded)
+#endif
+  for (int islice=0; islice<nslice; ++islice) {
     for (int ipart=0; ipart<npart; ++ipart) {
-      estimator.handleLink(beads(ipart,islice-1), beads(ipart,islice),
-                           ipart, islice, *this);
+      estimator.handleLink((islice==0)
+                             ? beads(inversePermutation[ipart],nslice-1)
+                             : beads(ipart,islice-1),
+                           beads(ipart,islice), ipart, islice, *this);
     }
   }
 // Code to print out slices
@@ -164,21 +168,41 @@ void SerialPaths::putBeads(int ifirstSlice, const Beads<NDIM>& inBeads,
     }
   }
   // Now permute the following beads.
+  permuteFollowing(ifirstSlice+nsectionSlice, inPermutation);
+}
+
+void SerialPaths::putMovedBeads(int ifirstSlice, const Beads<NDIM>& inBeads,
+         const Permutation& inPermutation, const IArray& moved) const {
+  // Only the moved particles differ from the stored beads.
+  int nsectionSlice=inBeads.getNSlice();
+  if (permutedMoved.size()!=moved.size()) permutedMoved.resize(moved.size());
+  for (int i=0; i<moved.size(); ++i) permutedMoved(i)=permutation[moved(i)];
+  for (int isectionSlice=0; isectionSlice<nsectionSlice; ++isectionSlice) {
+    int islice=isectionSlice+ifirstSlice;
+    if (islice<0) {
+      // Do nothing, since this slice should not have been moved. 
+    } else if (islice<nslice) {
+      inBeads.copySlice(moved,isectionSlice,beads,moved,islice);
+    } else {
+      inBeads.copySlice(moved,isectionSlice,beads,permutedMoved,
+                        islice%nslice);
+    }
+  }
+  permuteFollowing(ifirstSlice+nsectionSlice, inPermutation);
+}
+
+void SerialPaths::permuteFollowing(int ifollowing,
+                                   const Permutation& inPermutation) const {
   if (!inPermutation.isIdentity()) {
-  int ifollowing=ifirstSlice+nsectionSlice;
-  Permutation temp(inPermutation);
+  Permutation& temp(scratchPermutation);
+  temp=inPermutation;
   if (ifollowing>nslice) {
     ifollowing-=nslice;
     temp.prepend(inversePermutation);
     temp.append(permutation);
   }
 //BUG with aux beads!!!!
-  for (int islice=ifollowing; islice<nslice; ++islice) {
-    // Swap paths.
-    VArray buffer(npart);
-    for (int i=0; i<npart; ++i) buffer(i)=beads(temp[i],islice);
-    for (int i=0; i<npart; ++i) beads(i,islice)=buffer(i);
-  }
+  beads.permute(temp,ifollowing,nslice);
   permutation.prepend(temp);
   inversePermutation.setToInverse(permutation);
   }
@@ -60,6 +60,9 @@ public:
   /// Put beads.
   virtual void putBeads(int ifirstSlice,
                         const Beads<NDIM>&, const Permutation&) const;
+  /// Put beads of only the moved particles.
+  virtual void putMovedBeads(int ifirstSlice, const Beads<NDIM>&,
+                             const Permutation&, const IArray& moved) const;
   virtual void putDoubleBeads(
                  int ifirstSlice1,Beads<NDIM>&, Permutation&,
                  int ifirstSlice2,Beads<NDIM>&, Permutation&) const;
@@ -78,6 +81,8 @@ public:
 private:
   void putBeads(int ifirstSlice, const Beads<NDIM>&, const Permutation&, 
                 int ifirst, int nbslice) const;
+  /// Permute the slices following a section.
+  void permuteFollowing(int ifollowing, const Permutation&) const;
   /// Storage for the beads.
   Beads<NDIM>& beads;
   /// Storage shifting uffers.
@@ -86,5 +91,9 @@ private:
   Permutation& permutation;
   /// Storage for the inverse permutation.
   Permutation& inversePermutation;
+  /// Scratch permutation for permuteFollowing.
+  Permutation& scratchPermutation;
+  /// Moved particles after the permutation, kept between calls.
+  mutable IArray permutedMoved;
 };
 #endif
@@ -5,7 +5,7 @@
 #include "EMARateAction.h"
 #include "advancer/DisplaceMoveSampler.h"
 #include "advancer/SectionSamplerInterface.h"
-#include "action/coulomb/CoulombLinkAction.h"
+#include "action/coulomb/CoulombLinkTable.h"
 #include "base/Beads.h"
 #include "base/Paths.h"
 #include "base/SimulationInfo.h"
@@ -40,7 +40,6 @@ EMARateAction::EMARateAction(const SimulationInfo& simInfo,
 }
 
 EMARateAction::~EMARateAction() {
-    delete coulomb;
 }
 
 void EMARateAction::includeCoulombContribution(double epsilon, int norder) {
@@ -48,7 +47,7 @@ void EMARateAction::includeCoulombContribution(double epsilon, int norder) {
     double q1q2 = -1.0;
     double mu = 1.0 / (1.0 / species1->mass + 1.0 / species2->mass);
     double deltaTau = 1.0 / invTau;
-    coulomb = new CoulombLinkAction(q1q2, epsilon, mu, deltaTau, norder);
+    coulomb = CoulombLinkTable::getTable(q1q2, epsilon, mu, deltaTau, norder);
 }
 
 EMARateAction::Vec EMARateAction::getMovingPosition(
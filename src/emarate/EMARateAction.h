@@ -13,7 +13,7 @@ class DisplaceMoveSampler;
 class Paths;
 class SimulationInfo;
 class Species;
-class CoulombLinkAction;
+class CoulombLinkTable;
 
 /** Class to modify the action to allow for electron-hole recombination.
  * To sample recombination rates, we work with a larger ensemble that
@@ -67,7 +67,7 @@ private:
     /// The total number of slices in the path.
     const int nPathSlice;
     bool hasCoulomb;
-    CoulombLinkAction *coulomb;
+    const CoulombLinkTable *coulomb;
     EMARateAction::Vec getMovingPosition(int npart, int nslice, int nMoving,
             const IArray &index,
             const Beads<NDIM> &sectionBeads,
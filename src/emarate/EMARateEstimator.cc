@@ -2,7 +2,7 @@
 #include <config.h>
 #endif
 #include "EMARateEstimator.h"
-#include "action/coulomb/CoulombLinkAction.h"
+#include "action/coulomb/CoulombLinkTable.h"
 #include "base/SimulationInfo.h"
 #include "base/Species.h"
 #include "base/Paths.h"
@@ -38,14 +38,13 @@ EMARateEstimator::EMARateEstimator(const SimulationInfo& simInfo,
 }
 
 EMARateEstimator::~EMARateEstimator() {
-    delete coulomb;
 }
 
 void EMARateEstimator::includeCoulombContribution(double epsilon, int norder) {
     hasCoulomb = true;
     double q1q2 = -1.0;
     double mu = 1.0 / (1.0 / (species1->mass) + 1.0 / (species2->mass));
-    coulomb = new CoulombLinkAction(q1q2, epsilon, mu, dtau, norder);
+    coulomb = CoulombLinkTable::getTable(q1q2, epsilon, mu, dtau, norder);
 
 }
 
@@ -25,7 +25,8 @@ EMARateMover::EMARateMover(double tau,
     lambda2(0.5 / species2->mass),
     C(C),
     index1(species1->ifirst),
-    index2(species2->ifirst) {
+    index2(species2->ifirst),
+    gaussRand(2) {
     index(0) = index1;
     index(1) = index2;
     if (species1->anMass) {
@@ -224,7 +225,6 @@ void EMARateMover::makeGaussianRandomNumbers(blitz::Array<Vec,1> & gaussRand) {
 void EMARateMover::sampleRadiating(int nStride, int nSlice,
         Beads<NDIM> &movingBeads) {
     for (int iSlice = nStride; iSlice < nSlice; iSlice += 2 * nStride) {
-        blitz::Array<Vec,1> gaussRand(2);
         Vec mass1 = 0.5 / lambda1;
         Vec mass2 = 0.5 / lambda2;
         Vec prev1 = (iSlice - nStride <= nSlice / 2)
@@ -281,7 +281,6 @@ void EMARateMover::sampleRadiating(int nStride, int nSlice,
 void EMARateMover::sampleDiagonal(int nStride, int nSlice,
         Beads<NDIM> &movingBeads, const SuperCell & cell) {
     for (int iSlice = nStride; iSlice < nSlice; iSlice += 2 * nStride) {
-        blitz::Array<Vec,1> gaussRand(2);
         makeGaussianRandomNumbers(gaussRand);
         for(int iMoving = 0;iMoving < 2;++iMoving){
             Vec lambda = (iMoving == 0) ? lambda1 : lambda2;
@@ -56,6 +56,7 @@ private:
     const double C;
     const int index1;
     const int index2;
+    blitz::Array<Vec,1> gaussRand;
 
 protected:
     virtual double getRandomNumber() const;
@@ -2,7 +2,7 @@
 #include <config.h>
 #endif
 #include "EMARateWeight.h"
-#include "action/coulomb/CoulombLinkAction.h"
+#include "action/coulomb/CoulombLinkTable.h"
 #include "base/SimulationInfo.h"
 #include "base/Species.h"
 #include "base/Paths.h"
@@ -37,14 +37,13 @@ EMARateWeight::EMARateWeight(const SimulationInfo& simInfo,
 }
 
 EMARateWeight::~EMARateWeight() {
-    delete coulomb;
 }
 
 void EMARateWeight::includeCoulombContribution(double epsilon, int norder) {
     hasCoulomb = true;
     double q1q2 = -1.0;
     double mu = 1.0 / (1.0 / (species1->mass) + 1.0 / (species2->mass));
-    coulomb = new CoulombLinkAction(q1q2, epsilon, mu, dtau, norder);
+    coulomb = CoulombLinkTable::getTable(q1q2, epsilon, mu, dtau, norder);
 }
 
 
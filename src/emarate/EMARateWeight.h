@@ -10,7 +10,7 @@ class Paths;
 class SimulationInfo;
 class SuperCell;
 class Species;
-class CoulombLinkAction;
+class CoulombLinkTable;
 
 class EMARateWeight : public PartitionWeight {
 public:
@@ -34,7 +34,7 @@ private:
     double actionDifference;
     double sum, norm;
     bool hasCoulomb;
-    CoulombLinkAction* coulomb;
+    const CoulombLinkTable *coulomb;
     const Species* species1;
     const Species* species2;
     const int index1;
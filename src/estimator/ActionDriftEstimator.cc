@@ -0,0 +1,48 @@
+#include "config.h"
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+#include "ActionDriftEstimator.h"
+#include "action/CompositeAction.h"
+#include "stats/MPIManager.h"
+#include "stats/ScalarAccumulator.h"
+#include <cmath>
+
+ActionDriftEstimator::ActionDriftEstimator(const CompositeAction* action,
+        MPIManager* mpi, ScalarAccumulator *accumulator)
+:   ScalarEstimator("action_drift", "scalar-action/action-drift", "",
+            1.0, 0.0),
+    action(action),
+    mpi(mpi) {
+    this->accumulator = accumulator;
+}
+
+ActionDriftEstimator::~ActionDriftEstimator() {
+}
+
+double ActionDriftEstimator::calcValue() {
+    return 0.0;
+}
+
+void ActionDriftEstimator::reset() {
+    accumulator->reset();
+}
+
+void ActionDriftEstimator::evaluate(const Paths& paths) {
+    action->syncRunningTotals(paths, drift);
+#ifdef ENABLE_MPI
+    // Workers trade slices, so only the summed drift is meaningful.
+    if (mpi && !drift.empty()) {
+        buffer = drift;
+        mpi->getWorkerComm().Allreduce(&buffer[0], &drift[0], drift.size(),
+                MPI::DOUBLE, MPI::SUM);
+    }
+#endif
+    double value = 0.0;
+    for (unsigned int i = 0; i < drift.size(); ++i) {
+        value += fabs(drift[i]);
+    }
+    accumulator->clearValue();
+    accumulator->addToValue(value);
+    accumulator->storeValue(1);
+}
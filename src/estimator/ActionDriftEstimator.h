@@ -0,0 +1,32 @@
+#ifndef __ActionDriftEstimator_h_
+#define __ActionDriftEstimator_h_
+#include "stats/ScalarEstimator.h"
+#include <vector>
+class Paths;
+class CompositeAction;
+class MPIManager;
+class ScalarAccumulator;
+/** Floating point drift of the running action totals.
+ *  Each evaluation recomputes the total of every action that has
+ *  one and restarts its running total from it. The value is the sum
+ *  over actions of the magnitude of the running total minus the
+ *  recomputed total, so a nonzero value means accepted differences
+ *  did not add up to the change in the action. With ActionChoice, a
+ *  model switch changes the action without an accepted move, and that
+ *  change shows up here as drift, so the value is not meaningful. */
+class ActionDriftEstimator: public ScalarEstimator {
+public:
+    ActionDriftEstimator(const CompositeAction* action, MPIManager* mpi,
+            ScalarAccumulator*);
+    virtual ~ActionDriftEstimator();
+    virtual double calcValue();
+    virtual void reset();
+    virtual void evaluate(const Paths& paths);
+private:
+    const CompositeAction* action;
+    MPIManager* mpi;
+    std::vector<double> drift;
+    std::vector<double> buffer;
+};
+
+#endif
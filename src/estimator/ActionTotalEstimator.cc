@@ -0,0 +1,49 @@
+#include "config.h"
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+#include "ActionTotalEstimator.h"
+#include "action/CompositeAction.h"
+#include "stats/MPIManager.h"
+#include "stats/ScalarAccumulator.h"
+#include <vector>
+
+ActionTotalEstimator::ActionTotalEstimator(const std::string& name,
+        const CompositeAction* action, int icomponent, MPIManager* mpi,
+        ScalarAccumulator *accumulator)
+:   ScalarEstimator(name, "scalar-action/total-action", "", 1.0, 0.0),
+    action(action),
+    icomponent(icomponent),
+    mpi(mpi) {
+    this->accumulator = accumulator;
+}
+
+ActionTotalEstimator::~ActionTotalEstimator() {
+}
+
+double ActionTotalEstimator::calcValue() {
+    return 0.0;
+}
+
+void ActionTotalEstimator::reset() {
+    accumulator->reset();
+}
+
+void ActionTotalEstimator::evaluate(const Paths& paths) {
+    const std::vector<double>& total = action->getRunningTotals();
+    double value = 0.0;
+    for (unsigned int i = 0; i < total.size(); ++i) {
+        if (icomponent < 0 || (int)i == icomponent) value += total[i];
+    }
+#ifdef ENABLE_MPI
+    if (mpi) {
+        double buffer = value;
+        mpi->getWorkerComm().Allreduce(&buffer, &value, 1, MPI::DOUBLE,
+                MPI::SUM);
+    }
+#endif
+    // Every worker holds the sum, so the accumulator average is the sum.
+    accumulator->clearValue();
+    accumulator->addToValue(value);
+    accumulator->storeValue(1);
+}
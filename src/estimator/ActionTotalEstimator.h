@@ -0,0 +1,33 @@
+#ifndef __ActionTotalEstimator_h_
+#define __ActionTotalEstimator_h_
+#include "stats/ScalarEstimator.h"
+#include <string>
+class Paths;
+class CompositeAction;
+class MPIManager;
+class ScalarAccumulator;
+/** Running total of the path action.
+ *  CompositeAction sums the accepted action differences of each of its
+ *  actions, so the total action is known without recomputing it. This
+ *  estimator reports the running total of one action, or the sum over
+ *  all of them, summed over the workers. Actions without a total action
+ *  start their running total at zero, so only changes in them are
+ *  meaningful. Path replicas (nreplica>1) share one action, so the
+ *  parser rejects this estimator for them. */
+class ActionTotalEstimator: public ScalarEstimator {
+public:
+    /// Report action icomponent, or the sum of all actions if negative.
+    ActionTotalEstimator(const std::string& name,
+            const CompositeAction* action, int icomponent,
+            MPIManager* mpi, ScalarAccumulator*);
+    virtual ~ActionTotalEstimator();
+    virtual double calcValue();
+    virtual void reset();
+    virtual void evaluate(const Paths& paths);
+private:
+    const CompositeAction* action;
+    const int icomponent;
+    MPIManager* mpi;
+};
+
+#endif
@@ -16,13 +16,14 @@
 DensityEstimator::DensityEstimator(const SimulationInfo& simInfo,
     const std::string& name, const Species *spec,
     const Vec &min, const Vec &max, const IVec &nbin,
-    const DistArray &dist, MPIManager *mpi) 
-  : BlitzArrayBlkdEst<NDIM>(name,"array/density",nbin,false),
+    const DistArray &dist, MPIManager *mpi, bool sparse) 
+  : BlitzArrayBlkdEst<NDIM>(name,"array/density",nbin,false,sparse),
     min(min), deltaInv(nbin/(max-min)), nbin(nbin), dist(dist),
-    ifirst(spec->ifirst), npart(spec->count), temp(nbin),
+    ifirst(spec->ifirst), npart(spec->count), temp(sparse?nbin*0:nbin),
+    sparseTemp(sparse?new TiledArrayN(nbin):0),
     cell(*simInfo.getSuperCell()),
 #ifdef ENABLE_MPI
-    mpiBuffer(nbin),
+    mpiBuffer(sparse?nbin*0:nbin),
 #endif 
     mpi(mpi) {
   scale=new Vec((max-min)/nbin);
@@ -35,11 +36,18 @@ DensityEstimator::~DensityEstimator() {
   for (int i=0; i<NDIM; ++i) delete dist[i];
   delete scale;
   delete origin;
+  delete sparseTemp;
 }
 
 void DensityEstimator::initCalc(const int nslice,
     const int firstSlice) {
+  if (sparseTemp) {
+    sparseTemp->zero();
+    sparseShards.init(*sparseTemp,nbin);
+    return;
+  }
   temp=0.;
+  shards.init(temp);
 }
 
 
@@ -52,7 +60,9 @@ void DensityEstimator::handleLink(const Vec& start, const Vec& end,
       double d=(*dist[i])(r);
       ibin[i]=int(floor((d-min[i])*deltaInv[i]));
       if (ibin[i]<0 || ibin[i]>=nbin[i]) break;
-      if (i==NDIM-1) ++temp(ibin);
+      if (i==NDIM-1) {
+        if (sparseTemp) ++sparseShards.get()(ibin); else ++shards.get()(ibin);
+      }
     }
   }
 }
@@ -60,8 +70,25 @@ void DensityEstimator::handleLink(const Vec& start, const Vec& end,
 
 void DensityEstimator::endCalc(const int lnslice) {
   int nslice = lnslice;
-  // First move all data to 1st worker. 
   int workerID=(mpi)?mpi->getWorkerID():0;
+  if (sparseTemp) {
+    sparseShards.reduce();
+#ifdef ENABLE_MPI
+    if (mpi) {
+      int ibuffer;
+      reduceTiles(*sparseTemp,mpi->getWorkerComm());
+      mpi->getWorkerComm().Reduce(&lnslice,&ibuffer,1,MPI::INT,MPI::SUM,0);
+      nslice = ibuffer;
+    }
+#endif
+    if (workerID==0) {
+      sparseValue->add(*sparseTemp,1./nslice);
+      norm+=1.;
+    }
+    return;
+  }
+  shards.reduce();
+  // First move all data to 1st worker. 
 #ifdef ENABLE_MPI
   if (mpi) {
     int ibuffer;
@@ -12,7 +12,9 @@
 #include "base/Species.h"
 #include "stats/BlitzArrayBlkdEst.h"
 #include "stats/MPIManager.h"
+#include "util/HistogramShards.h"
 #include "util/SuperCell.h"
+#include "util/TiledArray.h"
 #include <cstdlib>
 #include <blitz/array.h>
 #include <blitz/tinyvec-et.h>
@@ -28,10 +30,11 @@ public:
   typedef blitz::TinyVector<int, NDIM> IVec;
   typedef std::vector<Distance*> DistArray;
 
-  /// Constructor.
+  /// Constructor, with tiled sparse storage if sparse is true.
   DensityEstimator(const SimulationInfo& simInfo, const std::string& name,
       const Species *s, const Vec &min, const Vec &max,
-      const IVec &nbin, const DistArray &dist, MPIManager *mpi); 
+      const IVec &nbin, const DistArray &dist, MPIManager *mpi,
+      bool sparse=false); 
 
   /// Virtual destructor.
   virtual ~DensityEstimator();
@@ -45,6 +48,9 @@ public:
   
   /// Finalize the calculation.
   virtual void endCalc(const int nslice);
+
+  /// Links are binned into per-thread shards.
+  virtual bool isThreadSafe() const {return true;}
   
   /// Clear value of estimator.
   virtual void reset();
@@ -59,6 +65,10 @@ protected:
   const DistArray dist;
   int ifirst, npart;
   ArrayN temp;
+  HistogramShards<float,NDIM> shards;
+  /// Sparse histogram for this pass, or null for dense storage.
+  TiledArrayN *sparseTemp;
+  TiledArrayShards<float,NDIM> sparseShards;
 private:
   SuperCell cell;
 #ifdef ENABLE_MPI
@@ -53,12 +53,14 @@ DynamicPCFEstimator::~DynamicPCFEstimator() {
 void DynamicPCFEstimator::initCalc(const int nslice,
     const int firstSlice) {
   temp=0;
+  shards.init(temp);
 }
 
 
 void DynamicPCFEstimator::handleLink(const Vec& start, const Vec& end,
     const int ipart, const int islice, const Paths &paths) {
   if (ipart>=ifirst && ipart<ifirst+nipart) {
+    blitz::Array<Complex,2>& hist(shards.get());
     Vec r1=start;
     for (int jpart=jfirst; jpart<(jfirst+njpart); ++jpart) {
       if (ipart!=jpart) {
@@ -66,7 +68,7 @@ void DynamicPCFEstimator::handleLink(const Vec& start, const Vec& end,
         int ibin = 0;
         double d = (*dist)(r1,r2,cell);
         ibin = int(floor((d-min)*deltaInv));
-        if (ibin>=0 && ibin<nbin) temp(ibin,islice/nstride) += 1.0;
+        if (ibin>=0 && ibin<nbin) hist(ibin,islice/nstride) += 1.0;
       }
     }
   }
@@ -74,6 +76,7 @@ void DynamicPCFEstimator::handleLink(const Vec& start, const Vec& end,
 
 
 void DynamicPCFEstimator::endCalc(const int nslice) {
+  shards.reduce();
   temp/=nstride;
   // First move all data to 1st worker. 
   int workerID=(mpi)?mpi->getWorkerID():0;
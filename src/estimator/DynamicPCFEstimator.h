@@ -14,6 +14,7 @@
 #include "base/Species.h"
 #include "stats/BlitzArrayBlkdEst.h"
 #include "stats/MPIManager.h"
+#include "util/HistogramShards.h"
 #include "util/SuperCell.h"
 #include <cstdlib>
 #include <blitz/array.h>
@@ -51,6 +52,9 @@ public:
   
   /// Finalize the calculation.
   virtual void endCalc(const int nslice);
+
+  /// Links are binned into per-thread shards.
+  virtual bool isThreadSafe() const {return true;}
   
   /// Clear value of estimator.
   virtual void reset();
@@ -67,6 +71,7 @@ private:
   SuperCell cell;
   const double tau;
   blitz::Array<Complex,2> temp;
+  HistogramShards<Complex,2> shards;
   int ifirst,jfirst,nipart,njpart;
   fftw_plan fwd;
   MPIManager *mpi;
@@ -12,8 +12,10 @@
 #include "base/Species.h"
 #include "stats/BlitzArrayBlkdEst.h"
 #include "stats/MPIManager.h"
+#include "util/HistogramShards.h"
 #include "util/SuperCell.h"
 #include "util/PairDistance.h"
+#include "util/TiledArray.h"
 #include <cstdlib>
 #include <blitz/array.h>
 #include <blitz/tinyvec-et.h>
@@ -31,14 +33,16 @@ public:
   typedef blitz::TinyVector<double,N> VecN;
   typedef blitz::TinyVector<int,N> IVecN;
   typedef std::vector<PairDistance*> DistN;
-  /// Constructor.
+  typedef typename BlitzArrayBlkdEst<N>::TiledArrayN TiledArrayN;
+  /// Constructor, with tiled sparse storage if sparse is true.
   PairCFEstimator(const SimulationInfo& simInfo, const std::string& name,
                   const Species *speciesList, const int nspecies, const VecN &min, 
                   const VecN &max, const IVecN &nbin, const DistN &dist,
-                  MPIManager *mpi) 
-    : BlitzArrayBlkdEst<N>(name,"array/pair-correlation",nbin,true), 
+                  MPIManager *mpi, bool sparse=false) 
+    : BlitzArrayBlkdEst<N>(name,"array/pair-correlation",nbin,true,sparse), 
     min(min), deltaInv(nbin/(max-min)), nbin(nbin), dist(dist), nspecies(nspecies), 
-      cell(*simInfo.getSuperCell()), temp(nbin), mpi(mpi) {
+      cell(*simInfo.getSuperCell()), temp(sparse?nbin*0:nbin),
+      sparseTemp(sparse?new TiledArrayN(nbin):0), mpi(mpi) {
 
 		BlitzArrayBlkdEst<N>::max = new VecN(max);
 		BlitzArrayBlkdEst<N>::min = new VecN(min);
@@ -57,21 +61,31 @@ public:
 
     BlitzArrayBlkdEst<N>::norm=0;
 #ifdef ENABLE_MPI
-    if (mpi) mpiBuffer.resize(nbin);
+    if (mpi && !sparse) mpiBuffer.resize(nbin);
 #endif
   }
   /// Virtual destructor.
   virtual ~PairCFEstimator() {
     for (int i=0; i<N; ++i) delete dist[i];
+    delete sparseTemp;
   }
   /// Initialize the calculation.
   virtual void initCalc(const int nslice, const int firstSlice) {
+    if (sparseTemp) {
+      sparseTemp->zero();
+      sparseShards.init(*sparseTemp,nbin);
+      return;
+    }
     temp=0;
+    shards.init(temp);
   }
   /// Add contribution from a link.
   virtual void handleLink(const Vec& start, const Vec& end,
          const int ipart, const int islice, const Paths &paths) {
     if (ipart>=ifirst && ipart<ifirst+nipart) {
+      // Only the shards for the storage in use were set up by initCalc.
+      ArrayN* hist=sparseTemp?0:&shards.get();
+      TiledArrayN* sparseHist=sparseTemp?&sparseShards.get():0;
       for (int ispec=1; ispec<nspecies; ispec++){
 	for (int jpart=jfirst(ispec); jpart<(jfirst(ispec)+njpart(ispec)); ++jpart) {
 	 
@@ -82,7 +96,9 @@ public:
 	      double d=(*dist[i])(r1,r2,cell);
 	      ibin[i]=int((d-min[i])*deltaInv[i]);
 	      if (d<min[i] || ibin[i]>nbin[i]-1) break;
-	      if (i==N-1) ++temp(ibin);
+	      if (i==N-1) {
+	        if (sparseHist) ++(*sparseHist)(ibin); else ++(*hist)(ibin);
+	      }
 	    }
 	  }
 
@@ -93,8 +109,25 @@ public:
   /// Finalize the calculation.
   virtual void endCalc(const int lnslice) {
     int nslice=lnslice;
-    // First move all data to 1st worker. 
     int workerID=(mpi)?mpi->getWorkerID():0;
+    if (sparseTemp) {
+      sparseShards.reduce();
+#ifdef ENABLE_MPI
+      if (mpi) {
+        int ibuffer;
+        BlitzArrayBlkdEst<N>::reduceTiles(*sparseTemp,mpi->getWorkerComm());
+        mpi->getWorkerComm().Reduce(&lnslice,&ibuffer,1,MPI::INT,MPI::SUM,0);
+        nslice = ibuffer;
+      }
+#endif
+      if (workerID==0) {
+        BlitzArrayBlkdEst<N>::sparseValue->add(*sparseTemp,1./nslice);
+        BlitzArrayBlkdEst<N>::norm+=1;
+      }
+      return;
+    }
+    shards.reduce();
+    // First move all data to 1st worker. 
 #ifdef ENABLE_MPI
     if (mpi) {
       int ibuffer;
@@ -111,6 +144,8 @@ public:
       BlitzArrayBlkdEst<N>::norm+=1;
     }
   }
+  /// Links are binned into per-thread shards.
+  virtual bool isThreadSafe() const {return true;}
   /// Clear value of estimator.
   virtual void reset() {}
   /// Evaluate for Paths configuration.
@@ -123,6 +158,10 @@ private:
   const int nspecies;
   SuperCell cell;
   ArrayN temp;
+  HistogramShards<float,N> shards;
+  /// Sparse histogram for this pass, or null for dense storage.
+  TiledArrayN *sparseTemp;
+  TiledArrayShards<float,N> sparseShards;
   int ifirst, nipart;
   IArray jfirst,njpart;
   MPIManager *mpi;
@@ -54,7 +54,7 @@ public:
 	double d=(*dist[i])(r);
 	ibin[i]=int(floor((d-min[i])*deltaInv[i]));
 	if (ibin[i]<0 || ibin[i]>=nbin[i]) break;
-	if (i==NDIM-1) ++temp(ibin);
+	if (i==NDIM-1) ++shards.get()(ibin);
       }
     }
   }
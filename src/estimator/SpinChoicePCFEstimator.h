@@ -16,6 +16,7 @@
 #include "base/SpinModelState.h"
 #include "stats/BlitzArrayBlkdEst.h"
 #include "stats/MPIManager.h"
+#include "util/HistogramShards.h"
 #include "util/SuperCell.h"
 #include "util/PairDistance.h"
 #include <cstdlib>
@@ -69,12 +70,14 @@ public:
   /// Initialize the calculation.
   virtual void initCalc(const int nslice, const int firstSlice) {
     temp=0;
+    shards.init(temp);
   }
   /// Add contribution from a link.
   virtual void handleLink(const Vec& start, const Vec& end,
          const int ipart, const int islice, const Paths &paths) {
     if (spinState(ipart) != ispin) return;
     if (ipart>=ifirst && ipart<npart) {
+      ArrayN& hist(shards.get());
       int jpart = ifirst;
       while (jpart < npart) {
 	if (samespin)
@@ -89,7 +92,7 @@ public:
 	    double d=(*dist[i])(r1,r2,cell);
 	    ibin[i]=int((d-min[i])*deltaInv[i]);
 	    if (d<min[i] || ibin[i]>nbin[i]-1) break;
-	    if (i==N-1) ++temp(ibin);
+	    if (i==N-1) ++hist(ibin);
 	  }
 	}
 	++jpart;
@@ -99,6 +102,7 @@ public:
   /// Finalize the calculation.
   virtual void endCalc(const int lnslice) {
     int nslice=lnslice;
+    shards.reduce();
     // First move all data to 1st worker. 
     int workerID=(mpi)?mpi->getWorkerID():0;
 #ifdef ENABLE_MPI
@@ -117,6 +121,8 @@ public:
       BlitzArrayBlkdEst<N>::norm+=1;
     }
   }
+  /// Links are binned into per-thread shards.
+  virtual bool isThreadSafe() const {return true;}
   /// Clear value of estimator.
   virtual void reset() {}
   /// Evaluate for Paths configuration.
@@ -128,6 +134,7 @@ private:
   DistN dist;
   const SuperCell& cell;
   ArrayN temp;
+  HistogramShards<float,N> shards;
   int ifirst, npart;
   /// Reference spin.
   const int ispin;
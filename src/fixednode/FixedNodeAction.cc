@@ -8,6 +8,7 @@
 #include "base/Beads.h"
 #include "base/Paths.h"
 #include "base/SimulationInfo.h"
+#include "base/Species.h"
 #include "stats/MPIManager.h"
 #include "util/SuperCell.h"
 #include <cstdlib>
@@ -18,8 +19,11 @@ FixedNodeAction::FixedNodeAction(const SimulationInfo &simInfo,
   : tau(simInfo.getTau()), npart(simInfo.getNPart()),
     nSpeciesPart(species.count), ifirst(species.ifirst), 
     r1(npart), r2(npart),
-    dmValue((1 << maxlevel) + 1),
-    newDMValue((1 << maxlevel)  + 1),
+    logDMValue((1 << maxlevel) + 1), newLogDMValue((1 << maxlevel) + 1),
+    dmSign((1 << maxlevel) + 1), newDMSign((1 << maxlevel) + 1),
+    rBatch1((1 << maxlevel) + 1, npart), rBatch2((1 << maxlevel) + 1, npart),
+    batchSlice((1 << maxlevel) + 1), batchSign((1 << maxlevel) + 1),
+    batchLogDet((1 << maxlevel) + 1),
     dist((1 << maxlevel) + 1, 2, npart),
     newDist((1 << maxlevel) + 1, 2, npart), force(npart),
     gradd1(npart,npart), gradd2(npart,npart),
@@ -57,21 +61,36 @@ double FixedNodeAction::getActionDifference(const SectionSamplerInterface &sampl
   const int nSlice=sectionBeads1.getNSlice();
   const int nStride = 1 << (level+1);
   // First check for node crossing.
-  for (int islice=nStride/2; islice<nSlice; islice+=nStride) {
-    if (matrixUpdateObj) {
-      newDMValue(islice)=matrixUpdateObj->evaluateChange(sampler, islice)
-                        *dmValue(islice);
-    } else {
-      for (int i=0; i<npart; ++i) r1(i)=sectionBeads1(i,islice);
-      for (int i=0; i<nMoving; ++i) r1(index1(i))=movingBeads1(i,islice);
-      for (int i=0; i<npart; ++i) r2(i)=sectionBeads2(i,islice);
+  if (matrixUpdateObj) {
+    for (int islice=nStride/2; islice<nSlice; islice+=nStride) {
+      double ratio=matrixUpdateObj->evaluateChange(sampler, islice);
+      if (ratio*dmSign(islice)*dmSign(0)<=0) return deltaAction=2e100;
+      newLogDMValue(islice)=logDMValue(islice)+log(fabs(ratio));
+      newDMSign(islice)=dmSign(islice)*((ratio>0)?1:-1);
+    }
+  } else {
+    // Evaluate all slices on this level in one batch.
+    int nbatch=0;
+    for (int islice=nStride/2; islice<nSlice; islice+=nStride) {
+      for (int i=0; i<npart; ++i) rBatch1(nbatch,i)=sectionBeads1(i,islice);
+      for (int i=0; i<nMoving; ++i)
+                            rBatch1(nbatch,index1(i))=movingBeads1(i,islice);
+      for (int i=0; i<npart; ++i) rBatch2(nbatch,i)=sectionBeads2(i,islice);
       if (sampler.isSamplingBoth()) for (int i=0; i<nMoving; ++i)
-                                    r2(index2(i))=movingBeads2(i,islice);
-      NodeModel::DetWithFlag result= nodeModel->evaluate(r1,r2,islice,false);
-      if (result.err) return deltaAction=2e100;
-      newDMValue(islice)=result.det;
+                            rBatch2(nbatch,index2(i))=movingBeads2(i,islice);
+      batchSlice(nbatch++)=islice;
+    }
+    blitz::Range batch(0,nbatch-1);
+    blitz::Range allPart = blitz::Range::all();
+    Array logDet(batchLogDet(batch));
+    IArray sign(batchSign(batch));
+    nodeModel->evaluateLog(rBatch1(batch,allPart), rBatch2(batch,allPart),
+                           batchSlice(batch), logDet, sign, false);
+    for (int k=0; k<nbatch; ++k) {
+      if (sign(k)*dmSign(0)<=0) return deltaAction=2e100;
+      newLogDMValue(batchSlice(k))=logDet(k);
+      newDMSign(batchSlice(k))=sign(k);
     }
-    if (newDMValue(islice)*dmValue(0)<=1e-200) return deltaAction=2e100;
   } 
   // Calculate the nodal action if level=0;
   if (withNodalAction && level==0) {
@@ -334,12 +353,19 @@ void FixedNodeAction::initialize(const DoubleSectionChooser &chooser) {
   nslice=sectionBeads1.getNSlice();
   blitz::Range allPart = blitz::Range::all();
   blitz::Range both = blitz::Range::all();
+  // Evaluate all slices of the section in one batch.
+  for (int islice=0; islice<nslice; ++islice) {  
+    for (int i=0; i<npart; ++i) rBatch1(islice,i)=sectionBeads1(i,islice);
+    for (int i=0; i<npart; ++i) rBatch2(islice,i)=sectionBeads2(i,islice);
+    batchSlice(islice)=islice;
+  }
+  blitz::Range section(0,nslice-1);
+  Array logDet(logDMValue(section));
+  IArray sign(dmSign(section));
+  nodeModel->evaluateLog(rBatch1(section,allPart), rBatch2(section,allPart),
+                         batchSlice(section), logDet, sign, true);
   for (int islice=0; islice<nslice; ++islice) {  
-    for (int i=0; i<npart; ++i) r1(i)=sectionBeads1(i,islice);
-    for (int i=0; i<npart; ++i) r2(i)=sectionBeads2(i,islice);
-    NodeModel::DetWithFlag result = nodeModel->evaluate(r1,r2,islice,true);
-    dmValue(islice) = result.det;
-    if (result.err || dmValue(islice)*dmValue(0)<=1e-200) {
+    if (dmSign(islice)*dmSign(0)<=0) {
       int cloneID=(mpi)?mpi->getCloneID():0;
       std::cout << "ERROR - crossed node " << islice << " clone " << cloneID << std::endl;
       nerror++;
@@ -349,11 +375,13 @@ void FixedNodeAction::initialize(const DoubleSectionChooser &chooser) {
       }
     }
     if (withNodalAction) {
+      VArray rs1(rBatch1(islice,allPart)), rs2(rBatch2(islice,allPart));
       Array d1(dist(islice,0,allPart)), d2(dist(islice,1,allPart));
-      nodeModel->evaluateDistance(r1,r2,islice,d1,d2);
+      nodeModel->evaluateDistance(rs1,rs2,islice,d1,d2);
     }
   } 
-  newDMValue(0)=dmValue(0); newDist(0,both,allPart)=dist(0,both,allPart);
+  newLogDMValue(0)=logDMValue(0); newDMSign(0)=dmSign(0);
+  newDist(0,both,allPart)=dist(0,both,allPart);
 }
 
 void FixedNodeAction::acceptLastMove() {
@@ -361,7 +389,14 @@ void FixedNodeAction::acceptLastMove() {
   blitz::Range allPart = blitz::Range::all();
   blitz::Range both = blitz::Range::all();
   for (int i=0; i<nslice; ++i) {
-    dmValue(i)=newDMValue(i); dist(i,both,allPart)=newDist(i,both,allPart);
+    logDMValue(i)=newLogDMValue(i); dmSign(i)=newDMSign(i);
+    dist(i,both,allPart)=newDist(i,both,allPart);
   }
   if (matrixUpdateObj) matrixUpdateObj->acceptLastMove(nslice);
 }
+
+bool FixedNodeAction::dependsOnSpecies(const Species& species) const {
+  if (nodeModel->dependsOnOtherParticles()) return true;
+  return species.ifirst<ifirst+nSpeciesPart
+      && ifirst<species.ifirst+species.count;
+}
@@ -103,6 +103,9 @@ public:
   virtual void initialize(const DoubleSectionChooser&);
   /// Accept last move.
   virtual void acceptLastMove();
+  /// Only moves of this species change the action, unless the
+  /// node model depends on other particles.
+  virtual bool dependsOnSpecies(const Species&) const;
 protected:
   /// The time step.
   const double tau;
@@ -118,8 +121,14 @@ protected:
   mutable VArray r1,r2;
   /// Flag for checking if this species is being moved.
   bool notMySpecies;
-  /// Determinants.
-  mutable Array dmValue, newDMValue;
+  /// Log magnitudes of the determinants.
+  mutable Array logDMValue, newLogDMValue;
+  /// Signs of the determinants.
+  mutable IArray dmSign, newDMSign;
+  /// Storage for a batch of slices passed to NodeModel::evaluateLog.
+  mutable VMatrix rBatch1, rBatch2;
+  mutable IArray batchSlice, batchSign;
+  mutable Array batchLogDet;
   /// Distances to the nodes.
   mutable Array3 dist, newDist;
   /// Array to cache forces for getBeadAction.
@@ -30,7 +30,8 @@ FixedPhaseAction::FixedPhaseAction(const SimulationInfo &simInfo,
     newDMValue((1 << maxlevel) + 1),
     dist((1 << maxlevel) + 1),
     newDist((1 << (maxlevel + 1)) + 1),
-    force(npart), phaseModel(phaseModel) {
+    force(npart), phaseModel(phaseModel),
+    matrixUpdateObj(phaseModel->getUpdateObj()), noIndex(0) {
   for (unsigned int i=0; i<gradPhi1.size(); ++i) {
     gradPhi1[i].resize(npart);
     gradPhi2[i].resize(npart);
@@ -73,7 +74,12 @@ double FixedPhaseAction::getActionDifference(const SectionSamplerInterface &samp
     for (int i=0; i<npart; ++i) r2(i)=sectionBeads2(i,islice);
     if (sampler.isSamplingBoth()) for (int i=0; i<nMoving; ++i)
                                 r2(index2(i))=movingBeads2(i,islice);
-    phaseModel->evaluate(r1,r2,islice);
+    if (matrixUpdateObj) {
+      matrixUpdateObj->evaluateChange(r1,r2,index1,
+          sampler.isSamplingBoth()?index2:noIndex,islice);
+    } else {
+      phaseModel->evaluate(r1,r2,islice);
+    }
     newPhi(islice) = phaseModel->getPhi();
     newGradPhi1[islice] = phaseModel->getGradPhi(1);
     newGradPhi2[islice] = phaseModel->getGradPhi(2);
@@ -238,6 +244,7 @@ void FixedPhaseAction::acceptLastMove() {
     vecPot1[i]=newVecPot1[i];
     vecPot2[i]=newVecPot2[i];
   }
+  if (matrixUpdateObj) matrixUpdateObj->acceptLastMove(nslice);
 }
 
 const double FixedPhaseAction::PI = 3.14159265358979;
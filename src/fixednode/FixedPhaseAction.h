@@ -18,6 +18,7 @@
 #define __FixedPhaseAction_h_
 
 #include "action/DoubleAction.h"
+#include "PhaseModel.h"
 #include <cstdlib>
 #include <blitz/array.h>
 #include <blitz/tinymat.h>
@@ -25,7 +26,6 @@
 class SimulationInfo;
 class Paths;
 class Species;
-class PhaseModel;
 class DoubleDisplaceMoveSampler;
 /**  Class for fixed-phase action.
 In the fixed-phase approximation, the phase of a trial function
@@ -139,6 +139,10 @@ private:
   mutable VArray force;
   /// The PhaseModel.
   PhaseModel* phaseModel;
+  /// The phaseModel's MatrixUpdate object.
+  PhaseModel::MatrixUpdate* matrixUpdateObj;
+  /// Empty index for moves that leave r2 unchanged.
+  const IArray noIndex;
   /// Function for evaluating the cubic interpolated action.
   double action(const double phi0, const double phi1, 
                 const VArray& r1, const VArray& r2,
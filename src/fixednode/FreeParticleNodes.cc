@@ -10,8 +10,12 @@
 #include "util/Hungarian.h"
 #include "util/PeriodicGaussian.h"
 #include "util/SuperCell.h"
+#include "util/math/SmallLU.h"
 #include <cstdlib>
 #include <blitz/tinyvec-et.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define DGETRF_F77 F77_FUNC(dgetrf,DGETRF)
 extern "C" void DGETRF_F77(const int*, const int*, double*, const int*,
@@ -39,11 +43,17 @@ FreeParticleNodes::FreeParticleNodes(const SimulationInfo &simInfo,
     kindex((1 << maxlevel) + 1,npart), nerror(0),
     useHungarian(useHungarian), scale(1.0), useIterations(useIterations),
     nodalFactor(nodalFactor),
-    hungarian(useHungarian ? new Hungarian(npart) : 0) {
+    hungarian(useHungarian ? (1 << maxlevel) + 1 : 0) {
     for (unsigned int i=0; i<matrix.size(); ++i)  {
         matrix[i] = new Matrix(npart,npart,ColMajor());
         romatrix[i] = new Matrix(npart,npart,ColMajor());
     }
+    for (unsigned int i=0; i<hungarian.size(); ++i) {
+        hungarian[i] = new Hungarian(npart);
+    }
+    for (int islice=0; islice<kindex.shape()(0); ++islice)  {
+      for (int ipart=0; ipart<npart; ++ipart) kindex(islice,ipart)=ipart;
+    }
     std::cout << "FreeParticleNodes with temperature = "
             << temperature << std::endl;
     double tempp=temperature/(1.0+EPSILON); //Larger beta (plus).
@@ -66,7 +76,7 @@ FreeParticleNodes::~FreeParticleNodes() {
     delete pg[idim]; delete pgm[idim]; delete pgp[idim];
   }
   delete updateObj;
-  delete hungarian;
+  for (unsigned int i=0; i<hungarian.size(); ++i) delete hungarian[i];
 }
 
 NodeModel::DetWithFlag
@@ -75,41 +85,7 @@ FreeParticleNodes::evaluate(const VArray &r1, const VArray &r2,
   DetWithFlag result; result.err=false;
   do { // Loop if scale is wrong to avoid overflow/underflow.
     Matrix& mat(*matrix[islice]);
-    mat=0;
-    for(int jpart=0; jpart<npart; ++jpart) {
-      for(int ipart=0; ipart<npart; ++ipart) {
-        Vec delta(r1(jpart+ifirst)-r2(ipart+ifirst));
-        cell.pbc(delta);
-        double ear2=scale;
-        for (int i=0; i<NDIM; ++i) {
-            ear2 *= pg[i]->evaluate(delta[i]);
-        }
-        mat(ipart,jpart)=ear2;
-	(*romatrix[islice])(ipart,jpart)=ear2;
-      }
-    }
-    if (hasSpinModelState()) {
-      SpinModelState::IArray spin=(spinModelState->getSpinState());
-      for(int jpart=0; jpart<npart; ++jpart) {
-        for(int ipart=0; ipart<npart; ++ipart) {
-          if (spin(ipart) != spin(jpart)) mat(ipart,jpart) = 0.;
-        }
-      }
-    }
-    for(int jpart=0; jpart<npart; ++jpart) {
-      for(int ipart=0; ipart<npart; ++ipart) {
-        uarray(ipart,jpart)=-log(fabs(mat(ipart,jpart))+1e-100);
-      }
-    }
-    // Find dominant contribution to determinant (distroys uarray).
-    if (useHungarian) {
-        hungarian->solve(uarray.data());
-        for (int ipart=0; ipart<npart; ++ipart) {
-            kindex(islice,ipart) = (*hungarian)[ipart];
-        }
-      // Note: mat(ipart,jpart=kindex(islice,ipart)) makes maximum contribution
-      // or lowest total action.
-    }
+    fillMatrix(r1, r2, islice);
     // Next calculate determinant and inverse of slater matrix.
     int info=0;//LU decomposition
     DGETRF_F77(&npart,&npart,mat.data(),&npart,ipiv.data(),&info);
@@ -156,6 +132,102 @@ FreeParticleNodes::evaluate(const VArray &r1, const VArray &r2,
   return result;
 }
 
+void FreeParticleNodes::evaluateLog(const VMatrix &r1, const VMatrix &r2,
+    const IArray &islice, Array &logDet, IArray &sign, bool scaleMagnitude) {
+  // Log determinants cannot overflow, so scaleMagnitude is not needed.
+  const int nbatch = islice.size();
+  blitz::Range allPart = blitz::Range::all();
+  // Build all the slater matrices first, then factor them independently.
+  for (int k=0; k<nbatch; ++k) {
+    VArray r1k(r1(k,allPart)), r2k(r2(k,allPart));
+    fillMatrix(r1k, r2k, islice(k));
+  }
+  // Per-thread scratch only grows, so steady-state calls do not allocate.
+  int nthread=1;
+#ifdef _OPENMP
+  nthread=omp_get_max_threads();
+#endif
+  if ((int)batchPiv.size()<nthread*npart) {
+    batchPiv.resize(nthread*npart);
+    batchWork.resize(nthread*npart*npart);
+  }
+  int nbad=0;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    int ithread=0;
+#ifdef _OPENMP
+    ithread=omp_get_thread_num();
+#endif
+    int *piv=&batchPiv[ithread*npart];
+    double *lu=&batchWork[ithread*npart*npart];
+#ifdef _OPENMP
+#pragma omp for reduction(+:nbad)
+#endif
+    for (int k=0; k<nbatch; ++k) {
+      Matrix& mat(*matrix[islice(k)]);
+      int s=0;
+      logDet(k) = SmallLU::factor(mat.data(), npart, piv, s);
+      sign(k) = s;
+      if (s==0) {
+        ++nbad;
+      } else {
+        SmallLU::invert(mat.data(), npart, piv, lu);
+      }
+    }
+  }
+  if (nbad>0) {
+    std::cout << "SINGULAR SLATER MATRIX in " << nbad << " slices" << std::endl;
+    nerror+=nbad;
+    if (nerror>1000) {
+      std::cout << "too many errors!!!!" << std::endl;
+      std::exit(-1);
+    }
+  }
+}
+
+void FreeParticleNodes::fillMatrix(const VArray &r1, const VArray &r2,
+                                   const int islice) {
+  Matrix& mat(*matrix[islice]);
+  mat=0;
+  for(int jpart=0; jpart<npart; ++jpart) {
+    for(int ipart=0; ipart<npart; ++ipart) {
+      Vec delta(r1(jpart+ifirst)-r2(ipart+ifirst));
+      cell.pbc(delta);
+      double ear2=scale;
+      for (int i=0; i<NDIM; ++i) {
+          ear2 *= pg[i]->evaluate(delta[i]);
+      }
+      mat(ipart,jpart)=ear2;
+      (*romatrix[islice])(ipart,jpart)=ear2;
+    }
+  }
+  if (hasSpinModelState()) {
+    SpinModelState::IArray spin=(spinModelState->getSpinState());
+    for(int jpart=0; jpart<npart; ++jpart) {
+      for(int ipart=0; ipart<npart; ++ipart) {
+        if (spin(ipart) != spin(jpart)) mat(ipart,jpart) = 0.;
+      }
+    }
+  }
+  // Find dominant contribution to determinant, starting from the
+  // assignment and potentials for the last move of this slice.
+  if (useHungarian) {
+    for(int jpart=0; jpart<npart; ++jpart) {
+      for(int ipart=0; ipart<npart; ++ipart) {
+        uarray(ipart,jpart)=-log(fabs(mat(ipart,jpart))+1e-100);
+      }
+    }
+    hungarian[islice]->solve(uarray.data(),&kindex(islice,0));
+    for (int ipart=0; ipart<npart; ++ipart) {
+      kindex(islice,ipart) = (*hungarian[islice])[ipart];
+    }
+    // Note: mat(ipart,jpart=kindex(islice,ipart)) makes maximum contribution
+    // or lowest total action.
+  }
+}
+
 void FreeParticleNodes::evaluateDotDistance(const VArray &r1, const VArray &r2,
          const int islice, Array &d1, Array &d2) {
   std::vector<PeriodicGaussian*> pgSave(NDIM);
@@ -544,9 +616,9 @@ void FreeParticleNodes:: getDetInvMat( Matrix &invMat, double &det, IArray2 &loc
         uarray(ipart,jpart)=-log(fabs(invMat(ipart,jpart))+1e-100);
       }
     }
-    hungarian->solve(uarray.data());
+    hungarian[islice]->solve(uarray.data(),&localKindex(islice,0));
     for (int ipart=0; ipart<npart; ++ipart) {
-        localKindex(islice,ipart) = (*hungarian)[ipart];
+        localKindex(islice,ipart) = (*hungarian[islice])[ipart];
     }
   }
   
@@ -107,6 +107,11 @@ public:
   /// Evaluate the density matrix function, returning the value.
   virtual DetWithFlag evaluate(const VArray &r1, const VArray &r2, 
                           const int islice, bool scaleMagnitude);
+  /// Evaluate log determinants for a batch of slices.
+  /// The matrices are built in one pass, then factored in parallel.
+  virtual void evaluateLog(const VMatrix &r1, const VMatrix &r2,
+                           const IArray &islice, Array &logDet, IArray &sign,
+                           bool scaleMagnitude);
   /// Evaluate distance to the node in units of @f$ \sqrt{\tau/2m}@f$.
   /// Assumes that evaluate has already been called on the slice.
   virtual void evaluateDistance(const VArray &r1, const VArray &r2,
@@ -134,6 +139,8 @@ public:
            const int islice, VMatrix &gradd1, VMatrix &gradd2,
                              const Array &d1, const Array &d2);
 private:
+  /// Fill the slater matrix for a slice (and find the dominant term).
+  void fillMatrix(const VArray &r1, const VArray &r2, const int islice);
   const int maxlevel;
   /// The time step.
   double tau;
@@ -155,6 +162,9 @@ private:
   mutable IArray ipiv;
   const int lwork;
   mutable Array work;
+  /// Per-thread pivots and work space for evaluateLog.
+  std::vector<int> batchPiv;
+  std::vector<double> batchWork;
   /// The SuperCell.
   SuperCell& cell;
   /// A periodic gaussian.
@@ -181,6 +191,8 @@ private:
   double scale;
   const int useIterations;
   const double nodalFactor;
-  Hungarian *hungarian;
+  /// Assignment solver for each slice, so that each one starts from the
+  /// potentials of its own slice on the previous move.
+  std::vector<Hungarian*> hungarian;
 };
 #endif
@@ -15,6 +15,7 @@
     along with this program; if not, write to the Free Software
     Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.  */
 #include "NodeModel.h"
+#include <cmath>
 
 NodeModel::NodeModel(const std::string& name) :
 #ifdef NODE_DIST_DEBUG
@@ -23,6 +24,22 @@ NodeModel::NodeModel(const std::string& name) :
    updateObj(0), spinModelState(0) {
 }
 
+void NodeModel::evaluateLog(const VMatrix &r1, const VMatrix &r2,
+  const IArray &islice, Array &logDet, IArray &sign, bool scaleMagnitude) {
+  blitz::Range allPart = blitz::Range::all();
+  for (int k=0; k<islice.size(); ++k) {
+    VArray r1k(r1(k,allPart)), r2k(r2(k,allPart));
+    DetWithFlag result = evaluate(r1k, r2k, islice(k), scaleMagnitude);
+    if (result.err || result.det==0.) {
+      sign(k) = 0;
+      logDet(k) = 0.;
+    } else {
+      sign(k) = (result.det>0.) ? 1 : -1;
+      logDet(k) = log(fabs(result.det));
+    }
+  }
+}
+
 void NodeModel::testGradLogDist( const VArray &r1, const VArray &r2,
   const int islice, VMatrix &gradd1, VMatrix &gradd2,
   const Array &d1, const Array &d2, const int npart, const int ifirst) {
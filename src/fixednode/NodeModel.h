@@ -35,6 +35,7 @@ public:
   typedef blitz::Array<double,1> Array;
   typedef blitz::Array<Vec,1> VArray;
   typedef blitz::Array<Vec,2> VMatrix;
+  typedef blitz::Array<int,1> IArray;
   struct DetWithFlag {
     double det;
     bool err;
@@ -86,6 +87,13 @@ public:
   /// Evaluate the density matrix function, returning the value.
   virtual DetWithFlag evaluate(const VArray &r1, const VArray &r2, 
                                const int islice, bool scaleMagnitude)=0;
+  /// Evaluate the density matrix function on several slices at once.
+  /// Row k of r1 and r2 holds the coordinates for slice islice(k).
+  /// Returns log|rho| in logDet and its sign in sign, with sign zero
+  /// on error. The default calls evaluate for each slice.
+  virtual void evaluateLog(const VMatrix &r1, const VMatrix &r2,
+                           const IArray &islice, Array &logDet, IArray &sign,
+                           bool scaleMagnitude);
   /// Evaluate distance to the node in units of @f$ \sqrt{\tau/2m}@f$.
   /// Assumes that evaluate has already been called on the slice.
   virtual void evaluateDistance(const VArray &r1, const VArray &r2,
@@ -39,9 +39,26 @@ class PhaseModel {
 public:
   typedef blitz::TinyVector<double,NDIM> Vec;
   typedef blitz::Array<Vec,1> VArray;
+  typedef blitz::Array<int,1> IArray;
+  /** Base class for incremental phase updates.
+   Moving a particle in r1 changes one column of the slater matrix,
+   and moving a particle in r2 changes one row, so the new inverse and
+   the determinant ratio follow from a rank-k update of the stored
+   inverse. After evaluateChange the results are available from
+   getPhi, getGradPhi and getVecPot, just as after evaluate. */
+  class MatrixUpdate {
+  public:
+    virtual ~MatrixUpdate() {}
+    /// Evaluate the phase after moving particles index1 of r1 
+    /// and index2 of r2. Indices of other species are ignored.
+    virtual void evaluateChange(const VArray &r1, const VArray &r2,
+      const IArray &index1, const IArray &index2, const int islice)=0;
+    /// Keep the updated matrices for slices 1 to nslice-1.
+    virtual void acceptLastMove(const int nslice)=0;
+  };
   /// Constructor.
   PhaseModel(const int npart) : phi(0),gradPhi1(npart),gradPhi2(npart),
-                                vecPot1(npart),vecPot2(npart) {}
+                                vecPot1(npart),vecPot2(npart),updateObj(0) {}
   /// Virtual destructor.
   virtual ~PhaseModel() {}
   /// Evaluate the PhaseModel.
@@ -52,6 +69,8 @@ public:
   const VArray& getGradPhi(const int i) const {return (i==1)?gradPhi1:gradPhi2;}
   /// Get the value of the  vector potential.
   const VArray& getVecPot(const int i) const {return (i==1)?vecPot1:vecPot2;}
+  /// Get the MatrixUpdate object, or zero if updates are not supported.
+  MatrixUpdate* getUpdateObj() const {return updateObj;}
 protected:
   /// The value of the phase.
   double phi;
@@ -59,5 +78,7 @@ protected:
   VArray gradPhi1,gradPhi2;
   /// The vector potential.
   VArray vecPot1,vecPot2;
+  /// The MatrixUpdate object.
+  MatrixUpdate *updateObj;
 };
 #endif
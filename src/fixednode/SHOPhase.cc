@@ -17,16 +17,24 @@ extern "C" void ZGETRF_F77(const int*, const int*, std::complex<double>*,
 #define ZGETRI_F77 F77_FUNC(zgetri,ZGETRI)
 extern "C" void ZGETRI_F77(const int*, std::complex<double>*, const int*, 
                      const int*, std::complex<double>*, const int*, int*);
+#define ZGETRS_F77 F77_FUNC(zgetrs,ZGETRS)
+extern "C" void ZGETRS_F77(const char *trans, const int *n, const int *nrhs,
+                           const std::complex<double> *a, const int *lda,
+                           const int *ipiv, std::complex<double> *b,
+                           const int *ldb, int *info);
 
 SHOPhase::SHOPhase(const SimulationInfo &simInfo,
   const Species &species, const double omega, const double temperature,
-  const double b, const int maxlevel)
+  const double b, const int maxlevel, const bool useUpdates,
+  const int refreshInterval)
   : PhaseModel(simInfo.getNPart()),
     tau(simInfo.getTau()),temperature(temperature), mass(species.mass),
     charge(species.charge), omega(omega), b(b), npart(species.count),
     ifirst(species.ifirst),
     matrix((1 << maxlevel) + 1),
-    gradmat1(npart,npart), gradmat2(npart,npart),
+    slater((1 << maxlevel) + 1),
+    pos1((1 << maxlevel) + 1, npart), pos2((1 << maxlevel) + 1, npart),
+    slicePhi((1 << maxlevel) + 1),
     ipiv(npart), lwork(npart*npart), work(lwork),
     omegac(charge*b/(2.0*mass*c)), omega1(sqrt(omega*omega+omegac*omegac)),
     sinh1(sinh(0.5*omega1/temperature)), cosh1(cosh(0.5*omega1/temperature)),
@@ -39,11 +47,20 @@ SHOPhase::SHOPhase(const SimulationInfo &simInfo,
             << ", charge=" << charge << ", and B=" << b << std::endl;
   for (unsigned int i=0; i<matrix.size(); ++i) {
     matrix[i] = new Matrix(npart,npart,ColMajor());
+    slater[i] = new Matrix(npart,npart,ColMajor());
+  }
+  slicePhi=0;
+  if (useUpdates) {
+    std::cout << "SHOPhase using updates, refreshed every "
+              << refreshInterval << " accepted moves" << std::endl;
+    updateObj = new MatrixUpdate(maxlevel,npart,refreshInterval,*this);
   }
 }
 
 SHOPhase::~SHOPhase() {
   for (unsigned int i=0; i<matrix.size(); ++i) delete matrix[i];
+  for (unsigned int i=0; i<slater.size(); ++i) delete slater[i];
+  delete updateObj;
 }
 
 const double SHOPhase::c(1); //(137.0359895);
@@ -51,52 +68,82 @@ const double SHOPhase::pi(acos(-1.0));
 
 void SHOPhase::evaluate(const VArray &r1, const VArray &r2, 
                           const int islice) { 
-  // First evaluate the inverse slater matrix.
   Matrix& mat(*matrix[islice]);
-  for(int jpart=0; jpart<npart; ++jpart) {
-    for(int ipart=0; ipart<npart; ++ipart) {
-      
-      Vec sum=r1(jpart+ifirst)+r2(ipart+ifirst);
-      Vec diff=r1(jpart+ifirst)-r2(ipart+ifirst);
+  Matrix& slat(*slater[islice]);
+  phi = arg(factor(r1,r2,slat,mat));
+  slicePhi(islice) = phi;
+  for (int ipart=0; ipart<npart; ++ipart) {
+    pos1(islice,ipart) = r1(ipart+ifirst);
+    pos2(islice,ipart) = r2(ipart+ifirst);
+  }
+  evaluateGradient(r1,r2,slat,mat);
+}
+
+SHOPhase::Complex SHOPhase::element(const Vec& r1, const Vec& r2) const {
+  Vec sum=r1+r2;
+  Vec diff=r1-r2;
 #if NDIM==3
-      sum[2]=0, diff[2]=0;
+  sum[2]=0, diff[2]=0;
 #endif		
-      std::complex<double> m=mat(ipart,jpart)
-        =mass*omega1/(2*pi*sinh1)
-	 *exp(-a1*(sum[0]*sum[0]+sum[1]*sum[1])
-	      -a2*(diff[0]*diff[0]+diff[1]*diff[1])
-          -Complex(0,1)*b1*(r1(jpart+ifirst)[0]*r2(ipart+ifirst)[1]
-                           -r1(jpart+ifirst)[1]*r2(ipart+ifirst)[0]) );
-           
-      gradmat1(ipart,jpart)     = m*(-2*a1*sum-2*a2*diff);
-      gradmat1(ipart,jpart)[0] -= m*Complex(0,1)*b1*r2(ipart+ifirst)[1];
-      gradmat1(ipart,jpart)[1] += m*Complex(0,1)*b1*r2(ipart+ifirst)[0];
-      gradmat2(ipart,jpart)     = m*(-2*a1*sum+2*a2*diff);
-      gradmat2(ipart,jpart)[0] += m*Complex(0,1)*b1*r1(jpart+ifirst)[1];
-      gradmat2(ipart,jpart)[1] -= m*Complex(0,1)*b1*r1(jpart+ifirst)[0];
-#if NDIM==3
-      gradmat1(ipart,jpart)[2]=0;
-      gradmat2(ipart,jpart)[2]=0;
-#endif
+  return mass*omega1/(2*pi*sinh1)
+         *exp(-a1*(sum[0]*sum[0]+sum[1]*sum[1])
+              -a2*(diff[0]*diff[0]+diff[1]*diff[1])
+              -Complex(0,1)*b1*(r1[0]*r2[1]-r1[1]*r2[0]));
+}
+
+SHOPhase::Complex SHOPhase::factor(const VArray &r1, const VArray &r2,
+    Matrix& slat, Matrix& mat) {
+  // First evaluate the slater matrix.
+  for(int jpart=0; jpart<npart; ++jpart) {
+    for(int ipart=0; ipart<npart; ++ipart) {
+      slat(ipart,jpart)=element(r1(jpart+ifirst),r2(ipart+ifirst));
     }
   }
+  mat=slat;
   // Calculate determinant and inverse.
   int info=0;
   ZGETRF_F77(&npart,&npart,mat.data(),&npart,ipiv.data(),&info);
   if (info!=0) std::cout << "BAD RETURN FROM ZGETRF!!!!" << std::endl;
   std::complex<double> det=1;
   for (int i=0; i<npart; ++i) det *= mat(i,i) * ((i+1==ipiv(i))?1.:-1.);
-  phi = arg(det);
   ZGETRI_F77(&npart,mat.data(),&npart,ipiv.data(),work.data(),&lwork,&info);
   if (info!=0) std::cout << "BAD RETURN FROM ZGETRI!!!!" << std::endl;
+  return det;
+}
+
+void SHOPhase::evaluateGradient(const VArray &r1, const VArray &r2, 
+    const Matrix& slat, const Matrix& mat) {
   gradPhi1=0.0; gradPhi2=0.0; vecPot1=0.0; vecPot2=0.0;
-  // Calculate the gradient.
   for(int jpart=0; jpart<npart; ++jpart) {
     CVec loggrad1 = Complex(0); 
     CVec loggrad2 = Complex(0); 
     for(int ipart=0; ipart<npart; ++ipart) {
-       loggrad1 += mat(jpart,ipart)*gradmat1(ipart,jpart);
-       loggrad2 += mat(ipart,jpart)*gradmat2(jpart,ipart);
+      // Gradient of element (ipart,jpart) with respect to r1(jpart).
+      const Vec& x1(r1(jpart+ifirst));
+      const Vec& x2(r2(ipart+ifirst));
+      Vec sum=x1+x2, diff=x1-x2;
+#if NDIM==3
+      sum[2]=0, diff[2]=0;
+#endif		
+      Complex m=mat(jpart,ipart)*slat(ipart,jpart);
+      for (int idim=0; idim<NDIM; ++idim) {
+        loggrad1[idim] += m*(-2*a1*sum[idim]-2*a2*diff[idim]);
+      }
+      loggrad1[0] -= m*Complex(0,1)*b1*x2[1];
+      loggrad1[1] += m*Complex(0,1)*b1*x2[0];
+      // Gradient of element (jpart,ipart) with respect to r2(jpart).
+      const Vec& y1(r1(ipart+ifirst));
+      const Vec& y2(r2(jpart+ifirst));
+      sum=y1+y2; diff=y1-y2;
+#if NDIM==3
+      sum[2]=0, diff[2]=0;
+#endif		
+      m=mat(ipart,jpart)*slat(jpart,ipart);
+      for (int idim=0; idim<NDIM; ++idim) {
+        loggrad2[idim] += m*(-2*a1*sum[idim]+2*a2*diff[idim]);
+      }
+      loggrad2[0] += m*Complex(0,1)*b1*y1[1];
+      loggrad2[1] -= m*Complex(0,1)*b1*y1[0];
     }
     for (int idim=0; idim<NDIM; ++idim) {
       gradPhi1(jpart+ifirst)[idim]=imag(loggrad1[idim]);
@@ -108,3 +155,172 @@ void SHOPhase::evaluate(const VArray &r1, const VArray &r2,
     vecPot2(jpart+ifirst)[1] = -0.5*b*r2(jpart+ifirst)[0]*charge;
   }
 }
+
+SHOPhase::MatrixUpdate::MatrixUpdate(int maxlevel, int npart,
+    int refreshInterval, SHOPhase &shoPhase)
+  : shoPhase(shoPhase), npart(npart), refreshInterval(refreshInterval),
+    nAccept(0),
+    newMatrix((1 << maxlevel) + 1),
+    newSlater((1 << maxlevel) + 1),
+    newPos1((1 << maxlevel) + 1, npart), newPos2((1 << maxlevel) + 1, npart),
+    newPhi((1 << maxlevel) + 1),
+    bmat(npart,npart,ColMajor()), wmat(npart,npart,ColMajor()),
+    smat(npart,npart,ColMajor()), xmat(npart,npart,ColMajor()),
+    cols(npart), rows(npart), ipiv(npart) {
+  for (unsigned int i=0; i<newMatrix.size(); ++i) {
+    newMatrix[i] = new Matrix(npart,npart,ColMajor());
+    newSlater[i] = new Matrix(npart,npart,ColMajor());
+  }
+}
+
+SHOPhase::MatrixUpdate::~MatrixUpdate() {
+  for (unsigned int i=0; i<newMatrix.size(); ++i) {
+    delete newMatrix[i];
+    delete newSlater[i];
+  }
+}
+
+void SHOPhase::MatrixUpdate::evaluateChange(const VArray &r1,
+    const VArray &r2, const IArray &index1, const IArray &index2,
+    const int islice) {
+  const int ifirst=shoPhase.ifirst;
+  // Find the moving columns and rows of this species.
+  int ncol=0, nrow=0;
+  for (int i=0; i<index1.size(); ++i) {
+    int jpart=index1(i)-ifirst;
+    if (jpart>=0 && jpart<npart) cols(ncol++)=jpart;
+  }
+  for (int i=0; i<index2.size(); ++i) {
+    int ipart=index2(i)-ifirst;
+    if (ipart>=0 && ipart<npart) rows(nrow++)=ipart;
+  }
+  Matrix& inv(*newMatrix[islice]);
+  Matrix& slat(*newSlater[islice]);
+  Complex ratio=0;
+  if (nAccept<refreshInterval) {
+    inv=*shoPhase.matrix[islice];
+    slat=*shoPhase.slater[islice];
+    ratio=1;
+    if (ncol>0) ratio*=updateColumns(r1,islice,inv,slat,ncol);
+    if (nrow>0 && ratio!=0.) ratio*=updateRows(r1,r2,inv,slat,nrow);
+  }
+  if (ratio!=0.) {
+    newPhi(islice)=arg(std::polar(1.,shoPhase.slicePhi(islice))*ratio);
+  } else {
+    // Rebuild from scratch on refresh or a singular update.
+    newPhi(islice)=arg(shoPhase.factor(r1,r2,slat,inv));
+  }
+  for (int ipart=0; ipart<npart; ++ipart) {
+    newPos1(islice,ipart) = r1(ipart+ifirst);
+    newPos2(islice,ipart) = r2(ipart+ifirst);
+  }
+  shoPhase.phi=newPhi(islice);
+  shoPhase.evaluateGradient(r1,r2,slat,inv);
+}
+
+SHOPhase::Complex SHOPhase::MatrixUpdate::updateColumns(const VArray &r1,
+    const int islice, Matrix& inv, Matrix& slat, const int nmove) {
+  const int ifirst=shoPhase.ifirst;
+  // New columns use the stored r2, since moving rows are updated next.
+  for (int b=0; b<nmove; ++b) {
+    const Vec& x1(r1(cols(b)+ifirst));
+    for (int i=0; i<npart; ++i) {
+      bmat(i,b)=shoPhase.element(x1,shoPhase.pos2(islice,i));
+    }
+  }
+  // Calculate W=A^{-1}B and the small matrix S.
+  for (int b=0; b<nmove; ++b) {
+    for (int i=0; i<npart; ++i) wmat(i,b)=0.;
+    for (int l=0; l<npart; ++l) {
+      Complex bl=bmat(l,b);
+      for (int i=0; i<npart; ++i) wmat(i,b)+=inv(i,l)*bl;
+    }
+    for (int a=0; a<nmove; ++a) smat(a,b)=wmat(cols(a),b);
+  }
+  int info=0;
+  ZGETRF_F77(&nmove,&nmove,smat.data(),&npart,ipiv.data(),&info);
+  if (info!=0) return 0.;
+  Complex ratio=1;
+  for (int a=0; a<nmove; ++a) ratio*=smat(a,a)*((a+1==ipiv(a))?1.:-1.);
+  // Calculate X=S^{-1}A^{-1}_{C.} and update the inverse.
+  for (int j=0; j<npart; ++j) {
+    for (int a=0; a<nmove; ++a) xmat(a,j)=inv(cols(a),j);
+  }
+  const char trans='N';
+  ZGETRS_F77(&trans,&nmove,&npart,smat.data(),&npart,ipiv.data(),
+             xmat.data(),&npart,&info);
+  for (int b=0; b<nmove; ++b) wmat(cols(b),b)-=1.;
+  for (int j=0; j<npart; ++j) {
+    for (int a=0; a<nmove; ++a) {
+      Complex x=xmat(a,j);
+      for (int i=0; i<npart; ++i) inv(i,j)-=wmat(i,a)*x;
+    }
+  }
+  for (int b=0; b<nmove; ++b) {
+    for (int i=0; i<npart; ++i) slat(i,cols(b))=bmat(i,b);
+  }
+  return ratio;
+}
+
+SHOPhase::Complex SHOPhase::MatrixUpdate::updateRows(const VArray &r1,
+    const VArray &r2, Matrix& inv, Matrix& slat, const int nmove) {
+  const int ifirst=shoPhase.ifirst;
+  // New rows use the new r1.
+  for (int j=0; j<npart; ++j) {
+    const Vec& x1(r1(j+ifirst));
+    for (int a=0; a<nmove; ++a) {
+      bmat(a,j)=shoPhase.element(x1,r2(rows(a)+ifirst));
+    }
+  }
+  // Calculate Y=DA^{-1} and the small matrix T.
+  for (int j=0; j<npart; ++j) {
+    for (int a=0; a<nmove; ++a) wmat(a,j)=0.;
+    for (int l=0; l<npart; ++l) {
+      Complex invlj=inv(l,j);
+      for (int a=0; a<nmove; ++a) wmat(a,j)+=bmat(a,l)*invlj;
+    }
+  }
+  for (int b=0; b<nmove; ++b) {
+    for (int a=0; a<nmove; ++a) smat(a,b)=wmat(a,rows(b));
+  }
+  int info=0;
+  ZGETRF_F77(&nmove,&nmove,smat.data(),&npart,ipiv.data(),&info);
+  if (info!=0) return 0.;
+  Complex ratio=1;
+  for (int a=0; a<nmove; ++a) ratio*=smat(a,a)*((a+1==ipiv(a))?1.:-1.);
+  // Calculate Z=T^{-1}(Y-E_R) and update the inverse.
+  for (int a=0; a<nmove; ++a) wmat(a,rows(a))-=1.;
+  const char trans='N';
+  ZGETRS_F77(&trans,&nmove,&npart,smat.data(),&npart,ipiv.data(),
+             wmat.data(),&npart,&info);
+  for (int a=0; a<nmove; ++a) {
+    for (int i=0; i<npart; ++i) xmat(i,a)=inv(i,rows(a));
+  }
+  for (int j=0; j<npart; ++j) {
+    for (int a=0; a<nmove; ++a) {
+      Complex z=wmat(a,j);
+      for (int i=0; i<npart; ++i) inv(i,j)-=xmat(i,a)*z;
+    }
+  }
+  for (int j=0; j<npart; ++j) {
+    for (int a=0; a<nmove; ++a) slat(rows(a),j)=bmat(a,j);
+  }
+  return ratio;
+}
+
+void SHOPhase::MatrixUpdate::acceptLastMove(const int nslice) {
+  for (int islice=1; islice<nslice; ++islice) {
+    Matrix* ptr=shoPhase.matrix[islice];
+    shoPhase.matrix[islice]=newMatrix[islice];
+    newMatrix[islice]=ptr;
+    ptr=shoPhase.slater[islice];
+    shoPhase.slater[islice]=newSlater[islice];
+    newSlater[islice]=ptr;
+    shoPhase.slicePhi(islice)=newPhi(islice);
+    for (int ipart=0; ipart<npart; ++ipart) {
+      shoPhase.pos1(islice,ipart)=newPos1(islice,ipart);
+      shoPhase.pos2(islice,ipart)=newPos2(islice,ipart);
+    }
+  }
+  if (nAccept>=refreshInterval) nAccept=0; else ++nAccept;
+}
@@ -64,9 +64,54 @@ public:
   typedef blitz::Array<int,1> IArray;
   typedef blitz::Array<Complex,1> CArray;
   typedef blitz::ColumnMajorArray<2> ColMajor;
+  typedef blitz::Array<Vec,2> VecMatrix;
+  /** Class for rank-k updates of the inverse slater matrices.
+   The slater matrix is @f$ A_{ij}=\rho(r_{1j},r_{2i}) @f$, so moving
+   particles in r1 replaces the columns C. With @f$ W=A^{-1}B @f$ for
+   the new columns B and @f$ S=W_{C\cdot} @f$, the determinant changes
+   by @f$ |S| @f$ and
+   @f[ (A')^{-1} = A^{-1} - (W-E_C)S^{-1}A^{-1}_{C\cdot}. @f]
+   Moved rows R in r2 are then treated the same way with
+   @f$ Y=DA'^{-1} @f$ for the new rows D and @f$ T=Y_{\cdot R} @f$.
+   The update costs @f$ O(N^2k) @f$ instead of @f$ O(N^3) @f$.
+   Every refreshInterval accepted moves the matrices are rebuilt
+   from scratch to control roundoff. */
+  class MatrixUpdate : public PhaseModel::MatrixUpdate {
+  public:
+    MatrixUpdate(int maxlevel, int npart, int refreshInterval, SHOPhase&);
+    virtual ~MatrixUpdate();
+    virtual void evaluateChange(const VArray &r1, const VArray &r2,
+      const IArray &index1, const IArray &index2, const int islice);
+    virtual void acceptLastMove(const int nslice);
+  private:
+    SHOPhase& shoPhase;
+    const int npart;
+    /// Number of accepted updates between full refreshes.
+    const int refreshInterval;
+    /// Number of updates accepted since the last full refresh.
+    int nAccept;
+    /// Temporary storage for updated inverse and slater matrices.
+    std::vector<Matrix*> newMatrix, newSlater;
+    /// Temporary storage for updated positions and phases.
+    VecMatrix newPos1, newPos2;
+    blitz::Array<double,1> newPhi;
+    /// Work matrices for the new columns or rows and their products.
+    Matrix bmat, wmat, smat, xmat;
+    /// Moving columns and rows of the slater matrix.
+    IArray cols, rows;
+    /// Pivots for the small determinant.
+    IArray ipiv;
+    /// Replace the moving columns, returning the determinant ratio.
+    Complex updateColumns(const VArray& r1, const int islice,
+                          Matrix& inv, Matrix& slater, const int nmove);
+    /// Replace the moving rows, returning the determinant ratio.
+    Complex updateRows(const VArray& r1, const VArray& r2,
+                       Matrix& inv, Matrix& slater, const int nmove);
+  };
   /// Constructor.
   SHOPhase(const SimulationInfo&, const Species&, const double omega,
-           const double temperature, const double b, const int maxlevel);
+           const double temperature, const double b, const int maxlevel,
+           const bool useUpdates=false, const int refreshInterval=100);
   /// Virtual destructor.
   virtual ~SHOPhase();
   /// Evaluate the phase, gradient of of the phase, and vector potential.
@@ -92,8 +137,11 @@ private:
   int nslice;
   /// Inverse slater matrices, stored at each slice.
   std::vector<Matrix*> matrix; 
-  /// Temporary storage for gadient of the slater matrix.
-  VMatrix gradmat1, gradmat2; 
+  /// Slater matrices, stored at each slice.
+  std::vector<Matrix*> slater; 
+  /// Positions and phases of the stored slater matrices.
+  VecMatrix pos1, pos2;
+  blitz::Array<double,1> slicePhi;
   /// Matrix diagonalization arrays.
   IArray ipiv;
   const int lwork;
@@ -106,6 +154,14 @@ private:
   const double sinh1,cosh1,sinhc,coshc;
   /// More constants.
   const double a1,a2,b1;
+  /// Evaluate a slater matrix element.
+  Complex element(const Vec& r1, const Vec& r2) const;
+  /// Fill and invert a slater matrix, returning the determinant.
+  Complex factor(const VArray& r1, const VArray& r2,
+                 Matrix& slater, Matrix& inv);
+  /// Evaluate the phase gradients and vector potentials.
+  void evaluateGradient(const VArray& r1, const VArray& r2,
+                        const Matrix& slater, const Matrix& inv);
   /// The speed of light.
   static const double c;
   /// Pi.
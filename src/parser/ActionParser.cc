@@ -94,6 +94,8 @@ void ActionParser::parse(const xmlXPathContextPtr& ctxt) {
   doubleAction=doubleComposite;
   parseActions(ctxt,obj,composite,doubleComposite);
   xmlXPathFreeObject(obj);
+  composite->routeBySpecies(simInfo);
+  doubleComposite->routeBySpecies(simInfo);
   if (doubleComposite->getCount()==0) {
      doubleAction=0; delete doubleComposite;
   }
@@ -147,9 +149,11 @@ void ActionParser::parseActions(const xmlXPathContextPtr& ctxt,
       std :: cout <<"ActionParser :: CoulombAction :: kappa :: "<< kappa<<std :: endl;
       double kcut=getDoubleAttribute(actNode,"ewaldKcut");
       double screenDist=getLengthAttribute(actNode,"screenDist");
+      bool useImageTable=getBoolAttribute(actNode,"imageTable");
       composite->addAction(
         new CoulombAction(epsilon,simInfo,norder,rmin,rmax,ngpts,dumpFiles,
-          useEwald,ndim,rcut,kcut,screenDist,kappa,nimages,ewaldType,exLevel));
+          useEwald,ndim,rcut,kcut,screenDist,kappa,nimages,ewaldType,exLevel,
+          useImageTable));
       continue;
     } else if (name=="GaussianAction") {
       double v0=getEnergyAttribute(actNode,"v0");
@@ -167,7 +171,12 @@ void ActionParser::parseActions(const xmlXPathContextPtr& ctxt,
       if (fileName=="") fileName="emagrids.h5";
       int maxLevel=getIntAttribute(actNode,"level");
       if (maxLevel==0) maxLevel=12; //maybe this should be 8
-      composite->addAction(new SmoothedGridPotential(simInfo,maxLevel,fileName));
+      std::string cacheFile=getStringAttribute(actNode,"cacheFile");
+      if (cacheFile=="") cacheFile="smoothedgrids.h5";
+      std::string wisdomFile=getStringAttribute(actNode,"wisdomFile");
+      if (wisdomFile=="") wisdomFile="fftw.wisdom";
+      composite->addAction(new SmoothedGridPotential(simInfo,maxLevel,fileName,
+                                                     cacheFile,wisdomFile,mpi));
       continue;
     } else if (name=="OpticalLatticeAction") {
       Vec v0;
@@ -461,7 +470,11 @@ void ActionParser::parseActions(const xmlXPathContextPtr& ctxt,
       if (modelName=="SHOPhase") {
         double omega=getEnergyAttribute(actNode,"omega");
 	double b=getEnergyAttribute(actNode,"b");
-        phaseModel=new SHOPhase(simInfo,species,omega,t,b,maxlevel);
+        bool useUpdates=getBoolAttribute(actNode,"useUpdates");
+        int refreshInterval=getIntAttribute(actNode,"refreshInterval");
+        if (refreshInterval==0) refreshInterval=100;
+        phaseModel=new SHOPhase(simInfo,species,omega,t,b,maxlevel,
+                                useUpdates,refreshInterval);
       }else if(modelName=="SpinPhase"){
         double t=getEnergyAttribute(actNode,"t");
         if (t==0) t=simInfo.getTemperature();
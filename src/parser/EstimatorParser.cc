@@ -5,6 +5,7 @@
 #include "EstimatorParser.h"
 #include "action/Action.h"
 #include "action/ActionChoice.h"
+#include "action/CompositeAction.h"
 #include "action/CoulombAction.h"
 #include "action/DoubleAction.h"
 #include "base/Charges.h"
@@ -17,6 +18,8 @@
 #include "base/Species.h"
 #include "emarate/EMARateEstimator.h"
 #include "emarate/EMARateWeight.h"
+#include "estimator/ActionDriftEstimator.h"
+#include "estimator/ActionTotalEstimator.h"
 #include "estimator/AngularMomentumEstimator.h"
 #include "estimator/ConductivityEstimator.h"
 #include "estimator/ConductivityEstimator2D.h"
@@ -60,6 +63,7 @@
 #include "util/PairDistance.h"
 #include "util/SuperCell.h"
 #include "estimator/WeightEstimator.h"
+#include <sstream>
 
 EstimatorParser::EstimatorParser(const SimulationInfo& simInfo,
     const double tau, const Action* action, const DoubleAction* doubleAction,
@@ -147,6 +151,37 @@ void EstimatorParser::parse(const xmlXPathContextPtr& ctxt) {
       manager->add(new ThermoEnergyEstimator(simInfo,action,doubleAction,
           unitName, scale, shift, manager->createScalarAccumulator()));
     }
+    if (name=="ActionTotalEstimator") {
+      const CompositeAction* composite
+        = dynamic_cast<const CompositeAction*>(action);
+      if (!composite) {
+        std::cout << "ERROR: ActionTotalEstimator needs a composite action"
+                  << std::endl;
+        exit(-1);
+      }
+      // Path replicas share one action, which has only one running total.
+      xmlXPathObjectPtr pimcObj = xmlXPathEval(BAD_CAST"//PIMC",ctxt);
+      int nreplica = (pimcObj->nodesetval->nodeNr>0) ? parser.getIntAttribute(
+          pimcObj->nodesetval->nodeTab[0],"nreplica") : 1;
+      xmlXPathFreeObject(pimcObj);
+      if (nreplica>1) {
+        std::cout << "ERROR: ActionTotalEstimator needs nreplica=1"
+                  << std::endl;
+        exit(-1);
+      }
+      manager->add(new ActionTotalEstimator("action_total",composite,-1,
+          mpi,manager->createScalarAccumulator()));
+      if (parser.getBoolAttribute(estNode,"perAction")) {
+        for (int i=0; i<composite->getCount(); ++i) {
+          std::ostringstream estName;
+          estName << "action_" << i;
+          manager->add(new ActionTotalEstimator(estName.str(),composite,i,
+              mpi,manager->createScalarAccumulator()));
+        }
+      }
+      manager->add(new ActionDriftEstimator(composite,mpi,
+          manager->createScalarAccumulator()));
+    }
     if (name=="SpinEstimator") {
       double gc= parser.getDoubleAttribute(estNode,"gc");
       manager->add(new SpinEstimator(simInfo,0,gc));
@@ -183,6 +218,8 @@ void EstimatorParser::parse(const xmlXPathContextPtr& ctxt) {
 	if (ewaldType=="") ewaldType="optEwald";
 	if (ewaldType=="opt") ewaldType="optEwald";
 	if (ewaldType=="trad") ewaldType="tradEwald";
+	// PME approximates the same k-space sum as optEwald.
+	if (ewaldType=="pme") ewaldType="optEwald";
 	
 	if (ewaldType=="" || ewaldType=="optEwald"){
 	  manager->add(new EwaldCoulombEstimator(simInfo,action,
@@ -413,8 +450,9 @@ void EstimatorParser::parse(const xmlXPathContextPtr& ctxt) {
         }
       }
       if (name=="DensityEstimator") {
+        bool sparse=parser.getBoolAttribute(estNode,"sparse");
         manager->add(new DensityEstimator(simInfo,estName,spec,
-                                          min,max,nbin,dist, mpi));
+                                          min,max,nbin,dist, mpi, sparse));
       } else if (name=="SpinChoiceDensityEstimator") {
 	std::string spin =  parser.getStringAttribute(estNode,"spin");
 	int ispin = 0; 
@@ -721,7 +759,8 @@ std::cout << name << min[idist] << " - " << max[idist] << "  " << nbin << std::e
     }
   }
   //delete [] speciesList;
-  return new PairCFEstimator<N>(simInfo,name,speciesList,nspecies,min,max,nbin,dist,mpi);
+  bool sparse=parser.getBoolAttribute(estNode,"sparse");
+  return new PairCFEstimator<N>(simInfo,name,speciesList,nspecies,min,max,nbin,dist,mpi,sparse);
 }
 
 void EstimatorParser::parseDistance(xmlNodePtr estNode, 
@@ -12,12 +12,14 @@
 #include "advancer/DisplaceMoveSampler.h"
 #include "advancer/DoubleDisplaceMoveSampler.h"
 #include "advancer/ModelSampler.h"
+#include "advancer/ReplicaExchangeSampler.h"
 #include "advancer/SpinModelSampler.h"
 #include "advancer/mover/DampedFreeTensorMover.h"
 #include "advancer/mover/FreeTensorMover.h"
 #include "algorithm/Algorithm.h"
 #include "algorithm/Loop.h"
 #include "algorithm/CompositeAlgorithm.h"
+#include "algorithm/ErrorTarget.h"
 #include "advancer/SectionChooser.h"
 #include "advancer/DoubleSectionChooser.h"
 #include "advancer/MiddleSectionChooser.h"
@@ -51,6 +53,8 @@
 #include "advancer/RandomPermutationChooser.h"
 #include "advancer/SpinStatePermutationChooser.h"
 #include "advancer/WalkingChooser.h"
+#include "advancer/SparseWalkingChooser.h"
+#include "advancer/SwapChooser.h"
 #include "advancer/PairChooser.h"
 #include "advancer/TwoPairChooser.h"
 #include "base/DoubleParallelPaths.h"
@@ -66,8 +70,10 @@
 #include "stats/AccRejEstimator.h"
 #include "stats/EstimatorManager.h"
 #include "stats/MPIManager.h"
+#include "stats/ScalarEstimator.h"
 #include "util/SuperCell.h"
 #include <iostream>
+#include <sstream>
 
 
 PIMCParser::PIMCParser(const SimulationInfo &simInfo, Action *action,
@@ -78,11 +84,11 @@ PIMCParser::PIMCParser(const SimulationInfo &simInfo, Action *action,
     paths(0), algorithm(0), simInfo(simInfo), action(action), 
     doubleAction(doubleAction), actionChoice(actionChoice),
     estimators(estimators), probDensityGrid(0),
-    beadFactory(beadFactory), mpi(mpi) {
+    beadFactory(beadFactory), mpi(mpi), ireplica(-1) {
 }
 
 PIMCParser::~PIMCParser() {
-  delete paths;
+  for (unsigned int i=0; i<replicaPaths.size(); ++i) delete replicaPaths[i];
   delete action;
   delete doubleAction;
   delete probDensityGrid;
@@ -94,6 +100,8 @@ void PIMCParser::parse(const xmlXPathContextPtr& ctxt) {
   xmlXPathObjectPtr obj = xmlXPathEval(BAD_CAST"//PIMC",ctxt);
   xmlNodePtr& pimcNode=obj->nodesetval->nodeTab[0]; ctxt->node=pimcNode;
   bool useDoublePaths=getBoolAttribute(pimcNode,"useDoublePaths");
+  int nreplica=getIntAttribute(pimcNode,"nreplica");
+  if (nreplica<1) nreplica=1;
   xmlXPathFreeObject(obj);
   double t=simInfo.getTemperature();
   double tau=simInfo.getTau();
@@ -117,6 +125,23 @@ void PIMCParser::parse(const xmlXPathContextPtr& ctxt) {
   if (actionChoice) {
     paths->setModelState(&actionChoice->getModelState());
   }
+  replicaPaths.push_back(paths);
+  // Extra replicas share the actions and estimators of this process.
+  if (nreplica>1) {
+    if ((mpi && mpi->getNWorker()>1) || actionChoice) {
+      std::cout << "ERROR: nreplica>1 needs nworker=1 and no model sampling."
+                << std::endl;
+      exit(-1);
+    }
+    if (!mpi || mpi->isMain()) {
+      std::cout << "Advancing " << nreplica << " path replicas per clone."
+                << std::endl;
+    }
+    for (int i=1; i<nreplica; ++i) {
+      replicaPaths.push_back(new SerialPaths(simInfo.getNPart(),
+                             nslice,tau,*simInfo.getSuperCell(),beadFactory));
+    }
+  }
 
   // Parse the algorithm.
   algorithm=parseAlgorithm(ctxt);
@@ -126,6 +151,17 @@ Algorithm* PIMCParser::parseAlgorithm(const xmlXPathContextPtr& ctxt) {
   Algorithm* algorithm(0);
   std::string name((char*)ctxt->node->name);
   //std::cout << name << std::endl;
+  if (ireplica<0 && replicaPaths.size()>1 && isReplicated(name)) {
+    // Parse a copy for each replica, run in turn on every step.
+    CompositeAlgorithm *batch=new CompositeAlgorithm(replicaPaths.size());
+    for (ireplica=0; ireplica<(int)replicaPaths.size(); ++ireplica) {
+      paths=replicaPaths[ireplica];
+      batch->set(ireplica,parseAlgorithm(ctxt));
+    }
+    ireplica=-1;
+    paths=replicaPaths[0];
+    return batch;
+  }
   if (name=="PIMC"||name=="Composite") {
     CompositeAlgorithm *composite=new CompositeAlgorithm(0);
     parseBody(ctxt,composite);
@@ -141,7 +177,7 @@ Algorithm* PIMCParser::parseAlgorithm(const xmlXPathContextPtr& ctxt) {
     if (timer == "Main" && totalSimTime ==0 ) totalSimTime = 12*3600;
     Loop *loop(0);      
     loop=new Loop(nrepeat,totalSimTime,timer,mpi);
-    
+    parseErrorTargets(ctxt,loop);
     parseBody(ctxt,loop);
     algorithm=loop;
   } else if (name=="ChooseMiddleSection") {
@@ -282,18 +318,22 @@ std::cout << "doubleAction!=0" << std::endl;
     } 
     std::string accRejName="DisplaceMoveSampler";
     estimators->add(((DisplaceMoveSampler*)algorithm)->
-		    getAccRejEstimator(accRejName));
+		    getAccRejEstimator(replicaName(accRejName)));
 
   } else if (name=="SampleModel") {
     int target = getIntAttribute(ctxt->node,"target");
     if (target==0) target=-1;
     algorithm = new ModelSampler(*paths, action, actionChoice, target, mpi);
     estimators->add(((ModelSampler*)algorithm)->
-		    getAccRejEstimator("ModelSampler"));
+		    getAccRejEstimator(replicaName("ModelSampler")));
+  } else if (name=="SampleReplicaExchange") {
+    algorithm = new ReplicaExchangeSampler(*paths, actionChoice, mpi);
+    estimators->add(((ReplicaExchangeSampler*)algorithm)->
+		    getAccRejEstimator(replicaName("ReplicaExchange")));
   } else if (name=="SampleSpinModel") {
     algorithm = new SpinModelSampler(*paths, action, actionChoice, mpi);
     estimators->add(((SpinModelSampler*)algorithm)->
-		    getAccRejEstimator("ModelSampler"));
+		    getAccRejEstimator(replicaName("ModelSampler")));
   } else if (name=="ShiftWorkers") {
     int maxShift=getIntAttribute(ctxt->node,"maxShift");
     WorkerShifter *shifter=new WorkerShifter(maxShift,*paths,mpi);
@@ -398,6 +438,37 @@ std::cout << "doubleAction!=0" << std::endl;
                     particleChooser2 = chooser;
                     permutationChooser2 = chooser;
                 }
+            } else if (chooserName == "swap") {
+                SwapChooser* chooser = new SwapChooser(
+                        simInfo.getSpecies(speciesName), nlevel, simInfo);
+                particleChooser = chooser;
+                permutationChooser = chooser;
+                shouldDeletePermutationChooser = false;
+                if (doubleAction) {
+                    SwapChooser* chooser = new SwapChooser(
+                            simInfo.getSpecies(speciesName), nlevel, simInfo);
+                    particleChooser2 = chooser;
+                    permutationChooser2 = chooser;
+                }
+                nmoving = 2;
+            } else if (chooserName == "sparse") {
+                double cutoffLambda = getDoubleAttribute(ctxt->node,
+                        "cutoffLambda");
+                if (cutoffLambda == 0.)
+                    cutoffLambda = 4.7;
+                SparseWalkingChooser* chooser = new SparseWalkingChooser(
+                        nmoving, simInfo.getSpecies(speciesName), nlevel,
+                        simInfo, cutoffLambda);
+                particleChooser = chooser;
+                permutationChooser = chooser;
+                shouldDeletePermutationChooser = false;
+                if (doubleAction) {
+                    SparseWalkingChooser* chooser = new SparseWalkingChooser(
+                            nmoving, simInfo.getSpecies(speciesName), nlevel,
+                            simInfo, cutoffLambda);
+                    particleChooser2 = chooser;
+                    permutationChooser2 = chooser;
+                }
             } else if (chooserName == "pair") {
                 std::string species2Name = getStringAttribute(ctxt->node,
                         "species2");
@@ -489,7 +560,7 @@ std::cout << "doubleAction!=0" << std::endl;
             permutationChooser->setMLSampler((MultiLevelSampler*) algorithm);
             permutationChooser2->setMLSampler((MultiLevelSampler*) algorithm);
         }
-        std::string accRejName = "MLSampler";
+        std::string accRejName = replicaName("MLSampler");
         estimators->add(
                 ((MultiLevelSampler*) algorithm)->getAccRejEstimator(
                         accRejName));
@@ -523,7 +594,7 @@ std::cout << "doubleAction!=0" << std::endl;
                     *doubleSectionChooser, action, doubleAction, nrepeat,
                     beadFactory, mover, both, cell);
         }
-        std::string accRejName = "CollectiveSampler";
+        std::string accRejName = replicaName("CollectiveSampler");
         estimators->add(
                 ((CollectiveSectionSampler*) algorithm)->getAccRejEstimator(
                         accRejName));
@@ -566,13 +637,18 @@ std::cout << "doubleAction!=0" << std::endl;
     int dumpFreq=getIntAttribute(ctxt->node,"freq");
     int maxConfigs=getIntAttribute(ctxt->node,"configs");
     maxConfigs = (maxConfigs==0)?500:maxConfigs;
+    bool binary=(getStringAttribute(ctxt->node,"format")=="binary");
     bool writeMovie=0;
     if (mpi){
-      if (mpi->isMain()) writeMovie=getBoolAttribute(ctxt->node,"movie");     
+      // Every worker writes its own slices of a binary movie.
+      if (mpi->isMain() || (binary && mpi->getCloneID()==0)) {
+        writeMovie=getBoolAttribute(ctxt->node,"movie");
+      }
     } else {
       writeMovie=getBoolAttribute(ctxt->node,"movie");
     }
-    algorithm=new WritePaths(*paths,filename,dumpFreq,maxConfigs,writeMovie,simInfo,mpi,beadFactory);
+    algorithm=new WritePaths(*paths,filename,dumpFreq,maxConfigs,writeMovie,
+                             simInfo,mpi,beadFactory,binary);
   } else if (name=="SetSpin") {
     algorithm=new SpinSetter(*paths,mpi);
   } else if (name=="SetCubicLattice") {
@@ -622,7 +698,8 @@ std::cout << "doubleAction!=0" << std::endl;
     std::string filename=getStringAttribute(ctxt->node,"file");
     int bfactor=getIntAttribute(ctxt->node,"bfactor");
     if (bfactor==0) bfactor=1;
-    algorithm=new PathReader(*paths,filename,beadFactory,bfactor,mpi);
+    int frame=getIntAttribute(ctxt->node,"frame");
+    algorithm=new PathReader(*paths,filename,beadFactory,bfactor,mpi,frame);
   } else if (name=="ReadStruct") {
     std::string filename=getStringAttribute(ctxt->node,"file");
     algorithm=new StructReader(*paths,filename,mpi);
@@ -652,6 +729,57 @@ void PIMCParser::parseBody(const xmlXPathContextPtr& ctxt,
   ctxt->node=node;
 }
 
+void PIMCParser::parseErrorTargets(const xmlXPathContextPtr& ctxt,
+  Loop* loop) {
+  xmlXPathObjectPtr obj = xmlXPathEval(BAD_CAST"ErrorTarget",ctxt);
+  int ntarget=obj->nodesetval->nodeNr;
+  for (int i=0; i<ntarget; ++i) {
+    xmlNodePtr node=obj->nodesetval->nodeTab[i];
+    std::string estName=getStringAttribute(node,"estimator");
+    double absError=getDoubleAttribute(node,"absError");
+    double relError=getDoubleAttribute(node,"relError");
+    if (absError<=0 && relError<=0) {
+      std::cout << "ERROR: ErrorTarget for " << estName
+                << " needs a positive absError or relError." << std::endl;
+      exit(-1);
+    }
+    const ScalarEstimator* estimator=0;
+    std::vector<Estimator*>& all(estimators->getEstimatorSet("all"));
+    for (unsigned int iest=0; iest<all.size(); ++iest) {
+      if (all[iest]->getName()==estName) {
+        estimator=dynamic_cast<ScalarEstimator*>(all[iest]);
+      }
+    }
+    if (!estimator) {
+      std::cout << "ERROR: no scalar estimator " << estName
+                << " for ErrorTarget." << std::endl;
+      exit(-1);
+    }
+    loop->addErrorTarget(new ErrorTarget(*estimator,absError,relError));
+  }
+  int checkEvery=getIntAttribute(ctxt->node,"checkEvery");
+  if (checkEvery>0) loop->setErrorCheckInterval(checkEvery);
+  xmlXPathFreeObject(obj);
+}
+
+bool PIMCParser::isReplicated(const std::string& name) const {
+  // Containers, estimator collection, seeding and output run once.
+  return !(name=="PIMC" || name=="Composite" || name=="Loop"
+        || name=="ErrorTarget" || name=="Collect"
+        || name=="RandomGenerator" || name=="WritePaths"
+        || name=="ProbDensityGrid" || name=="BinProbDensity"
+        || name=="WriteProbDensity" || name=="ConditionalDensityGrid"
+        || name=="BinConditionalDensity"
+        || name=="WriteConditionalDensity");
+}
+
+std::string PIMCParser::replicaName(const std::string& name) const {
+  if (ireplica<=0) return name;
+  std::ostringstream longName;
+  longName << name << "_r" << ireplica;
+  return longName.str();
+}
+
 int PIMCParser::getLoopCount(const xmlXPathContextPtr& ctxt) {
   int count=1;
   xmlXPathObjectPtr obj = xmlXPathEval(BAD_CAST"ancestor::Loop",ctxt);
@@ -19,6 +19,7 @@
 #include "parser/XMLUnitParser.h"
 #include <cstdlib>
 #include <blitz/tinyvec.h>
+#include <string>
 #include <vector>
 class Paths;
 class SuperCell;
@@ -27,6 +28,7 @@ class DoubleSectionChooser;
 class SimulationInfo;
 class Algorithm;
 class CompositeAlgorithm;
+class Loop;
 class Action;
 class ActionChoiceBase;
 class DoubleAction;
@@ -35,6 +37,16 @@ class ProbDensityGrid;
 class MPIManager;
 class BeadFactory;
 /** XML Parser for PIMC simulation data.
+  * With nreplica="K" on the PIMC element, each clone advances K
+  * independent path replicas that share one copy of the actions and
+  * estimators. Every algorithm node that acts on the paths is parsed once
+  * per replica and the copies run in turn, so each Loop iteration advances
+  * all replicas in lockstep; Measure then adds one sample per replica.
+  * Collect and the density grids use the first replica. WritePaths saves
+  * only the paths of the first replica, while ReadPaths loads the same
+  * file into every replica, so a restarted run begins with identical
+  * replicas. ActionTotalEstimator is rejected with replicas, since they
+  * share one action and its running totals.
   * @version $Revision$
   * @todo Get rid of explicit use of blitz.
   * @todo Clean up parsing of ConditionalDensityGrid.
@@ -53,7 +65,7 @@ public:
   /// Return the Algorithm object.
   Algorithm* getAlgorithm() {return algorithm;}
 private:
-  /// Holder for the Paths object.
+  /// Holder for the Paths object of the replica being parsed.
   Paths* paths;
   /// Holder for the Algorithm tree.
   Algorithm* algorithm;
@@ -65,8 +77,15 @@ private:
   const SimulationInfo& simInfo;
   /// Parse an algorithm.
   Algorithm* parseAlgorithm(const xmlXPathContextPtr& ctxt);
+  /// Whether an algorithm node gets a copy for each replica.
+  bool isReplicated(const std::string& name) const;
+  /// Name of an accept/reject estimator for the current replica.
+  std::string replicaName(const std::string& name) const;
   /// Parse the body of an algorithm.
   void parseBody(const xmlXPathContextPtr& ctxt, CompositeAlgorithm*);
+  /// Parse ErrorTarget elements that can end a Loop early, and the
+  /// checkEvery attribute of the Loop that spaces out their checks.
+  void parseErrorTargets(const xmlXPathContextPtr& ctxt, Loop*);
   /// Parse the boundary.
   void parseBoundary(const xmlXPathContextPtr& ctxt, Vec& min, Vec& max);
   /// The Action.
@@ -84,6 +103,10 @@ private:
   const BeadFactory &beadFactory;
   /// The MPIManager.
   MPIManager *mpi;
+  /// Paths for each replica in this process.
+  std::vector<Paths*> replicaPaths;
+  /// Replica being parsed, or -1 outside a replicated node.
+  int ireplica;
   /// Current number of levels in sectionChooser or doubleSectionChooser.
   int nlevel;
   /// Count number of loop iterations surrounding an XML node.
@@ -34,35 +34,18 @@ double FreeSpinMover::makeMove(MultiLevelSampler& sampler, const int level) {
   Beads<4>& movingBeads =
     dynamic_cast<Beads<4>&>(*sampler.getMovingBeads().getAuxBeads(1));
   const int nStride = 1 << level;
-  const int nSlice=sectionBeads.getNSlice();
   const blitz::Array<int,1>& index=sampler.getMovingIndex(); 
   const int nMoving=index.size();
-  blitz::Array<SVec,1> gaussRand(nMoving);
-  double toldOverTnew=0;
-  for (int islice=nStride; islice<nSlice-nStride; islice+=2*nStride) {
-    RandomNumGenerator::makeGaussRand(gaussRand);
-    for (int iMoving=0; iMoving<nMoving; ++iMoving) {
-      const int i=index(iMoving);
-      double sigma = sqrt(lambda(i)*tau*nStride);
-      double inv2Sigma2 = 0.5/(sigma*sigma);
-      // Calculate the new position.
-      SVec midpoint=movingBeads.delta(iMoving,islice+nStride,-2*nStride)*0.5;
-      midpoint+=movingBeads(iMoving,islice-nStride);
-      SVec delta = gaussRand(iMoving); delta*=sigma;
-      (movingBeads(iMoving,islice)=midpoint)+=delta;
-      // Add transition probability for move.
-      for (int idim=0;idim<4;++idim) {
-        toldOverTnew += delta[idim]*delta[idim]*inv2Sigma2;
-      }
-      // Calculate and add reverse transition probability.
-      midpoint=sectionBeads.delta(i,islice+nStride,-2*nStride)*0.5;
-      midpoint+=sectionBeads(i,islice-nStride);
-      delta=sectionBeads(i,islice); delta-=midpoint;
-      for (int idim=0;idim<4;++idim) {
-        toldOverTnew -= delta[idim]*delta[idim]*inv2Sigma2;
-      }
+  stage.load(movingBeads,sectionBeads,index,level,0);
+  for (int iMoving=0; iMoving<nMoving; ++iMoving) {
+    double sigma = sqrt(lambda(index(iMoving))*tau*nStride);
+    double inv2Sigma2 = 0.5/(sigma*sigma);
+    for (int idim=0;idim<4;++idim) {
+      stage.setSigma(iMoving,idim,sigma,inv2Sigma2);
     }
   }
+  double toldOverTnew=stage.sample();
+  stage.store(movingBeads);
   toldOverTnew=exp(toldOverTnew);
   return toldOverTnew*freeMover.makeMove(sampler,level);
 }
@@ -21,6 +21,7 @@
 #include <vector>
 #include "advancer/mover/Mover.h"
 #include "advancer/mover/FreeMover.h"
+#include "advancer/mover/BisectionStage.h"
 class SimulationInfo;
 /** Select a trial move for beads by free particle sampling.
   * @todo May want to make this a subclass of Action, with a flag
@@ -54,5 +55,7 @@ private:
   Array lambda;
   /// The timestep.
   double tau;
+  /// Staging buffer for the bisection moves of a level.
+  BisectionStage<4> stage;
 };
 #endif
@@ -37,7 +37,7 @@ double SpinMover::makeMove(MultiLevelSampler& sampler, const int level) {
   const int nSlice=sectionBeads.getNSlice();
   const blitz::Array<int,1>& index=sampler.getMovingIndex(); 
   const int nMoving=index.size();
-  blitz::Array<SVec,1> gaussRand(nMoving);
+  gaussRand.resize(nMoving);
   double toldOverTnew=0;
   for (int islice=nStride; islice<nSlice-nStride; islice+=2*nStride) {
     RandomNumGenerator::makeGaussRand(gaussRand);
@@ -53,5 +53,7 @@ private:
   Array lambda;
   /// The timestep.
   double tau;
+  /// Gaussian random numbers, reused between moves.
+  blitz::Array<SVec,1> gaussRand;
 };
 #endif
@@ -25,6 +25,19 @@ public:
     virtual const void* getData() const=0;
     virtual const void* getError() const=0;
 
+    /// Sparse estimators store only occupied tiles of the array,
+    /// and getData and getError return null.
+    virtual bool isSparse() const {return false;}
+    virtual int getTileExtent(const int idim) const {return getExtent(idim);}
+    virtual int getNTile() const {return 1;}
+    virtual void getTileOrigin(const int itile, int *origin) const {
+        for (int i=0; i<getNDim(); ++i) origin[i]=0;
+    }
+    virtual const void* getTileData(const int itile) const {return getData();}
+    virtual const void* getTileError(const int itile) const {
+        return getError();
+    }
+
     bool hasError() const;
     virtual bool hasScale() const=0;
     virtual bool hasOrigin() const=0;
@@ -3,21 +3,29 @@
 #include "ArrayEstimator.h"
 #include "EstimatorReportBuilder.h"
 #include "MPIManager.h"
+#include "util/TiledArray.h"
 #include <cstdlib>
 #include <blitz/array.h>
 #include <blitz/tinyvec-et.h>
 class Paths;
 
+/// Blocked array estimator with blitz arrays.
+/// In sparse mode the value and accumulators are TiledArrays instead of
+/// dense arrays, so only tiles that have been hit take memory.
 template<int N>
 class BlitzArrayBlkdEst: public ArrayEstimator {
 public:
     typedef blitz::Array<float, N> ArrayN;
     typedef blitz::TinyVector<int, N> IVecN;
     typedef blitz::TinyVector<double, N> VecN;
+    typedef TiledArray<float, N> TiledArrayN;
 
     BlitzArrayBlkdEst(const std::string &name, const std::string &typeString,
-            const IVecN &n, bool hasError);
+            const IVecN &n, bool hasError, bool sparse = false);
     virtual ~BlitzArrayBlkdEst() {
+        delete sparseValue;
+        delete sparseAccum;
+        delete sparseAccum2;
     }
 
     virtual void reset()=0;
@@ -30,14 +38,47 @@ public:
         return n(idim);
     }
     virtual const void* getData() const {
-        return accumvalue.data();
+        return sparseValue ? (float*) 0 : accumvalue.data();
     }
 
     virtual const void* getError() const {
-        return hasErrorFlag ? accumvalue2.data() : (float*) 0;
+        return (hasErrorFlag && !sparseValue) ? accumvalue2.data() : (float*) 0;
+    }
+
+    virtual bool isSparse() const {
+        return sparseValue != 0;
+    }
+
+    virtual int getTileExtent(const int idim) const {
+        return sparseValue ? sparseAccum->getTileExtent(idim) : n(idim);
+    }
+
+    virtual int getNTile() const {
+        return sparseValue ? sparseAccum->getNTile() : 1;
+    }
+
+    virtual void getTileOrigin(const int itile, int *origin) const {
+        for (int i = 0; i < N; ++i)
+            origin[i] = sparseValue ? sparseAccum->getTileOrigin(itile)[i] : 0;
+    }
+
+    virtual const void* getTileData(const int itile) const {
+        return sparseValue ? sparseAccum->getTileData(itile) : getData();
+    }
+
+    virtual const void* getTileError(const int itile) const {
+        if (!sparseValue)
+            return getError();
+        return hasErrorFlag ?
+                sparseAccum2->findTile(sparseAccum->getTileIndex(itile)) :
+                (float*) 0;
     }
 
     virtual void normalize() const {
+        if (sparseValue) {
+            transformTiles(true);
+            return;
+        }
         accumvalue /= accumnorm; //Temporarily normalize the data to write it out.
         if (hasErrorFlag) { //Temperorily convert accumvalue2 into rms error.
             accumvalue2 /= accumnorm;
@@ -47,6 +88,10 @@ public:
     }
 
     virtual void unnormalize() const {
+        if (sparseValue) {
+            transformTiles(false);
+            return;
+        }
         if (hasErrorFlag) {
             accumvalue2 *= accumvalue2 * iblock;
             accumvalue2 += accumvalue * accumvalue;
@@ -98,26 +143,109 @@ protected:
     VecN* origin;
     VecN* min;
     VecN* max;
+    /// Sparse storage, or null for dense estimators.
+    TiledArrayN *sparseValue, *sparseAccum, *sparseAccum2;
+#ifdef ENABLE_MPI
+    /// Sum the tiles of a sparse array onto rank 0 of a communicator.
+    static void reduceTiles(TiledArrayN& array, const MPI::Intracomm& comm);
+#endif
+private:
+    /// Normalize or unnormalize the occupied tiles in place.
+    void transformTiles(bool forward) const;
 };
 
 template<int N>
 BlitzArrayBlkdEst<N>::BlitzArrayBlkdEst(const std::string& name,
-        const std::string& typeString, const IVecN& n, bool hasError) :
-        ArrayEstimator(name, typeString, hasError), n(n), value(n), accumvalue(
-                n), accumvalue2(hasError ? n : n * 0), norm(0), accumnorm(0), hasError(
-                hasError), iblock(0), scale(0), origin(0), min(0), max(0) {
+        const std::string& typeString, const IVecN& n, bool hasError,
+        bool sparse) :
+        ArrayEstimator(name, typeString, hasError), n(n),
+        value(sparse ? n * 0 : n), accumvalue(sparse ? n * 0 : n),
+        accumvalue2((hasError && !sparse) ? n : n * 0), norm(0), accumnorm(0),
+        hasError(hasError), iblock(0), scale(0), origin(0), min(0), max(0),
+        sparseValue(sparse ? new TiledArrayN(n) : 0),
+        sparseAccum(sparse ? new TiledArrayN(n) : 0),
+        sparseAccum2((sparse && hasError) ? new TiledArrayN(n) : 0) {
     value = 0;
     accumvalue = 0;
     accumvalue2 = 0;
 }
 
+template<int N>
+void BlitzArrayBlkdEst<N>::transformTiles(bool forward) const {
+    const long volume = sparseAccum->getTileVolume();
+    for (int itile = 0; itile < sparseAccum->getNTile(); ++itile) {
+        float *a = sparseAccum->getTileData(itile);
+        float *a2 = hasErrorFlag ?
+                sparseAccum2->findTile(sparseAccum->getTileIndex(itile)) : 0;
+        for (long k = 0; k < volume; ++k) {
+            if (forward) {
+                a[k] /= accumnorm;
+                if (a2) {
+                    a2[k] /= accumnorm;
+                    a2[k] -= a[k] * a[k];
+                    a2[k] = sqrt(fabs(a2[k] / iblock));
+                }
+            } else {
+                if (a2) {
+                    a2[k] *= a2[k] * iblock;
+                    a2[k] += a[k] * a[k];
+                    a2[k] *= accumnorm;
+                }
+                a[k] *= accumnorm;
+            }
+        }
+    }
+}
+
+#ifdef ENABLE_MPI
+template<int N>
+void BlitzArrayBlkdEst<N>::reduceTiles(TiledArrayN& array,
+        const MPI::Intracomm& comm) {
+    const int rank = comm.Get_rank();
+    const int size = comm.Get_size();
+    const long volume = array.getTileVolume();
+    if (rank == 0) {
+        std::vector<long> index;
+        std::vector<float> buffer;
+        for (int i = 1; i < size; ++i) {
+            int ntile = 0;
+            comm.Recv(&ntile, 1, MPI::INT, i, 0);
+            if (ntile == 0)
+                continue;
+            index.resize(ntile);
+            buffer.resize(ntile * volume);
+            comm.Recv(&index[0], ntile, MPI::LONG, i, 1);
+            comm.Recv(&buffer[0], ntile * volume, MPI::FLOAT, i, 2);
+            for (int itile = 0; itile < ntile; ++itile)
+                array.addTile(index[itile], &buffer[itile * volume]);
+        }
+    } else {
+        int ntile = array.getNTile();
+        comm.Send(&ntile, 1, MPI::INT, 0, 0);
+        if (ntile == 0)
+            return;
+        std::vector<long> index(ntile);
+        for (int itile = 0; itile < ntile; ++itile)
+            index[itile] = array.getTileIndex(itile);
+        comm.Send(&index[0], ntile, MPI::LONG, 0, 1);
+        comm.Send(array.data(), ntile * volume, MPI::FLOAT, 0, 2);
+    }
+}
+#endif
+
 template<int N>
 void BlitzArrayBlkdEst<N>::averageOverClones(const MPIManager* mpi) {
 #ifdef ENABLE_MPI
     if (mpi && mpi->isCloneMain()) {
         int rank = mpi->getCloneComm().Get_rank();
         int size = mpi->getCloneComm().Get_size();
-        if (size>1) {
+        if (size>1 && sparseValue) {
+            reset();
+            double nbuff=0;
+            mpi->getCloneComm().Reduce(&norm,&nbuff,1,MPI::DOUBLE,MPI::SUM,0);
+            if (rank==0) norm=nbuff;
+            reduceTiles(*sparseValue, mpi->getCloneComm());
+        } else if (size>1) {
             reset();
             if (rank==0) {
 #if MPI_VERSION==2
@@ -143,6 +271,25 @@ void BlitzArrayBlkdEst<N>::averageOverClones(const MPIManager* mpi) {
         }
     }
 #endif
+    if (sparseValue) {
+        // Add the occupied tiles of value to the accumulators.
+        const long volume = sparseValue->getTileVolume();
+        for (int itile = 0; itile < sparseValue->getNTile(); ++itile) {
+            const long index = sparseValue->getTileIndex(itile);
+            const float *v = sparseValue->getTileData(itile);
+            sparseAccum->addTile(index, v, 1. / norm);
+            if (hasErrorFlag) {
+                float *a2 = sparseAccum2->getTile(index);
+                for (long k = 0; k < volume; ++k)
+                    a2[k] += (v[k] * v[k]) / (norm * norm);
+            }
+        }
+        sparseValue->zero();
+        accumnorm += 1.;
+        norm = 0;
+        ++iblock;
+        return;
+    }
     // Next add value to accumvalue and accumvalue2.
     accumvalue += value / norm;
     if (hasErrorFlag)
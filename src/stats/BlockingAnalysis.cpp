@@ -0,0 +1,79 @@
+#include "BlockingAnalysis.h"
+#include <cmath>
+
+BlockingAnalysis::BlockingAnalysis() {
+}
+
+void BlockingAnalysis::addSample(double x) {
+    for (unsigned int level = 0; ; ++level) {
+        if (level == sum.size()) {
+            sum.push_back(0.0);
+            sum2.push_back(0.0);
+            count.push_back(0);
+            pending.push_back(0.0);
+            hasPending.push_back(false);
+        }
+        sum[level] += x;
+        sum2[level] += x * x;
+        ++count[level];
+        if (!hasPending[level]) {
+            pending[level] = x;
+            hasPending[level] = true;
+            break;
+        }
+        x = 0.5 * (pending[level] + x);
+        hasPending[level] = false;
+    }
+}
+
+void BlockingAnalysis::reset() {
+    sum.clear();
+    sum2.clear();
+    count.clear();
+    pending.clear();
+    hasPending.clear();
+}
+
+int BlockingAnalysis::getSampleCount() const {
+    return count.empty() ? 0 : count[0];
+}
+
+double BlockingAnalysis::getMean() const {
+    return count.empty() ? 0.0 : sum[0] / count[0];
+}
+
+double BlockingAnalysis::getNaiveVariance() const {
+    return getLevelVariance(0);
+}
+
+double BlockingAnalysis::getVariance() const {
+    double variance = getLevelVariance(0);
+    for (unsigned int level = 1; level < count.size(); ++level) {
+        if (count[level] < MIN_BLOCK_COUNT) break;
+        double levelVariance = getLevelVariance(level);
+        if (levelVariance > variance) variance = levelVariance;
+    }
+    return variance;
+}
+
+double BlockingAnalysis::getError() const {
+    return std::sqrt(getVariance());
+}
+
+double BlockingAnalysis::getAutocorrelationTime() const {
+    double naiveVariance = getNaiveVariance();
+    return (naiveVariance > 0.0) ? getVariance() / naiveVariance : 1.0;
+}
+
+double BlockingAnalysis::getEffectiveSampleCount() const {
+    return getSampleCount() / getAutocorrelationTime();
+}
+
+double BlockingAnalysis::getLevelVariance(int level) const {
+    if (level >= (int)count.size() || count[level] < 2) return 0.0;
+    double n = count[level];
+    double mean = sum[level] / n;
+    double variance = sum2[level] / n - mean * mean;
+    if (variance < 0.0) variance = 0.0;
+    return variance / (n - 1);
+}
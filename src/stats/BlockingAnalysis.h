@@ -0,0 +1,44 @@
+#ifndef BLOCKINGANALYSIS_H_
+#define BLOCKINGANALYSIS_H_
+
+#include <vector>
+
+/** Online Flyvbjerg-Petersen blocking analysis of a correlated series.
+
+ Each level k holds the running sums of block averages over 2^k
+ consecutive samples, so the state grows as O(log n). The error of the
+ mean is taken from the largest variance estimate among the levels
+ that still have enough blocks to be trusted.
+
+ The integrated autocorrelation time is reported as the statistical
+ inefficiency, tau = 1 + 2 sum_t rho(t), so that the effective number
+ of independent samples is n/tau. */
+class BlockingAnalysis {
+public:
+    BlockingAnalysis();
+
+    void addSample(double x);
+    void reset();
+
+    int getSampleCount() const;
+    double getMean() const;
+    /// Variance of the mean assuming uncorrelated samples.
+    double getNaiveVariance() const;
+    /// Variance of the mean from the blocked levels.
+    double getVariance() const;
+    double getError() const;
+    double getAutocorrelationTime() const;
+    double getEffectiveSampleCount() const;
+
+    /// Minimum number of blocks for a level to enter the error estimate.
+    static const int MIN_BLOCK_COUNT = 16;
+private:
+    std::vector<double> sum;
+    std::vector<double> sum2;
+    std::vector<int> count;
+    std::vector<double> pending;
+    std::vector<bool> hasPending;
+    double getLevelVariance(int level) const;
+};
+
+#endif
@@ -5,6 +5,9 @@
 class MPIManager;
 class PartitionWeight;
 
+/** Accumulator for a scalar split over the partitions of a weight.
+ *  It keeps no blocking analysis, so hasError stays false and it reports
+ *  no blocked error; only SimpleScalarAccumulator does. */
 class PartitionedScalarAccumulator : public ScalarAccumulator {
 public:
     PartitionedScalarAccumulator(MPIManager *mpi,
@@ -15,6 +15,11 @@ public:
     virtual void calculateTotal() = 0;
     virtual void reset() = 0;
 
+    /// True once the accumulator has enough data for a run error bar.
+    virtual bool hasError() const {return false;}
+    virtual double getMean() const {return 0.0;}
+    virtual double getError() const {return 0.0;}
+
     virtual void startReport(ReportWriters* writers,
             ScalarEstimator* estimator) = 0;
     virtual void reportStep(ReportWriters* writers,
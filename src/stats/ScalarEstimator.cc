@@ -6,6 +6,7 @@
 #include "MPIManager.h"
 #include "ReportWriters.h"
 #include "ScalarAccumulator.h"
+#include <cmath>
 
 ScalarEstimator::ScalarEstimator(const std::string& name)
     :   Estimator(name,"","scalar"),
@@ -54,6 +55,18 @@ void ScalarEstimator::averageOverClones(const MPIManager* mpi) {
     }
 }
 
+bool ScalarEstimator::hasError() const {
+    return accumulator && accumulator->hasError();
+}
+
+double ScalarEstimator::getMean() const {
+    return accumulator ? scale * (accumulator->getMean() + shift) : getValue();
+}
+
+double ScalarEstimator::getError() const {
+    return accumulator ? fabs(scale) * accumulator->getError() : 0.0;
+}
+
 void ScalarEstimator::startReport(ReportWriters *writers) {
     if (accumulator) {
         accumulator->startReport(writers, this);
@@ -22,6 +22,11 @@ public:
     virtual void reset()=0;
     virtual void averageOverClones(const MPIManager* mpi);
 
+    /// Run average and blocked error, if the accumulator tracks them.
+    bool hasError() const;
+    double getMean() const;
+    double getError() const;
+
     virtual void startReport(ReportWriters* writers);
     virtual void reportStep(ReportWriters* writers);
 
@@ -5,9 +5,16 @@
 #endif
 #include "MPIManager.h"
 #include "ReportWriters.h"
+#include <cmath>
 
 SimpleScalarAccumulator::SimpleScalarAccumulator(MPIManager *mpi)
-:   mpi(mpi) {
+:   mpi(mpi),
+    startClock(std::clock()),
+    mean(0.0),
+    variance(0.0),
+    sampleCount(0.0),
+    effectiveSampleCount(0.0),
+    cpuTime(0.0) {
     reset();
 }
 
@@ -33,12 +40,25 @@ void SimpleScalarAccumulator::storeValue(const int lnslice) {
     }
 #endif
     value /= nslice;
+    blocking.addSample(value);
     sum += value;
     norm += 1.0;
 }
 
 void SimpleScalarAccumulator::calculateTotal() {
     value = sum / norm;
+    mean = blocking.getMean();
+    variance = blocking.getVariance();
+    sampleCount = blocking.getSampleCount();
+    effectiveSampleCount = blocking.getEffectiveSampleCount();
+    cpuTime = double(std::clock() - startClock) / CLOCKS_PER_SEC;
+#ifdef ENABLE_MPI
+    if (mpi) {
+        double buffer;
+        mpi->getWorkerComm().Reduce(&cpuTime,&buffer,1,MPI::DOUBLE,MPI::SUM,0);
+        cpuTime = buffer;
+    }
+#endif
 }
 
 void SimpleScalarAccumulator::reset() {
@@ -58,12 +78,47 @@ void SimpleScalarAccumulator::averageOverClones() {
 #ifdef ENABLE_MPI
     double v = value;
     mpi->getCloneComm().Reduce(&v,&value,1,MPI::DOUBLE,MPI::SUM,0);
+    double stats[5]
+        = {mean, variance, sampleCount, effectiveSampleCount, cpuTime};
+    double buffer[5];
+    mpi->getCloneComm().Reduce(stats,buffer,5,MPI::DOUBLE,MPI::SUM,0);
     if (mpi->isCloneMain()) {
-        value /= mpi->getNClone();
+        int nclone = mpi->getNClone();
+        value /= nclone;
+        mean = buffer[0] / nclone;
+        variance = buffer[1] / (nclone * nclone);
+        sampleCount = buffer[2];
+        effectiveSampleCount = buffer[3];
+        cpuTime = buffer[4];
     }
 #endif
 }
 
+bool SimpleScalarAccumulator::hasError() const {
+    return sampleCount >= 2 * BlockingAnalysis::MIN_BLOCK_COUNT;
+}
+
+double SimpleScalarAccumulator::getMean() const {
+    return mean;
+}
+
+double SimpleScalarAccumulator::getError() const {
+    return std::sqrt(variance);
+}
+
+double SimpleScalarAccumulator::getAutocorrelationTime() const {
+    return (effectiveSampleCount > 0.0)
+            ? sampleCount / effectiveSampleCount : 1.0;
+}
+
+double SimpleScalarAccumulator::getEffectiveSampleCount() const {
+    return effectiveSampleCount;
+}
+
+double SimpleScalarAccumulator::getEffectiveSamplesPerCPUSecond() const {
+    return (cpuTime > 0.0) ? effectiveSampleCount / cpuTime : 0.0;
+}
+
 void SimpleScalarAccumulator::reportStep(ReportWriters* writers,
         ScalarEstimator* estimator) {
     writers->reportScalarStep(estimator, this);
@@ -2,6 +2,8 @@
 #define SIMPLESCALARACUMULATOR_H_
 
 #include "ScalarAccumulator.h"
+#include "BlockingAnalysis.h"
+#include <ctime>
 class MPIManager;
 
 class SimpleScalarAccumulator : public ScalarAccumulator {
@@ -16,6 +18,14 @@ public:
     virtual void reset();
     double getValue() const;
 
+    /// Run average and its blocked error, combined over clones.
+    virtual bool hasError() const;
+    virtual double getMean() const;
+    virtual double getError() const;
+    double getAutocorrelationTime() const;
+    double getEffectiveSampleCount() const;
+    double getEffectiveSamplesPerCPUSecond() const;
+
     virtual void startReport(ReportWriters* writers,
             ScalarEstimator* estimator);
     virtual void reportStep(ReportWriters* writers,
@@ -25,6 +35,13 @@ private:
     double sum;
     double norm;
     MPIManager *mpi;
+    BlockingAnalysis blocking;
+    std::clock_t startClock;
+    double mean;
+    double variance;
+    double sampleCount;
+    double effectiveSampleCount;
+    double cpuTime;
 };
 
 #endif
@@ -23,13 +23,23 @@ void H5ArrayReportWriter::startReport(const ArrayEstimator *est,
         }
     }
     hid_t dataSpaceID = H5Screate_simple(est->getNDim(), dims, NULL);
-    bool useCompression = (size > 10000);
+    bool useCompression = (size > 10000) || est->isSparse();
     hid_t plist = H5P_DEFAULT;
     if (useCompression) {
         plist = H5Pcreate(H5P_DATASET_CREATE);
-        dims[imaxDim] = dims[imaxDim] * 10000 / size;
-        if (dims[imaxDim] == 0)
-            dims[imaxDim] = 1;
+        if (est->isSparse()) {
+            // One chunk per tile, so chunks for empty tiles are never
+            // allocated and read back as zero.
+            for (int i = 0; i < est->getNDim(); ++i)
+                dims[i] = est->getTileExtent(i);
+            float zero = 0.;
+            H5Pset_fill_value(plist, H5T_NATIVE_FLOAT, &zero);
+            H5Pset_alloc_time(plist, H5D_ALLOC_TIME_INCR);
+        } else {
+            dims[imaxDim] = dims[imaxDim] * 10000 / size;
+            if (dims[imaxDim] == 0)
+                dims[imaxDim] = 1;
+        }
         H5Pset_chunk(plist, est->getNDim(), dims);
         H5Pset_deflate(plist, 1);
     }
@@ -137,6 +147,16 @@ void H5ArrayReportWriter::startReport(const ArrayEstimator *est,
 void H5ArrayReportWriter::reportStep(const ArrayEstimator *est,
         const ScalarAccumulator *acc) {
     est->normalize();
+    if (est->isSparse()) {
+        writeTiles(*dset, est, false);
+        dset++;
+        if (est->hasError()) {
+            writeTiles(*dset, est, true);
+            dset++;
+        }
+        est->unnormalize();
+        return;
+    }
     H5Dwrite(*dset, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT,
             est->getData());
     dset++;
@@ -148,6 +168,36 @@ void H5ArrayReportWriter::reportStep(const ArrayEstimator *est,
     est->unnormalize();
 }
 
+void H5ArrayReportWriter::writeTiles(hid_t dataSetID,
+        const ArrayEstimator *est, bool error) {
+    const int ndim = est->getNDim();
+    std::vector<hsize_t> tile(ndim), start(ndim), count(ndim), zero(ndim, 0);
+    std::vector<int> origin(ndim);
+    for (int i = 0; i < ndim; ++i)
+        tile[i] = est->getTileExtent(i);
+    hid_t fileSpaceID = H5Dget_space(dataSetID);
+    hid_t memSpaceID = H5Screate_simple(ndim, &tile[0], NULL);
+    for (int itile = 0; itile < est->getNTile(); ++itile) {
+        est->getTileOrigin(itile, &origin[0]);
+        // Tiles on the upper edges may hang over the end of the array.
+        for (int i = 0; i < ndim; ++i) {
+            start[i] = origin[i];
+            count[i] = est->getExtent(i) - origin[i];
+            if (count[i] > tile[i])
+                count[i] = tile[i];
+        }
+        H5Sselect_hyperslab(fileSpaceID, H5S_SELECT_SET, &start[0], NULL,
+                &count[0], NULL);
+        H5Sselect_hyperslab(memSpaceID, H5S_SELECT_SET, &zero[0], NULL,
+                &count[0], NULL);
+        H5Dwrite(dataSetID, H5T_NATIVE_FLOAT, memSpaceID, fileSpaceID,
+                H5P_DEFAULT,
+                error ? est->getTileError(itile) : est->getTileData(itile));
+    }
+    H5Sclose(memSpaceID);
+    H5Sclose(fileSpaceID);
+}
+
 void H5ArrayReportWriter::startBlock(int istep) {
     this->istep = istep;
     dset = dataset.begin();
@@ -27,6 +27,9 @@ private:
     typedef DataSetContainer::iterator DataSetIterator;
     DataSetContainer dataset;
     DataSetIterator dset;
+
+    /// Write the occupied tiles of a sparse estimator into its chunks.
+    void writeTiles(hid_t dataSetID, const ArrayEstimator *est, bool error);
 };
 
 #endif
@@ -18,6 +18,7 @@ H5ReportBuilder::H5ReportBuilder(const std::string& filename,
     simInfoWriter(simInfoWriter),
     fileID(0),
     writingGroupID(0),
+    blockingGroupID(0),
     stepAttrID(0) {
     fileID = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT,
             H5P_DEFAULT);
@@ -33,6 +34,7 @@ void H5ReportBuilder::initializeReport(EstimatorManager *manager) {
     nstep = manager->getNStep();
     istep = 0;
     writingGroupID = H5Lib::createGroupInH5File("estimators", fileID);
+    blockingGroupID = H5Lib::createGroupInH5File("blocking", fileID);
     createReportWriters(manager);
     createStepAttribute();
     EstimatorIterator iterator = manager->getEstimatorIterator();
@@ -74,7 +76,8 @@ void H5ReportBuilder::recordInputDocument(const std::string &docstring) {
 }
 
 void H5ReportBuilder::createReportWriters(EstimatorManager*& manager) {
-    scalarWriter = new H5ScalarReportWriter(nstep, writingGroupID);
+    scalarWriter = new H5ScalarReportWriter(nstep, writingGroupID,
+            blockingGroupID);
     arrayWriter = new H5ArrayReportWriter(nstep, writingGroupID);
     partitionedScalarWriter
         = new H5PartitionedScalarReportWriter(nstep, writingGroupID);
@@ -100,5 +103,6 @@ void H5ReportBuilder::createStepAttribute() {
 void H5ReportBuilder::closeDatasets() {
     H5Aclose (stepAttrID);
     H5Gclose (writingGroupID);
+    H5Gclose (blockingGroupID);
 }
 
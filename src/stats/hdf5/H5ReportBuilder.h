@@ -40,6 +40,7 @@ private:
 
     hid_t fileID;
     hid_t writingGroupID;
+    hid_t blockingGroupID;
     hid_t stepAttrID;
 
     ReportWriters *reportWriters;
@@ -3,10 +3,13 @@
 #include "stats/ScalarEstimator.h"
 #include "stats/SimpleScalarAccumulator.h"
 #include "stats/hdf5/H5Lib.h"
+#include <cmath>
 
-H5ScalarReportWriter::H5ScalarReportWriter(int nstep, hid_t writingGroupID)
+H5ScalarReportWriter::H5ScalarReportWriter(int nstep, hid_t writingGroupID,
+        hid_t blockingGroupID)
 :   nstep(nstep),
-    writingGroupID(writingGroupID) {
+    writingGroupID(writingGroupID),
+    blockingGroupID(blockingGroupID) {
 }
 
 H5ScalarReportWriter::~H5ScalarReportWriter() {
@@ -16,11 +19,24 @@ void H5ScalarReportWriter::startReport(const ScalarEstimator *est,
         const SimpleScalarAccumulator *acc) {
     hid_t dataSetID = H5Lib::createScalarInH5File(*est, writingGroupID, nstep);
     datasetList.push_back(dataSetID);
+    if (acc) {
+        const std::string& name = est->getName();
+        blockingDatasetList.push_back(
+                H5Lib::createScalarDataset(nstep, blockingGroupID, name+"_err"));
+        blockingDatasetList.push_back(
+                H5Lib::createScalarDataset(nstep, blockingGroupID, name+"_tau"));
+        blockingDatasetList.push_back(
+                H5Lib::createScalarDataset(nstep, blockingGroupID, name+"_neff"));
+        blockingDatasetList.push_back(
+                H5Lib::createScalarDataset(nstep, blockingGroupID,
+                        name+"_neffPerCPUSecond"));
+    }
 }
 
 void H5ScalarReportWriter::startBlock(int istep) {
     this->istep = istep;
     datasetIterator = datasetList.begin();
+    blockingDatasetIterator = blockingDatasetList.begin();
 }
 
 void H5ScalarReportWriter::reportStep(const ScalarEstimator *est,
@@ -31,4 +47,14 @@ void H5ScalarReportWriter::reportStep(const ScalarEstimator *est,
     }
     H5Lib::writeScalarValue(*datasetIterator, istep, value);
     datasetIterator++;
+    if (acc) {
+        H5Lib::writeScalarValue(*blockingDatasetIterator++, istep,
+                acc->getError() * fabs(est->getScale()));
+        H5Lib::writeScalarValue(*blockingDatasetIterator++, istep,
+                acc->getAutocorrelationTime());
+        H5Lib::writeScalarValue(*blockingDatasetIterator++, istep,
+                acc->getEffectiveSampleCount());
+        H5Lib::writeScalarValue(*blockingDatasetIterator++, istep,
+                acc->getEffectiveSamplesPerCPUSecond());
+    }
 }
@@ -10,7 +10,8 @@ class SimpleScalarAccumulator;
 class H5ScalarReportWriter
 :   public ReportWriterInterface<ScalarEstimator, SimpleScalarAccumulator> {
 public:
-    H5ScalarReportWriter(int nstep, hid_t writingGroupID);
+    H5ScalarReportWriter(int nstep, hid_t writingGroupID,
+            hid_t blockingGroupID);
     virtual ~H5ScalarReportWriter();
 
     virtual void startReport(const ScalarEstimator* est,
@@ -23,11 +24,14 @@ private:
     int nstep;
     int istep;
     hid_t writingGroupID;
+    hid_t blockingGroupID;
 
     typedef std::vector<hid_t> DataSetContainer;
     typedef DataSetContainer::iterator DataSetIterator;
     DataSetContainer datasetList;
     DataSetIterator datasetIterator;
+    DataSetContainer blockingDatasetList;
+    DataSetIterator blockingDatasetIterator;
 };
 
 #endif
@@ -38,6 +38,13 @@ void StdoutScalarReportWriter::reportStep(const ScalarEstimator *est,
                     sum2(iscalar)
                             - sum(iscalar) * sum(iscalar) / (norm(iscalar)))
                     / (norm(iscalar) - 1) << std::endl;
+    if (acc) {
+        std::cout << "    blocked err=" << acc->getError() * fabs(est->getScale())
+                << ", tau=" << acc->getAutocorrelationTime()
+                << ", Neff=" << acc->getEffectiveSampleCount()
+                << ", Neff/cpu-s=" << acc->getEffectiveSamplesPerCPUSecond()
+                << std::endl;
+    }
     ++iscalar;
 }
 
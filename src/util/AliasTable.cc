@@ -0,0 +1,32 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "AliasTable.h"
+
+void AliasTable::build(const std::vector<double>& weight,
+                       int begin, int end) {
+  int n = end-begin;
+  if (n<=0) return;
+  double total = 0.;
+  for (int i=begin; i<end; ++i) total += weight[i];
+  // Vose's method: scale weights to mean one, then pair small with large.
+  small.clear(); large.clear();
+  for (int i=begin; i<end; ++i) {
+    prob[i] = weight[i]*n/total;
+    alias[i] = i;
+    if (prob[i]<1.) small.push_back(i); else large.push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    int s = small.back(); small.pop_back();
+    int l = large.back();
+    alias[s] = l;
+    prob[l] -= 1.-prob[s];
+    if (prob[l]<1.) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // Leftovers differ from one only by roundoff.
+  for (unsigned int i=0; i<small.size(); ++i) prob[small[i]] = 1.;
+  for (unsigned int i=0; i<large.size(); ++i) prob[large[i]] = 1.;
+}
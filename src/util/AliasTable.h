@@ -0,0 +1,27 @@
+#ifndef __AliasTable_h_
+#define __AliasTable_h_
+
+#include <vector>
+
+/// Walker alias tables for sampling discrete distributions in O(1).
+/// Several tables can share one object: each occupies a range
+/// [begin,end) of slots, matching a range of a weight array.
+class AliasTable {
+public:
+  /// Set the total number of slots.
+  void resize(int n) {prob.resize(n); alias.resize(n);}
+  /// Build the table for slots [begin,end) from unnormalized weights.
+  void build(const std::vector<double>& weight, int begin, int end);
+  /// Sample a slot in [begin,end) using a uniform deviate u in [0,1).
+  int sample(int begin, int end, double u) const {
+    double x = u*(end-begin);
+    int k = (int)x;
+    if (k==end-begin) k=end-begin-1;
+    return (x-k < prob[begin+k]) ? begin+k : alias[begin+k];
+  }
+private:
+  std::vector<double> prob;
+  std::vector<int> alias;
+  std::vector<int> small, large;
+};
+#endif
@@ -0,0 +1,51 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "AllocationCounter.h"
+
+#ifdef ENABLE_ALLOC_COUNT
+#include <cstdlib>
+#include <new>
+
+namespace {
+  long allocationCount = 0;
+}
+
+void* operator new(std::size_t size) {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+  ++allocationCount;
+  void *p = std::malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void *p) throw() {
+  std::free(p);
+}
+
+void operator delete[](void *p) throw() {
+  std::free(p);
+}
+
+long AllocationCounter::getCount() {
+  return allocationCount;
+}
+
+bool AllocationCounter::isEnabled() {
+  return true;
+}
+#else
+long AllocationCounter::getCount() {
+  return 0;
+}
+
+bool AllocationCounter::isEnabled() {
+  return false;
+}
+#endif
@@ -0,0 +1,16 @@
+#ifndef __AllocationCounter_h_
+#define __AllocationCounter_h_
+
+/// Debug counter of heap allocations.
+/// When configured with ENABLE_ALLOC_COUNT, the global operator new is
+/// replaced by one that counts calls, so samplers can check that a
+/// steady-state move does not touch the heap. Otherwise the count
+/// stays zero and isEnabled returns false.
+class AllocationCounter {
+public:
+  /// Number of heap allocations so far.
+  static long getCount();
+  /// True if allocations are being counted.
+  static bool isEnabled();
+};
+#endif
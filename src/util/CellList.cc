@@ -0,0 +1,80 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "CellList.h"
+#include "SuperCell.h"
+#include <cmath>
+
+CellList::CellList(const SuperCell& cell, double rcut, int npart)
+  : a(cell.a), next(npart,-1), prev(npart,-1), box(npart,-1) {
+  int nbox=1;
+  for (int idim=0; idim<NDIM; ++idim) {
+    ncell[idim]=(rcut>0)?(int)floor(a[idim]/rcut):1;
+    if (ncell[idim]<1) ncell[idim]=1;
+    nbox*=ncell[idim];
+  }
+  head.assign(nbox,-1);
+}
+
+void CellList::move(int ipart, const Vec& r) {
+  IVec ibox=getBox(r);
+  int newBox=0;
+  for (int idim=0; idim<NDIM; ++idim) newBox=newBox*ncell[idim]+ibox[idim];
+  int oldBox=box[ipart];
+  if (newBox==oldBox) return;
+  if (oldBox>=0) {
+    if (prev[ipart]>=0) next[prev[ipart]]=next[ipart];
+    else head[oldBox]=next[ipart];
+    if (next[ipart]>=0) prev[next[ipart]]=prev[ipart];
+  }
+  prev[ipart]=-1;
+  next[ipart]=head[newBox];
+  if (head[newBox]>=0) prev[head[newBox]]=ipart;
+  head[newBox]=ipart;
+  box[ipart]=newBox;
+}
+
+void CellList::clear() {
+  head.assign(head.size(),-1);
+  next.assign(next.size(),-1);
+  prev.assign(prev.size(),-1);
+  box.assign(box.size(),-1);
+}
+
+void CellList::getCandidates(const Vec& r, std::vector<int>& list) const {
+  IVec ibox=getBox(r);
+  // Boxes to search along each axis.
+  IVec first, count;
+  for (int idim=0; idim<NDIM; ++idim) {
+    if (ncell[idim]<3) {
+      first[idim]=0; count[idim]=ncell[idim];
+    } else {
+      first[idim]=ibox[idim]-1; count[idim]=3;
+    }
+  }
+  int nsearch=1;
+  for (int idim=0; idim<NDIM; ++idim) nsearch*=count[idim];
+  for (int isearch=0; isearch<nsearch; ++isearch) {
+    int rem=isearch, jbox=0;
+    IVec offset;
+    for (int idim=NDIM-1; idim>=0; --idim) {
+      offset[idim]=rem%count[idim]; rem/=count[idim];
+    }
+    for (int idim=0; idim<NDIM; ++idim) {
+      int j=(first[idim]+offset[idim]+ncell[idim])%ncell[idim];
+      jbox=jbox*ncell[idim]+j;
+    }
+    for (int j=head[jbox]; j>=0; j=next[j]) list.push_back(j);
+  }
+}
+
+CellList::IVec CellList::getBox(const Vec& r) const {
+  IVec ibox;
+  for (int idim=0; idim<NDIM; ++idim) {
+    double s=r[idim]/a[idim];
+    s-=floor(s);
+    ibox[idim]=(int)(s*ncell[idim]);
+    if (ibox[idim]>=ncell[idim]) ibox[idim]=ncell[idim]-1;
+  }
+  return ibox;
+}
@@ -0,0 +1,39 @@
+#ifndef __CellList_h_
+#define __CellList_h_
+class SuperCell;
+#include <blitz/tinyvec.h>
+#include <vector>
+
+/** Cell list for finding particles within a cutoff in a periodic cell.
+* The cell is divided into boxes at least rcut wide, and each particle
+* is kept in a doubly linked list for its box, so moving a particle to
+* a new position costs O(1). Candidate neighbors of a point are the
+* particles in its box and the adjacent boxes; callers check distances.
+* Along an axis with fewer than three boxes every box is searched, so
+* no candidate is returned twice. */
+class CellList {
+public:
+  typedef blitz::TinyVector<double,NDIM> Vec;
+  typedef blitz::TinyVector<int,NDIM> IVec;
+  /// Construct an empty list for npart particles.
+  CellList(const SuperCell&, double rcut, int npart);
+  /// Put particle ipart at position r (inserting it if not yet placed).
+  void move(int ipart, const Vec& r);
+  /// Remove all particles.
+  void clear();
+  /// Append the particles near r to list.
+  void getCandidates(const Vec& r, std::vector<int>& list) const;
+  /// Number of boxes along an axis.
+  int getNCell(int idim) const {return ncell[idim];}
+private:
+  /// Cell dimensions.
+  Vec a;
+  IVec ncell;
+  /// First particle in each box, or -1.
+  std::vector<int> head;
+  /// Links between particles in the same box, and the box of each particle.
+  std::vector<int> next, prev, box;
+  /// Box coordinates of a position.
+  IVec getBox(const Vec& r) const;
+};
+#endif
@@ -100,10 +100,7 @@ void EwaldSum::setLongRangeArray() {
 EwaldSum::~EwaldSum() {
 }
 
-double EwaldSum::evalLongRange(const VArray& r) const {
-
-  double sum=0;
-  // Set up the exponential tables
+void EwaldSum::setExponentialTables(const VArray& r) const {
 #if NDIM==3 || NDIM==2
   const Complex I(0,1);
     for (int ipart=0; ipart<npart; ++ipart) {
@@ -151,6 +148,15 @@ double EwaldSum::evalLongRange(const VArray& r) const {
     }
   }
 #endif
+#endif
+}
+
+double EwaldSum::evalLongRange(const VArray& r) const {
+
+  double sum=0;
+#if NDIM==3 || NDIM==2
+  // Set up the exponential tables
+  setExponentialTables(r);
   // Sum long range action over the k-vectors.
 #ifdef _OPENMP
 #pragma omp parallel
@@ -180,6 +186,43 @@ double EwaldSum::evalLongRange(const VArray& r) const {
    return sum*oneOver2V + selfEnergy;
 }
 
+double EwaldSum::evalLongRange(const VArray& r, VArray& force) const {
+  double sum=0;
+  force=0.;
+#if NDIM==3 || NDIM==2
+  setExponentialTables(r);
+  // First find the structure factor for each k-vector.
+  if (sk.size()!=totk) sk.resize(totk);
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:sum)
+#endif
+  for (int ikvec=0; ikvec<totk; ++ikvec) {
+    Complex csum=0.;
+    for (int jpart=0; jpart<npart; ++jpart) {
+      csum+=q(jpart)*eikr(ikvec,jpart);
+    }
+    sk(ikvec)=csum;
+    sum+=2*vk(ikvec)*norm(csum);
+  }
+  // Then the force on each particle,
+  // F_j = (2/V) q_j sum_k v(k) Im[S(k)^* exp(ik.r_j)] k.
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int jpart=0; jpart<npart; ++jpart) {
+    Vec f=0.;
+    for (int ikvec=0; ikvec<totk; ++ikvec) {
+      double a=vk(ikvec)*imag(conj(sk(ikvec))*eikr(ikvec,jpart));
+      for (int idim=0; idim<NDIM; ++idim) {
+        f[idim]+=a*kvec(ikvec)[idim]*deltak[idim];
+      }
+    }
+    force(jpart)=4*oneOver2V*q(jpart)*f;
+  }
+#endif
+  return sum*oneOver2V + selfEnergy;
+}
+
 void EwaldSum::evalSelfEnergy() {
   double Q = sum(q);
   selfEnergy = -0.5*sum(q*q)*evalFR0() + oneOver2V*evalFK0()*Q*Q;
@@ -66,6 +66,7 @@ public:
   typedef blitz::Array<Vec,1> VArray;
   typedef blitz::Array<IVec,1> IVArray;
   typedef std::complex<double> Complex;
+  typedef blitz::Array<Complex,1> CArray;
   typedef blitz::Array<Complex,2> CArray2;
   /// Constructor calcuates the k-vectors for a given rcut and kcut.
   EwaldSum(const SuperCell&, const int npart, 
@@ -88,7 +89,10 @@ public:
   Vec getkvec(int i){return kvec(i);}
 
   /// Evaluate the long range sum.
-  double evalLongRange(const VArray& r) const;
+  virtual double evalLongRange(const VArray& r) const;
+  /// Evaluate the long range sum and the force on each particle,
+  /// @f$ \mathbf{F}_j=-\nabla_j @f$ of the sum.
+  virtual double evalLongRange(const VArray& r, VArray& force) const;
   /// Evaluate the self energy using evalFR0 and evalFK0 virtual methods.
   /// You must call this function again if you change the charge array.
   void evalSelfEnergy();
@@ -127,6 +131,21 @@ protected:
   Array kvec2;
   /// Arrays to tabulate @f$e^{ik_xx},e^{ik_yy},e^{ik_zz}@f$
   mutable CArray2 eikx, eiky, eikz;
+  /// Structure factor for each k-vector, used for forces.
+  mutable CArray sk;
+  /// Fill the exponential tables for positions r.
+  void setExponentialTables(const VArray& r) const;
+  /// Get @f$ e^{i\mathbf{k}\cdot\mathbf{r}_j} @f$ from the tables.
+  Complex eikr(const int ikvec, const int jpart) const {
+#if NDIM==3
+    return eikx(kvec(ikvec)[0],jpart)*eiky(kvec(ikvec)[1],jpart)
+          *eikz(kvec(ikvec)[2],jpart);
+#elif NDIM==2
+    return eikx(kvec(ikvec)[0],jpart)*eiky(kvec(ikvec)[1],jpart);
+#else
+    return 1.;
+#endif
+  }
   /// Calculate the long range part.
   double calcLongRangeUtau(VArray& r) const;
   /// The prefactor on the k-space sum, 1/2V.
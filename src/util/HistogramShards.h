@@ -0,0 +1,104 @@
+#ifndef __HistogramShards_h_
+#define __HistogramShards_h_
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <cstdlib>
+#include <iostream>
+#include <blitz/array.h>
+#include <vector>
+
+/// Private per-thread copies of a histogram for threaded sumOverLinks.
+/// Shard 0 is the target histogram itself, so a single thread (or a
+/// build without OpenMP) writes straight into it. The other shards
+/// live in cache-line aligned storage so threads never share a line.
+/// Call init before the links are summed, have each thread increment
+/// get(), and call reduce to add the shards into the target with a
+/// pairwise tree, parallel over blocks of bins.
+template <class T, int N>
+class HistogramShards {
+public:
+  typedef blitz::Array<T,N> ArrayN;
+  HistogramShards() : size(0), capacity(0), shape(0) {}
+  ~HistogramShards() {clear();}
+  /// Set up zeroed shards for each thread, using target as shard 0.
+  void init(ArrayN& target) {
+    int nthread=1;
+#ifdef _OPENMP
+    nthread=omp_get_max_threads();
+#endif
+    size=target.size();
+    // Round up so each shard starts on its own cache line.
+    const long stride=((size*sizeof(T)+LINE-1)/LINE)*LINE/sizeof(T);
+    bool sameShape=true;
+    for (int i=0; i<N; ++i) sameShape=sameShape&&(target.extent(i)==shape[i]);
+    if ((int)shard.size()!=nthread || !sameShape) {
+      clear();
+      capacity=stride;
+      shape=target.shape();
+      shard.push_back(0);
+      for (int i=1; i<nthread; ++i) {
+        void *p=0;
+        if (posix_memalign(&p,LINE,capacity*sizeof(T))!=0) {
+          std::cout << "ERROR: could not allocate histogram shards"
+                    << std::endl;
+          exit(-1);
+        }
+        storage.push_back(static_cast<T*>(p));
+        shard.push_back(new ArrayN(static_cast<T*>(p),shape,
+                                   blitz::neverDeleteData));
+      }
+    }
+    delete shard[0];
+    shard[0]=new ArrayN(target);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i=1; i<(int)shard.size(); ++i) *shard[i]=0;
+  }
+  /// Get the shard of the calling thread.
+  ArrayN& get() {
+#ifdef _OPENMP
+    return *shard[omp_get_thread_num()];
+#else
+    return *shard[0];
+#endif
+  }
+  /// Add all shards into the target.
+  void reduce() {
+    const int nshard=shard.size();
+    if (nshard<2) return;
+    const long nblock=(size+BLOCK-1)/BLOCK;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long iblock=0; iblock<nblock; ++iblock) {
+      const long begin=iblock*BLOCK;
+      const long end=(begin+BLOCK<size)?begin+BLOCK:size;
+      for (int step=1; step<nshard; step*=2) {
+        for (int i=0; i+step<nshard; i+=2*step) {
+          T *a=shard[i]->data();
+          const T *b=shard[i+step]->data();
+          for (long k=begin; k<end; ++k) a[k]+=b[k];
+        }
+      }
+    }
+  }
+private:
+  static const int LINE=64;
+  static const long BLOCK=4096;
+  long size, capacity;
+  blitz::TinyVector<int,N> shape;
+  std::vector<ArrayN*> shard;
+  std::vector<T*> storage;
+  void clear() {
+    for (unsigned int i=0; i<shard.size(); ++i) delete shard[i];
+    for (unsigned int i=0; i<storage.size(); ++i) free(storage[i]);
+    shard.clear();
+    storage.clear();
+  }
+};
+#endif
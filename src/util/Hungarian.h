@@ -1,22 +1,55 @@
 #ifndef HUNGARIAN_H_
 #define HUNGARIAN_H_
 
+#include <vector>
+
+/** Solver for the linear assignment problem.
+* Finds the assignment k of rows to columns that minimizes
+* @f$\sum_i a_{i,k(i)}@f$ for a square column-major cost matrix, using
+* shortest augmenting paths with row and column potentials
+* (the Jonker-Volgenant form of the Hungarian method).
+*
+* All work space belongs to the object, so separate instances can be used
+* from separate threads. The column potentials are kept between calls,
+* shifted to a maximum of zero so they do not drift over a long run:
+* solve(matrix, guess) starts from them and from a guessed assignment,
+* such as the one for the previous slice or move. Guessed pairs that are
+* still optimal with respect to the potentials are kept and only the
+* remaining rows are augmented, so an unchanged assignment costs
+* @f$O(N^2)@f$ instead of @f$O(N^3)@f$. */
 class Hungarian {
 public:
     Hungarian(int size);
     ~Hungarian();
+    /// Column assigned to a row.
     int operator[](int index) const;
-    void solve(double *matrix);
+    /// Solve from scratch.
+    void solve(const double *matrix);
+    /// Solve starting from a guessed assignment (guess[row]=column).
+    void solve(const double *matrix, const int *guess);
+    /// Total cost of the assignment.
     double getSum() const;
+    /// Number of rows augmented in the last solve (zero if the
+    /// guess was optimal).
+    int getAugmentCount() const;
 private:
     int size;
-    static const int MODE;
-    int *kindex;
-    int *work;
     double sum;
-    void assndx(const int *mode, double *a, int *n,
-        int *m, int *ida, int *k, double *sum, int *iw,
-        int *idw);
+    int augmentCount;
+    /// Assignment of rows to columns.
+    std::vector<int> kindex;
+    /// Row (plus one) assigned to column j-1 in colRow[j]; colRow[0] is
+    /// the row being augmented.
+    std::vector<int> colRow;
+    /// Row and column potentials, offset by one like colRow.
+    std::vector<double> u, v;
+    /// Work space for the shortest path search.
+    std::vector<double> minv;
+    std::vector<int> way;
+    std::vector<bool> used;
+    std::vector<int> freeRows;
+    void assign(const double *matrix, const int *guess);
+    void augment(const double *matrix, int irow);
 };
 
 #endif
@@ -0,0 +1,194 @@
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "PMEEwaldSum.h"
+#include <cmath>
+#include <iostream>
+#include "util/SuperCell.h"
+#include <blitz/tinyvec-et.h>
+
+PMEEwaldSum::PMEEwaldSum(const SuperCell& cell, int npart,
+  double rcut, double kcut, double khalo, int npoly, int order,
+  double meshFactor)
+  : OptEwaldSum(cell, npart, rcut, kcut, khalo, npoly), order(order),
+    offset(npart,NDIM,order), theta(npart,NDIM,order),
+    dtheta(npart,NDIM,order) {
+  if (order<2) {
+    std::cout << "ERROR: PME spline order must be at least 2" << std::endl;
+    exit(-1);
+  }
+  nreal=1;
+  for (int idim=0; idim<NDIM; ++idim) {
+    int n=(int)ceil(meshFactor*(2*ikmax[idim]+1));
+    if (n<2*ikmax[idim]+1) n=2*ikmax[idim]+1;
+    if (n<order) n=order;
+    nmesh[idim]=goodSize(n);
+    nreal*=nmesh[idim];
+  }
+  ncomplex=nreal/nmesh[NDIM-1]*(nmesh[NDIM-1]/2+1);
+  std::cout << "PME: mesh=" << nmesh << ", order=" << order << std::endl;
+  mesh=(double*)fftw_malloc(sizeof(double)*nreal);
+  kmesh=(fftw_complex*)fftw_malloc(sizeof(fftw_complex)*ncomplex);
+  forwardPlan=fftw_plan_dft_r2c(NDIM, nmesh.data(), mesh, kmesh, FFTW_MEASURE);
+  reversePlan=fftw_plan_dft_c2r(NDIM, nmesh.data(), kmesh, mesh, FFTW_MEASURE);
+  // B-spline moduli, 1/|sum_k M_p(k+1) exp(2 pi i m k/K)|^2, for each dim.
+  std::vector<double> w(order), dw(order);
+  evalSpline(0., order, &w[0], &dw[0]);
+  std::vector<Array> bmod2(NDIM);
+  for (int idim=0; idim<NDIM; ++idim) {
+    const int n=nmesh[idim];
+    bmod2[idim].resize(n);
+    for (int m=0; m<n; ++m) {
+      Complex sum=0.;
+      for (int k=0; k<order-1; ++k) {
+        sum+=w[k+1]*exp(Complex(0.,2*PI*m*k/n));
+      }
+      // Odd orders have a zero at the Nyquist frequency, where f(k)=0 anyway.
+      bmod2[idim](m)=(norm(sum)>1e-10)?1./norm(sum):0.;
+    }
+  }
+  // Influence function on the complex mesh (last index runs to K/2).
+  influence.resize(ncomplex);
+  weight.resize(ncomplex);
+  const int nlast=nmesh[NDIM-1]/2+1;
+  for (int ic=0; ic<ncomplex; ++ic) {
+    int rem=ic;
+    double k2=0., g=1.;
+    int mlast=0;
+    for (int idim=NDIM-1; idim>=0; --idim) {
+      const int n=nmesh[idim];
+      int m=rem%((idim==NDIM-1)?nlast:n);
+      rem/=((idim==NDIM-1)?nlast:n);
+      if (idim==NDIM-1) mlast=m;
+      g*=bmod2[idim](m);
+      if (2*m>n) m-=n;
+      k2+=m*m*deltak[idim]*deltak[idim];
+    }
+    influence(ic)=(k2>0 && k2<kcut*kcut)?evalFK(sqrt(k2))*g:0.;
+    weight(ic)=(mlast==0 || 2*mlast==nmesh[NDIM-1])?1.:2.;
+  }
+}
+
+PMEEwaldSum::~PMEEwaldSum() {
+  fftw_destroy_plan(forwardPlan);
+  fftw_destroy_plan(reversePlan);
+  fftw_free(mesh);
+  fftw_free(kmesh);
+}
+
+double PMEEwaldSum::evalLongRange(const VArray& r) const {
+  spread(r);
+  return transform()*oneOver2V + selfEnergy;
+}
+
+double PMEEwaldSum::evalLongRange(const VArray& r, VArray& force) const {
+  spread(r);
+  double sum=transform();
+  // Convolve the charges with the influence function.
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int ic=0; ic<ncomplex; ++ic) {
+    kmesh[ic][0]*=influence(ic);
+    kmesh[ic][1]*=influence(ic);
+  }
+  fftw_execute(reversePlan);
+  // Interpolate -dE/dr from the convolved mesh with the spline derivatives.
+  const int npoint=(int)pow((double)order,NDIM);
+  Vec scale;
+  for (int idim=0; idim<NDIM; ++idim) scale[idim]=nmesh[idim]/cell.a[idim];
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int ipart=0; ipart<npart; ++ipart) {
+    Vec f=0.;
+    for (int ipoint=0; ipoint<npoint; ++ipoint) {
+      int j[NDIM];
+      int rem=ipoint, k=0;
+      for (int idim=NDIM-1; idim>=0; --idim) {
+        j[idim]=rem%order; rem/=order;
+        k+=offset(ipart,idim,j[idim]);
+      }
+      for (int idim=0; idim<NDIM; ++idim) {
+        double g=mesh[k]*dtheta(ipart,idim,j[idim]);
+        for (int jdim=0; jdim<NDIM; ++jdim) {
+          if (jdim!=idim) g*=theta(ipart,jdim,j[jdim]);
+        }
+        f[idim]+=g;
+      }
+    }
+    force(ipart)=-2*oneOver2V*q(ipart)*f*scale;
+  }
+  return sum*oneOver2V + selfEnergy;
+}
+
+void PMEEwaldSum::spread(const VArray& r) const {
+  for (int i=0; i<nreal; ++i) mesh[i]=0.;
+  const int npoint=(int)pow((double)order,NDIM);
+  for (int ipart=0; ipart<npart; ++ipart) {
+    int stride=1;
+    for (int idim=NDIM-1; idim>=0; --idim) {
+      const int n=nmesh[idim];
+      double s=r(ipart)[idim]/cell.a[idim];
+      double u=n*(s-floor(s));
+      int base=(int)floor(u);
+      evalSpline(u-base, order, &theta(ipart,idim,0), &dtheta(ipart,idim,0));
+      // Spline point j sits on mesh point base-j.
+      for (int j=0; j<order; ++j) {
+        offset(ipart,idim,j)=(((base-j)%n+n)%n)*stride;
+      }
+      stride*=n;
+    }
+    for (int ipoint=0; ipoint<npoint; ++ipoint) {
+      int rem=ipoint, k=0;
+      double w=q(ipart);
+      for (int idim=NDIM-1; idim>=0; --idim) {
+        const int j=rem%order; rem/=order;
+        k+=offset(ipart,idim,j);
+        w*=theta(ipart,idim,j);
+      }
+      mesh[k]+=w;
+    }
+  }
+}
+
+double PMEEwaldSum::transform() const {
+  fftw_execute(forwardPlan);
+  double sum=0.;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:sum)
+#endif
+  for (int ic=0; ic<ncomplex; ++ic) {
+    sum+=weight(ic)*influence(ic)
+        *(kmesh[ic][0]*kmesh[ic][0]+kmesh[ic][1]*kmesh[ic][1]);
+  }
+  return sum;
+}
+
+void PMEEwaldSum::evalSpline(double f, int p, double* w, double* dw) {
+  // Recursion M_k(x)=[x M_{k-1}(x)+(k-x) M_{k-1}(x-1)]/(k-1) from
+  // M_2(f)=f, M_2(f+1)=1-f, with dM_p(x)/dx=M_{p-1}(x)-M_{p-1}(x-1).
+  for (int j=0; j<p; ++j) w[j]=0.;
+  w[0]=f; w[1]=1.-f;
+  if (p==2) {dw[0]=1.; dw[1]=-1.;}
+  for (int k=3; k<=p; ++k) {
+    if (k==p) {
+      dw[0]=w[0];
+      for (int j=1; j<p; ++j) dw[j]=w[j]-w[j-1];
+    }
+    for (int j=k-1; j>=0; --j) {
+      const double x=f+j;
+      w[j]=(x*w[j]+((j>0)?(k-x)*w[j-1]:0.))/(k-1);
+    }
+  }
+}
+
+int PMEEwaldSum::goodSize(int n) {
+  for (;;++n) {
+    int m=n;
+    while (m%2==0) m/=2;
+    while (m%3==0) m/=3;
+    while (m%5==0) m/=5;
+    if (m==1) return n;
+  }
+}
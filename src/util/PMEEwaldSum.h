@@ -0,0 +1,72 @@
+#ifndef __PMEEwaldSum
+#define __PMEEwaldSum
+class SuperCell;
+#include <blitz/array.h>
+#include <blitz/tinyvec.h>
+#include <fftw3.h>
+#include "OptEwaldSum.h"
+
+/** Smooth particle-mesh Ewald (SPME) evaluation of the optimized Ewald sum.
+The real-space function @f$f(r)@f$ and its transform @f$f(k)@f$ are
+those of OptEwaldSum, but the k-space sum is evaluated on a mesh
+(Essmann et al., J. Chem. Phys. 103, 8577 (1995)).
+Each charge is spread onto the mesh with cardinal B-splines @f$M_p@f$
+of order p, the mesh is transformed with a real-to-complex FFT, and
+@f[
+E = \frac{1}{2V}\sum_{\mathbf m} G(\mathbf m)\,|\tilde Q(\mathbf m)|^2,
+\qquad G(\mathbf m) = f(|\mathbf k|)\prod_d |b_d(m_d)|^2,
+@f]
+where the B-spline moduli @f$|b_d(m_d)|^2@f$ correct for the spreading
+and @f$G@f$ is zero outside the OptEwaldSum cutoff kcut.
+Forces come from one complex-to-real transform of @f$G\tilde Q@f$,
+interpolated back to each charge with the B-spline derivatives.
+The cost per slice is @f$O(Np^d + K\log K)@f$ for K mesh points,
+instead of the @f$O(N N_k)@f$ of the direct k-space sum.
+Each mesh dimension is the smallest FFT-friendly size
+(@f$2^a3^b5^c@f$) of at least meshFactor times the number of
+k-vectors along it, and never less than the order. */
+class PMEEwaldSum : public OptEwaldSum {
+public:
+  /// Constructor sets up the mesh, FFT plans and influence function.
+  PMEEwaldSum(const SuperCell&, int npart, double rcut, double kcut,
+    double khalo, int npoly, int order=6, double meshFactor=2.);
+  /// Virtual destructor.
+  virtual ~PMEEwaldSum();
+  /// Evaluate the long range sum on the mesh.
+  virtual double evalLongRange(const VArray& r) const;
+  /// Evaluate the long range sum and interpolated forces.
+  virtual double evalLongRange(const VArray& r, VArray& force) const;
+  /// Number of mesh points along a dimension.
+  int getMeshSize(const int idim) const {return nmesh[idim];}
+private:
+  /// Order of the B-splines.
+  const int order;
+  /// Mesh size.
+  IVec nmesh;
+  /// Number of real and complex mesh points.
+  int nreal, ncomplex;
+  /// The charge mesh, overwritten by the convolved potential.
+  double *mesh;
+  /// The transformed mesh (last dimension halved by symmetry).
+  fftw_complex *kmesh;
+  /// FFT plans.
+  fftw_plan forwardPlan, reversePlan;
+  /// Influence function on the complex mesh, including the B-spline moduli.
+  Array influence;
+  /// Weight of each complex mesh point in the energy sum, 2 for points
+  /// standing in for their mirror image in the missing half of k-space.
+  Array weight;
+  /// Offset in the real mesh of each spline point of each particle.
+  mutable blitz::Array<int,3> offset;
+  /// Spline weights and their derivatives for each particle.
+  mutable blitz::Array<double,3> theta, dtheta;
+  /// Fill the weights @f$M_p(f+j)@f$ and derivatives for j=0,...,p-1.
+  static void evalSpline(double f, int p, double* w, double* dw);
+  /// Find the spline weights and spread the charges on the mesh.
+  void spread(const VArray& r) const;
+  /// Transform the mesh and sum the energy.
+  double transform() const;
+  /// Smallest FFT-friendly size of at least n.
+  static int goodSize(int n);
+};
+#endif
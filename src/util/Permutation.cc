@@ -3,12 +3,12 @@
 #endif
 #include "Permutation.h"
 
-Permutation::Permutation(const int n) : permutation(n) {
+Permutation::Permutation(const int n) : permutation(n), scratch(n) {
   for (int i=0; i<n; ++i) permutation(i)=i;
 }
 
 Permutation::Permutation(const Permutation& p)
-  : permutation(p.permutation.copy()) {
+  : permutation(p.permutation.copy()), scratch(p.permutation.size()) {
 }
 
 Permutation& Permutation::operator=(const Permutation& p) {
@@ -21,24 +21,18 @@ void Permutation::reset() {
 }
 
 Permutation& Permutation::prepend(const Permutation& p) {
-  int *temp;
-  temp = new int[permutation.size()];
   for (int i=0; i<permutation.size(); ++i) {
-    temp[i]=permutation(p.permutation(i));
+    scratch(i)=permutation(p.permutation(i));
   }
-  for (int i=0; i<permutation.size(); ++i) permutation(i)=temp[i];
-  delete temp;
+  for (int i=0; i<permutation.size(); ++i) permutation(i)=scratch(i);
   return *this;
 }
 
 Permutation& Permutation::append(const Permutation& p) {
-  int *temp;
-  temp = new int[permutation.size()];
   for (int i=0; i<permutation.size(); ++i) {
-    temp[i]=p.permutation(permutation(i));
+    scratch(i)=p.permutation(permutation(i));
   }
-  for (int i=0; i<permutation.size(); ++i) permutation(i)=temp[i];
-  delete temp;
+  for (int i=0; i<permutation.size(); ++i) permutation(i)=scratch(i);
   return *this;
 }
 
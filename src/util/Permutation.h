@@ -36,5 +36,7 @@ public:
 private:
   /// The permutation.
   blitz::Array<int,1> permutation;
+  /// Scratch storage for prepend and append.
+  blitz::Array<int,1> scratch;
 };
 #endif
@@ -75,8 +75,9 @@ private:
   static void makeGaussRand(double* a, const int n) {
     for (int i=0; i+1<n; i+=2) {
       double temp1=1-0.9999999999*getRand(), temp2=getRand();
-      a[i]  =sqrt(-2.0*log(temp1))*cos(6.283185306*temp2);
-      a[i+1]=sqrt(-2.0*log(temp1))*sin(6.283185306*temp2);
+      double radius=sqrt(-2.0*log(temp1));
+      a[i]  =radius*cos(6.283185306*temp2);
+      a[i+1]=radius*sin(6.283185306*temp2);
     }
     if (n%2==1) {
       double temp1=1-0.9999999999*getRand(), temp2=getRand();
@@ -0,0 +1,15 @@
+#ifndef __TableReal_h_
+#define __TableReal_h_
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+/// Storage type for interpolation tables in the action hot loops.
+/// Mixed-precision builds store the tables as float to halve memory
+/// traffic; interpolation and accumulation are still done in double.
+#ifdef ENABLE_MIXED_PRECISION
+typedef float TableReal;
+#else
+typedef double TableReal;
+#endif
+#endif
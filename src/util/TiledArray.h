@@ -0,0 +1,161 @@
+#ifndef __TiledArray_h_
+#define __TiledArray_h_
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <cmath>
+#include <blitz/array.h>
+#include <vector>
+
+/// Sparse N-dimensional array stored as dense tiles that are allocated
+/// on first touch. A dense directory with one entry per tile maps each
+/// tile to its slot in a pool, so lookup costs the same as a dense array
+/// while memory only grows with the number of occupied tiles. The
+/// directory is smaller than the full array by the tile volume
+/// (about 4096 bins by default).
+template <class T, int N>
+class TiledArray {
+public:
+  typedef blitz::TinyVector<int,N> IVecN;
+  /// Construct an empty array, choosing tiles of about tileVolume bins.
+  TiledArray(const IVecN& extent, const int tileVolume=4096)
+    : extent(extent), ntileTotal(1) {
+    int edge=(int)floor(pow((double)tileVolume,1./N)+1e-9);
+    if (edge<1) edge=1;
+    volume=1;
+    for (int i=N-1; i>=0; --i) {
+      tile[i]=(extent[i]<edge)?extent[i]:edge;
+      ntile[i]=(extent[i]+tile[i]-1)/tile[i];
+      volume*=tile[i];
+      ntileTotal*=ntile[i];
+    }
+    directory.assign(ntileTotal,-1);
+  }
+  /// Get a bin, allocating its tile if needed.
+  T& operator()(const IVecN& i) {
+    long itile=0, k=0;
+    for (int idim=0; idim<N; ++idim) {
+      itile=itile*ntile[idim]+i[idim]/tile[idim];
+      k=k*tile[idim]+i[idim]%tile[idim];
+    }
+    return getTile(itile)[k];
+  }
+  /// Number of bins in each tile.
+  long getTileVolume() const {return volume;}
+  /// Extent of a tile along a dimension.
+  int getTileExtent(const int idim) const {return tile[idim];}
+  /// Number of occupied tiles.
+  int getNTile() const {return index.size();}
+  /// Directory index of an occupied tile.
+  long getTileIndex(const int islot) const {return index[islot];}
+  /// First bin of an occupied tile.
+  IVecN getTileOrigin(const int islot) const {
+    IVecN origin;
+    long itile=index[islot];
+    for (int idim=N-1; idim>=0; --idim) {
+      origin[idim]=(itile%ntile[idim])*tile[idim];
+      itile/=ntile[idim];
+    }
+    return origin;
+  }
+  /// Data of an occupied tile, in row-major order within the tile.
+  T* getTileData(const int islot) {return &pool[islot*volume];}
+  const T* getTileData(const int islot) const {return &pool[islot*volume];}
+  /// Find a tile by directory index, returning 0 if it is unoccupied.
+  T* findTile(const long itile) {
+    int islot=directory[itile];
+    return (islot<0)?0:&pool[islot*volume];
+  }
+  /// Get a tile by directory index, allocating it if needed.
+  T* getTile(const long itile) {
+    int islot=directory[itile];
+    if (islot<0) {
+      islot=directory[itile]=index.size();
+      index.push_back(itile);
+      pool.resize(pool.size()+volume,T(0));
+    }
+    return &pool[islot*volume];
+  }
+  /// All occupied bins, tile after tile.
+  T* data() {return pool.empty()?0:&pool[0];}
+  const T* data() const {return pool.empty()?0:&pool[0];}
+  /// Number of occupied bins.
+  long size() const {return pool.size();}
+  /// Zero the occupied tiles, keeping them allocated.
+  void zero() {pool.assign(pool.size(),T(0));}
+  /// Release all tiles.
+  void clear() {
+    directory.assign(ntileTotal,-1);
+    index.clear();
+    std::vector<T>().swap(pool);
+  }
+  /// Add scale times another array with the same extent.
+  void add(const TiledArray& other, const T scale=T(1)) {
+    for (int islot=0; islot<other.getNTile(); ++islot) {
+      addTile(other.getTileIndex(islot),other.getTileData(islot),scale);
+    }
+  }
+  /// Add scale times the data of one tile.
+  void addTile(const long itile, const T* tileData, const T scale=T(1)) {
+    T* p=getTile(itile);
+    for (long k=0; k<volume; ++k) p[k]+=scale*tileData[k];
+  }
+private:
+  const IVecN extent;
+  IVecN tile, ntile;
+  long volume, ntileTotal;
+  /// Slot of each tile in the pool, or -1 if unoccupied.
+  std::vector<int> directory;
+  /// Directory index of each slot.
+  std::vector<long> index;
+  /// Tile data, one tile volume per slot.
+  std::vector<T> pool;
+};
+
+/// Private per-thread copies of a TiledArray, the sparse counterpart
+/// of HistogramShards. Shard 0 is the target itself.
+template <class T, int N>
+class TiledArrayShards {
+public:
+  TiledArrayShards() {}
+  ~TiledArrayShards() {clearShards();}
+  /// Set up empty shards for each thread, using target as shard 0.
+  void init(TiledArray<T,N>& target, const typename TiledArray<T,N>::IVecN&
+            extent) {
+    int nthread=1;
+#ifdef _OPENMP
+    nthread=omp_get_max_threads();
+#endif
+    if ((int)shard.size()!=nthread) {
+      clearShards();
+      shard.push_back(0);
+      for (int i=1; i<nthread; ++i) shard.push_back(new TiledArray<T,N>(extent));
+    }
+    shard[0]=&target;
+  }
+  /// Get the shard of the calling thread.
+  TiledArray<T,N>& get() {
+#ifdef _OPENMP
+    return *shard[omp_get_thread_num()];
+#else
+    return *shard[0];
+#endif
+  }
+  /// Add all shards into the target and zero them.
+  void reduce() {
+    for (unsigned int i=1; i<shard.size(); ++i) {
+      shard[0]->add(*shard[i]);
+      shard[i]->zero();
+    }
+  }
+private:
+  std::vector<TiledArray<T,N>*> shard;
+  void clearShards() {
+    for (unsigned int i=1; i<shard.size(); ++i) delete shard[i];
+    shard.clear();
+  }
+};
+#endif
@@ -0,0 +1,76 @@
+#include "SmallLU.h"
+#include <cmath>
+
+double SmallLU::factor(double* a, int n, int* ipiv, int& sign) {
+    double logDet = 0.;
+    sign = 1;
+    for (int j = 0; j < n; ++j) {
+        int p = j;
+        double amax = fabs(a[j + j * n]);
+        for (int i = j + 1; i < n; ++i) {
+            if (fabs(a[i + j * n]) > amax) {
+                amax = fabs(a[i + j * n]);
+                p = i;
+            }
+        }
+        ipiv[j] = p;
+        if (amax == 0.) {
+            sign = 0;
+            return -HUGE_VAL;
+        }
+        if (p != j) {
+            for (int k = 0; k < n; ++k) {
+                double temp = a[j + k * n];
+                a[j + k * n] = a[p + k * n];
+                a[p + k * n] = temp;
+            }
+            sign = -sign;
+        }
+        double pivot = a[j + j * n];
+        if (pivot < 0.)
+            sign = -sign;
+        logDet += log(fabs(pivot));
+        double inverse = 1. / pivot;
+        for (int i = j + 1; i < n; ++i)
+            a[i + j * n] *= inverse;
+        // Update the trailing block one unit-stride column at a time.
+        for (int k = j + 1; k < n; ++k) {
+            double ajk = a[j + k * n];
+            if (ajk == 0.)
+                continue;
+            for (int i = j + 1; i < n; ++i)
+                a[i + k * n] -= a[i + j * n] * ajk;
+        }
+    }
+    return logDet;
+}
+
+void SmallLU::invert(double* a, int n, const int* ipiv, double* work) {
+    for (int i = 0; i < n * n; ++i)
+        work[i] = a[i];
+    for (int c = 0; c < n; ++c) {
+        double* x = a + c * n;
+        for (int i = 0; i < n; ++i)
+            x[i] = (i == c) ? 1. : 0.;
+        for (int j = 0; j < n; ++j) {
+            double temp = x[j];
+            x[j] = x[ipiv[j]];
+            x[ipiv[j]] = temp;
+        }
+        // Forward substitution with unit lower triangle.
+        for (int j = 0; j < n; ++j) {
+            double xj = x[j];
+            if (xj == 0.)
+                continue;
+            for (int i = j + 1; i < n; ++i)
+                x[i] -= work[i + j * n] * xj;
+        }
+        // Back substitution with upper triangle.
+        for (int j = n - 1; j >= 0; --j) {
+            x[j] /= work[j + j * n];
+            double xj = x[j];
+            for (int i = 0; i < j; ++i)
+                x[i] -= work[i + j * n] * xj;
+        }
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef SMALLLU_H_
+#define SMALLLU_H_
+
+/** LU factorization and inversion of small column-major matrices.
+ * For the 8-32 particle Slater matrices of node models, the overhead of
+ * a LAPACK call is comparable to the arithmetic, so these inline-friendly
+ * kernels are used when many independent matrices are factored at once.
+ * The determinant is returned as a log magnitude and a sign, so it
+ * cannot overflow or underflow.
+ */
+class SmallLU {
+public:
+    /// Factor a in place with partial pivoting, returning log|det(a)|.
+    /// Sets sign to +1 or -1, or to 0 if the matrix is singular.
+    static double factor(double* a, int n, int* ipiv, int& sign);
+    /// Replace a factored matrix with its inverse.
+    /// The work array must hold n*n doubles.
+    static void invert(double* a, int n, const int* ipiv, double* work);
+};
+
+#endif
@@ -0,0 +1,353 @@
+#include "PairDensityMatrix.h"
+#include "GridParameters.h"
+#include "KineticGrid.h"
+#include "util/math/SmallLU.h"
+#include <gsl/gsl_sf_bessel.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+PairDensityMatrix::PairDensityMatrix(double mass, double tau, double rmax,
+        double deltaR, int lmax)
+    :   mass(mass),
+        tau(tau),
+        rmax(rmax),
+        deltaR(deltaR),
+        lmax(lmax),
+        stepCount(8),
+        potential(zeroPotential),
+        radialCount((int)ceil(rmax / deltaR)),
+        bandCount(0),
+        gridCount(0),
+        blockCount(0),
+        threadCount(1),
+        value(0) {
+}
+
+PairDensityMatrix::~PairDensityMatrix() {
+    freeGrid();
+}
+
+void PairDensityMatrix::setPotential(double (*v)(double)) {
+    potential = v;
+}
+
+void PairDensityMatrix::setStepCount(int stepCount) {
+    this->stepCount = stepCount;
+}
+
+void PairDensityMatrix::setTau(double tau) {
+    this->tau = tau;
+}
+
+void PairDensityMatrix::allocateGrid() {
+    double width = GridParameters::calculateThermalWidth(mass, tau);
+    bandCount = (int)ceil(2.0 * width / deltaR) + 1;
+    gridCount = GridParameters::powerTwoCeiling(
+            2.0 * (rmax + 8.0 * width) / deltaR);
+#ifdef _OPENMP
+    threadCount = omp_get_max_threads();
+#endif
+    blockCount = (radialCount + threadCount - 1) / threadCount;
+    value = (Complex*)fftw_malloc(
+            sizeof(Complex) * gridCount * blockCount * threadCount);
+    // One plan transforms a thread's whole block of columns; the threads
+    // execute it on their own blocks with the new-array interface.
+    fftw_complex *pointer = (fftw_complex*)value;
+    forwardPlan = fftw_plan_many_dft(1, &gridCount, blockCount,
+            pointer, 0, 1, gridCount, pointer, 0, 1, gridCount,
+            FFTW_FORWARD, FFTW_ESTIMATE);
+    reversePlan = fftw_plan_many_dft(1, &gridCount, blockCount,
+            pointer, 0, 1, gridCount, pointer, 0, 1, gridCount,
+            FFTW_BACKWARD, FFTW_ESTIMATE);
+}
+
+void PairDensityMatrix::freeGrid() {
+    if (value) {
+        fftw_destroy_plan(reversePlan);
+        fftw_destroy_plan(forwardPlan);
+        fftw_free(value);
+        value = 0;
+    }
+}
+
+void PairDensityMatrix::propagate() {
+    freeGrid();
+    allocateGrid();
+    const int bandSize = 2 * bandCount + 1;
+    const int tableSize = radialCount * bandSize;
+    ratio.assign((lmax + 1) * tableSize, 1.0);
+    band.resize(4 * tableSize);
+    std::vector<double> g(bandSize), g0(bandSize);
+    for (int l = 0; l <= lmax; ++l) {
+        propagate(l, potential, stepCount, &band[0]);
+        propagate(l, potential, 2 * stepCount, &band[tableSize]);
+        propagate(l, zeroPotential, stepCount, &band[2 * tableSize]);
+        propagate(l, zeroPotential, 2 * stepCount, &band[3 * tableSize]);
+        double* ratioL = &ratio[l * tableSize];
+        for (int i = 0; i < radialCount; ++i) {
+            // Richardson extrapolation of the second order Trotter error.
+            double g0max = 0.0;
+            for (int d = 0; d < bandSize; ++d) {
+                int index = i * bandSize + d;
+                g[d] = (4.0 * band[index + tableSize] - band[index]) / 3.0;
+                g0[d] = (4.0 * band[index + 3 * tableSize]
+                        - band[index + 2 * tableSize]) / 3.0;
+                g0max = std::max(g0max, fabs(g0[d]));
+            }
+            for (int d = 0; d < bandSize; ++d) {
+                int index = i * bandSize + d;
+                if (fabs(g0[d]) > 1e-10 * g0max) {
+                    ratioL[index] = g[d] / g0[d];
+                } else if (l > 0) {
+                    // Centrifugal barrier; the weight of this wave is tiny.
+                    ratioL[index] = ratioL[index - tableSize];
+                }
+            }
+        }
+    }
+}
+
+void PairDensityMatrix::propagate(int l, double (*v)(double),
+        int stepCount, double* result) {
+    double deltaTau = tau / stepCount;
+    double deltaK = 2.0 * PI / (deltaR * gridCount);
+    KineticGrid kineticGrid(gridCount, deltaK, mass, deltaTau);
+    std::vector<double> kinetic(gridCount);
+    std::vector<double> potentialValue(gridCount);
+    std::vector<double> halfPotential(gridCount);
+    const int index0 = gridCount / 2;
+    for (int i = 0; i < gridCount; ++i) {
+        // The FFTW normalization is folded into the kinetic factor.
+        kinetic[i] = kineticGrid(i) / gridCount;
+        double r = fabs((i - index0 + 0.5) * deltaR);
+        double energy = v(r) + 0.5 * l * (l + 1) / (mass * r * r);
+        potentialValue[i] = exp(-deltaTau * energy);
+        halfPotential[i] = exp(-0.5 * deltaTau * energy);
+    }
+    const int bandSize = 2 * bandCount + 1;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int ithread = 0; ithread < threadCount; ++ithread) {
+        Complex* block = value + ithread * blockCount * gridCount;
+        for (int i = 0; i < blockCount * gridCount; ++i) block[i] = 0.0;
+        // Odd initial state for each radial point, so psi(0)=0.
+        for (int icol = 0; icol < blockCount; ++icol) {
+            int j = ithread * blockCount + icol;
+            if (j >= radialCount) break;
+            block[icol * gridCount + index0 + j] = 1.0 / deltaR;
+            block[icol * gridCount + index0 - 1 - j] = -1.0 / deltaR;
+        }
+        evolve(block, &kinetic[0], &potentialValue[0], &halfPotential[0],
+                stepCount);
+        for (int icol = 0; icol < blockCount; ++icol) {
+            int j = ithread * blockCount + icol;
+            if (j >= radialCount) break;
+            int ifirst = std::max(0, j - bandCount);
+            int ilast = std::min(radialCount - 1, j + bandCount);
+            for (int i = ifirst; i <= ilast; ++i) {
+                result[i * bandSize + j - i + bandCount] =
+                        real(block[icol * gridCount + index0 + i]);
+            }
+        }
+    }
+}
+
+void PairDensityMatrix::evolve(Complex* block, const double* kinetic,
+        const double* fullPotential, const double* halfPotential,
+        int stepCount) {
+    fftw_complex *pointer = (fftw_complex*)block;
+    for (int icol = 0; icol < blockCount; ++icol) {
+        Complex* column = block + icol * gridCount;
+        for (int i = 0; i < gridCount; ++i) column[i] *= halfPotential[i];
+    }
+    for (int istep = 0; istep < stepCount; ++istep) {
+        fftw_execute_dft(forwardPlan, pointer, pointer);
+        for (int icol = 0; icol < blockCount; ++icol) {
+            Complex* column = block + icol * gridCount;
+            for (int i = 0; i < gridCount; ++i) column[i] *= kinetic[i];
+        }
+        fftw_execute_dft(reversePlan, pointer, pointer);
+        const double* factor =
+                (istep == stepCount - 1) ? halfPotential : fullPotential;
+        for (int icol = 0; icol < blockCount; ++icol) {
+            Complex* column = block + icol * gridCount;
+            for (int i = 0; i < gridCount; ++i) column[i] *= factor[i];
+        }
+    }
+}
+
+double PairDensityMatrix::readRatio(int l, double x1, double x2) const {
+    const int bandSize = 2 * bandCount + 1;
+    int i[2];
+    double f[2];
+    double x[2] = {x1, x2};
+    for (int k = 0; k < 2; ++k) {
+        if (x[k] < 0.0) x[k] = 0.0;
+        i[k] = (int)x[k];
+        if (i[k] > radialCount - 2) i[k] = radialCount - 2;
+        f[k] = std::min(x[k] - i[k], 1.0);
+    }
+    const double* ratioL = &ratio[l * radialCount * bandSize];
+    double sum = 0.0;
+    for (int a = 0; a < 2; ++a) {
+        for (int b = 0; b < 2; ++b) {
+            int d = (i[1] + b) - (i[0] + a);
+            d = std::max(-bandCount, std::min(bandCount, d));
+            double w = (a ? f[0] : 1.0 - f[0]) * (b ? f[1] : 1.0 - f[1]);
+            sum += w * ratioL[(i[0] + a) * bandSize + d + bandCount];
+        }
+    }
+    return sum;
+}
+
+double PairDensityMatrix::evaluate(double r1, double r2,
+        double cosTheta) const {
+    double x1 = r1 / deltaR - 0.5;
+    double x2 = r2 / deltaR - 0.5;
+    double z = mass * r1 * r2 / tau;
+    std::vector<double> bessel(lmax + 1);
+    gsl_sf_bessel_il_scaled_array(lmax, z, &bessel[0]);
+    double expFactor = exp(z * (1.0 - cosTheta));
+    double ratioL = readRatio(lmax, x1, x2);
+    double sum = ratioL;
+    double legendre = 1.0;
+    double lastLegendre = 0.0;
+    for (int l = 0; l < lmax; ++l) {
+        sum += (2 * l + 1) * legendre * bessel[l] * expFactor
+                * (readRatio(l, x1, x2) - ratioL);
+        double nextLegendre =
+                ((2 * l + 1) * cosTheta * legendre - l * lastLegendre)
+                / (l + 1);
+        lastLegendre = legendre;
+        legendre = nextLegendre;
+    }
+    return -log(sum);
+}
+
+void PairDensityMatrix::fit(double q, int norder, bool hasZ,
+        double* u) const {
+    const int ndata = hasZ ? (norder + 1) * (norder + 2) / 2 : norder + 1;
+    const double width = GridParameters::calculateThermalWidth(mass, tau);
+    const int zCount = hasZ ? 4 : 0;
+    const int sCount = 8;
+    const double zmax = hasZ ? std::min(width, 1.8 * q) : 0.0;
+    std::vector<double> a(ndata * ndata, 0.0), rhs(ndata, 0.0);
+    std::vector<double> basis(ndata);
+    for (int iz = 0; iz <= zCount; ++iz) {
+        double z = (zCount > 0) ? zmax * iz / zCount : 0.0;
+        double r1 = q + 0.5 * z;
+        double r2 = q - 0.5 * z;
+        double smax = std::min(r1 + r2, z + 2.0 * width);
+        for (int is = 0; is <= sCount; ++is) {
+            double s = z + (smax - z) * is / sCount;
+            double cosTheta = (r1 * r1 + r2 * r2 - s * s) / (2.0 * r1 * r2);
+            cosTheta = std::max(-1.0, std::min(1.0, cosTheta));
+            double action = evaluate(r1, r2, cosTheta);
+            // Weight by the free particle density matrix.
+            double weight = exp(-0.5 * mass * (s * s - z * z) / tau);
+            double z2 = z * z / (q * q);
+            double s2 = s * s / (q * q);
+            int idata = 0;
+            for (int k = 0; k <= norder; ++k) {
+                for (int j = 0; j <= (hasZ ? k : 0); ++j) {
+                    basis[idata++] = pow(z2, j) * pow(s2, k - j);
+                }
+            }
+            for (int i = 0; i < ndata; ++i) {
+                rhs[i] += weight * basis[i] * action;
+                for (int j = 0; j < ndata; ++j) {
+                    a[i + ndata * j] += weight * basis[i] * basis[j];
+                }
+            }
+        }
+    }
+    // Scale the normal equations to unit diagonal before solving.
+    std::vector<double> scale(ndata);
+    for (int i = 0; i < ndata; ++i) scale[i] = 1.0 / sqrt(a[i + ndata * i]);
+    for (int i = 0; i < ndata; ++i) {
+        for (int j = 0; j < ndata; ++j) a[i + ndata * j] *= scale[i] * scale[j];
+    }
+    std::vector<int> ipiv(ndata);
+    std::vector<double> work(ndata * ndata);
+    int sign;
+    SmallLU::factor(&a[0], ndata, &ipiv[0], sign);
+    if (sign == 0) {
+        std::cout << "ERROR: singular PairDensityMatrix fit at q=" << q
+                  << std::endl;
+        exit(-1);
+    }
+    SmallLU::invert(&a[0], ndata, &ipiv[0], &work[0]);
+    for (int i = 0; i < ndata; ++i) {
+        u[i] = 0.0;
+        for (int j = 0; j < ndata; ++j) {
+            u[i] += a[i + ndata * j] * scale[j] * rhs[j];
+        }
+        u[i] *= scale[i];
+    }
+}
+
+void PairDensityMatrix::write(const std::string& filename, int norder,
+        bool hasZ, double rmin, double rmax, int ngpts) {
+    double width = GridParameters::calculateThermalWidth(mass, tau);
+    if (rmax + width > this->rmax) {
+        std::cout << "ERROR: PairDensityMatrix grid must extend to "
+                  << rmax + width << std::endl;
+        exit(-1);
+    }
+    const int ndata = hasZ ? (norder + 1) * (norder + 2) / 2 : norder + 1;
+    std::vector<double> q(ngpts);
+    for (int i = 0; i < ngpts; ++i) {
+        q[i] = rmin * exp(i * log(rmax / rmin) / (ngpts - 1));
+    }
+    // The tau derivative is a centered difference, as for PairIntegrator;
+    // the tabulated tau is propagated last, so it stays current.
+    const double tau0 = tau;
+    const double tauFactor[3] = {1.01, 0.99, 1.0};
+    std::vector<double> u(3 * ngpts * ndata);
+    for (int itau = 0; itau < 3; ++itau) {
+        setTau(tauFactor[itau] * tau0);
+        propagate();
+        for (int i = 0; i < ngpts; ++i) {
+            fit(q[i], norder, hasZ, &u[(itau * ngpts + i) * ndata]);
+        }
+    }
+    std::ofstream ufile((filename + ".dmu").c_str()); ufile.precision(8);
+    ufile.setf(ufile.scientific, ufile.floatfield); ufile.setf(ufile.showpos);
+    std::ofstream efile((filename + ".dme").c_str()); efile.precision(8);
+    efile.setf(efile.scientific, efile.floatfield); efile.setf(efile.showpos);
+    for (int i = 0; i < ngpts; ++i) {
+        ufile << q[i]; efile << q[i];
+        for (int idata = 0; idata < ndata; ++idata) {
+            double uplus = u[i * ndata + idata];
+            double uminus = u[(ngpts + i) * ndata + idata];
+            ufile << " " << u[(2 * ngpts + i) * ndata + idata];
+            efile << " " << (uplus - uminus) / (0.02 * tau0);
+        }
+        ufile << std::endl; efile << std::endl;
+    }
+}
+
+double PairDensityMatrix::getGridSpacing() const {
+    return deltaR;
+}
+
+int PairDensityMatrix::getGridCount() const {
+    return gridCount;
+}
+
+double PairDensityMatrix::getBandWidth() const {
+    return bandCount * deltaR;
+}
+
+double PairDensityMatrix::zeroPotential(double r) {
+    return 0.0;
+}
+
+const double PairDensityMatrix::PI = 3.141592653589793;
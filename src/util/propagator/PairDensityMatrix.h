@@ -0,0 +1,94 @@
+#ifndef PAIRDENSITYMATRIX_H_
+#define PAIRDENSITYMATRIX_H_
+
+#include <complex>
+#include <string>
+#include <vector>
+#include <fftw3.h>
+
+/** Pair density matrix from split-operator propagation of partial waves.
+ * Each partial wave l of the relative motion is propagated on an
+ * odd-extended radial grid with the potential V(r)+l(l+1)/(2 mass r^2),
+ * starting from a delta function at every radial grid point at once.
+ * The columns are transformed together with batched FFTW plans, and are
+ * split between OpenMP threads. Each partial wave is also propagated
+ * with V=0, and the ratio R_l=rho_l/rho0_l is extrapolated in the time
+ * step from two Trotter step counts.
+ *
+ * The action u=-ln(rho/rho0) is assembled from
+ * @f[ \frac{\rho}{\rho_0} = R_L+\sum_{l<L}(2l+1)P_l(\cos\theta)
+ *     \tilde{i}_l(z)e^{z(1-\cos\theta)}(R_l-R_L), @f]
+ * with @f$z=mrr'/\tau@f$ and scaled modified spherical Bessel
+ * functions @f$\tilde{i}_l@f$, so partial waves above lmax take the
+ * ratio of the last one. Only pairs with |r-r'| within a few thermal
+ * lengths are kept, which is all the fits for the PairAction
+ * u_kj(q) coefficients need.
+ */
+class PairDensityMatrix {
+public:
+    typedef std::complex<double> Complex;
+
+    PairDensityMatrix(double mass, double tau, double rmax, double deltaR,
+            int lmax);
+    virtual ~PairDensityMatrix();
+
+    void setPotential(double (*v)(double));
+    /// Set the smaller of the two Trotter step counts (default 8).
+    void setStepCount(int stepCount);
+    void setTau(double tau);
+
+    /// Propagate all partial waves and tabulate R_l.
+    void propagate();
+
+    /// Pair action for radial distances r1, r2 and the angle between them.
+    double evaluate(double r1, double r2, double cosTheta) const;
+
+    /// Least squares fit of the u_kj(q) coefficients, in the order
+    /// and units of the PairAction tables.
+    void fit(double q, int norder, bool hasZ, double* u) const;
+
+    /// Write filename.dmu and filename.dme on a logarithmic q grid.
+    void write(const std::string& filename, int norder, bool hasZ,
+            double rmin, double rmax, int ngpts);
+
+    double getGridSpacing() const;
+    int getGridCount() const;
+    /// Largest |r-r'| kept in the table.
+    double getBandWidth() const;
+private:
+    double mass;
+    double tau;
+    const double rmax;
+    const double deltaR;
+    const int lmax;
+    int stepCount;
+    double (*potential)(double);
+    /// Radial points and points kept on either side of the diagonal.
+    const int radialCount;
+    int bandCount;
+    /// Size of the odd-extended grid and of each thread's column block.
+    int gridCount;
+    int blockCount;
+    int threadCount;
+    Complex* value;
+    fftw_plan forwardPlan;
+    fftw_plan reversePlan;
+    /// Ratio R_l for each l, radial point and band offset.
+    std::vector<double> ratio;
+    /// Propagated band of each column for the Trotter step counts.
+    std::vector<double> band;
+
+    void allocateGrid();
+    void freeGrid();
+    void propagate(int l, double (*v)(double), int stepCount,
+            double* result);
+    void evolve(Complex* block, const double* kinetic,
+            const double* fullPotential, const double* halfPotential,
+            int stepCount);
+    double readRatio(int l, double x1, double x2) const;
+
+    static double zeroPotential(double r);
+    static const double PI;
+};
+
+#endif
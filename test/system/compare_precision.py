@@ -0,0 +1,105 @@
+#!/usr/bin/env python
+"""Compare energies from a double-precision and a mixed-precision build.
+
+Usage:
+
+    python compare_precision.py DOUBLE_EXE MIXED_EXE [case ...]
+
+Each case is a system test directory with a pimc.xml (default: every
+directory matching */pimc.xml under the current directory). The case
+is run in a scratch copy with each executable, and every energy
+estimator is compared. A case fails if the two averages differ by more
+than --sigma combined error bars.
+"""
+
+import glob
+import math
+import optparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import pitools
+import tables
+
+
+def runCase(exe, case, workdir):
+    rundir = os.path.join(workdir, case)
+    shutil.copytree(case, rundir)
+    log = open(os.path.join(rundir, "pi.log"), "w")
+    status = subprocess.call([os.path.abspath(exe)], cwd=rundir,
+        stdout=log, stderr=subprocess.STDOUT)
+    log.close()
+    if status != 0:
+        print "  %s failed in %s, see %s/pi.log" % (exe, case, rundir)
+        return None
+    return readEnergies(os.path.join(rundir, "pimc.h5"))
+
+
+def readEnergies(filename):
+    h5file = tables.openFile(filename)
+    names = [node.name for node in h5file.iterNodes("/estimators")
+             if "energy" in node.name and len(node.shape) == 1]
+    h5file.close()
+    h5file = pitools.openFile(filename)
+    energies = {}
+    for name in names:
+        energies[name] = h5file.getScalar(name).getAverage()
+    h5file.close()
+    return energies
+
+
+def compare(case, reference, mixed, sigma):
+    passed = True
+    for name in sorted(reference):
+        if name not in mixed:
+            print "  %-20s missing from mixed-precision run" % name
+            passed = False
+            continue
+        e1, de1 = reference[name]
+        e2, de2 = mixed[name]
+        error = math.sqrt(de1 * de1 + de2 * de2)
+        z = abs(e2 - e1) / error if error > 0 else 0.
+        ok = (z <= sigma) if error > 0 else (abs(e2 - e1) <= 1e-5 * abs(e1))
+        passed = passed and ok
+        print "  %-20s double %12.6f +- %9.6f  mixed %12.6f +- %9.6f  " \
+            "(%4.1f sigma) %s" % (name, e1, de1, e2, de2, z,
+                                   "ok" if ok else "FAILED")
+    return passed
+
+
+def main():
+    parser = optparse.OptionParser(
+        usage="%prog [options] DOUBLE_EXE MIXED_EXE [case ...]")
+    parser.add_option("--sigma", type="float", default=3.,
+        help="allowed difference in combined error bars (default 3)")
+    parser.add_option("--keep", action="store_true", default=False,
+        help="keep the scratch directory with the runs")
+    options, args = parser.parse_args()
+    if len(args) < 2:
+        parser.error("need a double-precision and a mixed-precision executable")
+    cases = args[2:] or sorted(os.path.dirname(f)
+                               for f in glob.glob("*/pimc.xml"))
+    workdir = tempfile.mkdtemp(prefix="pi-precision-")
+    allPassed = True
+    for case in cases:
+        print "%s:" % case
+        reference = runCase(args[0],
+                            case, os.path.join(workdir, "double"))
+        mixed = runCase(args[1], case, os.path.join(workdir, "mixed"))
+        if reference is None or mixed is None:
+            allPassed = False
+            continue
+        allPassed = compare(case, reference, mixed, options.sigma) \
+            and allPassed
+    if options.keep:
+        print "Runs kept in %s" % workdir
+    else:
+        shutil.rmtree(workdir)
+    print "PASSED" if allPassed else "FAILED"
+    return 0 if allPassed else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,299 @@
+#include <gtest/gtest.h>
+#include "action/CompositeAction.h"
+#include "action/CompositeDoubleAction.h"
+#include "action/SHOAction.h"
+#include "action/SpringAction.h"
+
+#include "advancer/MultiLevelSamplerFake.h"
+#include "base/BeadFactory.h"
+#include "base/Beads.h"
+#include "base/SerialPaths.h"
+#include "base/Species.h"
+#include "base/SimulationInfo.h"
+#include "util/RandomNumGenerator.h"
+#include "util/SuperCell.h"
+#include <vector>
+
+namespace {
+
+/// Action that counts its calls, and depends on one species or on all.
+class CountingAction: public Action {
+public:
+    CountingAction(const Species* species) :
+            species(species), difference(1.0), differenceCount(0),
+            acceptCount(0) {
+    }
+    virtual double getActionDifference(const SectionSamplerInterface&,
+            int level) {
+        ++differenceCount;
+        return difference;
+    }
+    virtual double getTotalAction(const Paths&, const int level) const {
+        return 0.0;
+    }
+    virtual void getBeadAction(const Paths&, int ipart, int islice,
+            double& u, double& utau, double& ulambda, Vec& fm,
+            Vec& fp) const {
+    }
+    virtual void acceptLastMove() {
+        ++acceptCount;
+    }
+    virtual bool dependsOnSpecies(const Species& s) const {
+        return species == 0 || &s == species;
+    }
+    const Species* species;
+    double difference;
+    int differenceCount;
+    int acceptCount;
+};
+
+/// Double action that counts its calls, and depends on one species.
+class CountingDoubleAction: public DoubleAction {
+public:
+    CountingDoubleAction(const Species* species) :
+            species(species), differenceCount(0), acceptCount(0) {
+    }
+    virtual double getActionDifference(const SectionSamplerInterface&,
+            int level) {
+        ++differenceCount;
+        return 0.0;
+    }
+    virtual double getTotalAction(const Paths&, const int level) const {
+        return 0.0;
+    }
+    virtual void getBeadAction(const Paths&, int ipart, int islice,
+            double& u, double& utau, double& ulambda, Vec& fm,
+            Vec& fp) const {
+    }
+    virtual void acceptLastMove() {
+        ++acceptCount;
+    }
+    virtual bool dependsOnSpecies(const Species& s) const {
+        return &s == species;
+    }
+    const Species* species;
+    int differenceCount;
+    int acceptCount;
+};
+
+/// Sampler that moves two sections, like DoubleMLSampler with both set.
+class TwoSectionSamplerFake: public MultiLevelSamplerFake {
+public:
+    TwoSectionSamplerFake(int npart, int nmoving, int nslice) :
+            MultiLevelSamplerFake(npart, nmoving, nslice),
+            movingIndex2(nmoving), isSecondActive(false) {
+    }
+    virtual const IArray& getMovingIndex() const {
+        return isSecondActive ? movingIndex2 : *movingIndex;
+    }
+    virtual const IArray& getMovingIndex(int i) const {
+        return i == 1 ? *movingIndex : movingIndex2;
+    }
+    virtual bool isSamplingBoth() const {return true;}
+    IArray movingIndex2;
+    bool isSecondActive;
+};
+
+class CompositeActionTest: public ::testing::Test {
+protected:
+
+    virtual void SetUp() {
+        std::vector<Species*> speciesList, speciesIndex;
+        electron = new Species("e", 2, 1.0, -1.0, 1, true);
+        hole = new Species("h", 2, 1.0, 1.0, 1, true);
+        hole->ifirst = 2;
+        speciesList.push_back(electron);
+        speciesList.push_back(hole);
+        speciesIndex.push_back(electron);
+        speciesIndex.push_back(electron);
+        speciesIndex.push_back(hole);
+        speciesIndex.push_back(hole);
+        SuperCell* cell = new SuperCell(SuperCell::Vec(10.0, 10.0, 10.0));
+        cell->computeRecipricalVectors();
+        simInfo = new SimulationInfo(cell, npart, speciesList, speciesIndex,
+                1.0, 0.1, nslice);
+        sampler = new MultiLevelSamplerFake(npart, nmoving, nslice);
+        electronAction = new CountingAction(electron);
+        holeAction = new CountingAction(hole);
+        allAction = new CountingAction(0);
+        composite.addAction(electronAction);
+        composite.addAction(holeAction);
+        composite.addAction(allAction);
+    }
+
+    virtual void TearDown() {
+        delete sampler;
+        delete simInfo;
+    }
+
+    void move(int ipart) {
+        (*sampler->movingIndex)(0) = ipart;
+        composite.getActionDifference(*sampler, 0);
+        composite.acceptLastMove();
+    }
+
+    /// Random paths near the origin, with the sampler section over them.
+    Paths* createPaths() {
+        Paths* paths = new SerialPaths(npart, nslice, 0.1,
+                *simInfo->getSuperCell(), beadFactory);
+        RandomNumGenerator::seed(11);
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            for (int islice = 0; islice < nslice; ++islice) {
+                for (int idim = 0; idim < NDIM; ++idim) {
+                    (*paths)(ipart, islice)[idim] =
+                            RandomNumGenerator::getRand() - 0.5;
+                }
+                sampler->getSectionBeads()(ipart, islice) =
+                        (*paths)(ipart, islice);
+            }
+        }
+        return paths;
+    }
+
+    static const int npart = 4;
+    static const int nmoving = 1;
+    static const int nslice = 8;
+    Species *electron, *hole;
+    SimulationInfo *simInfo;
+    MultiLevelSamplerFake *sampler;
+    BeadFactory beadFactory;
+    CompositeAction composite;
+    CountingAction *electronAction, *holeAction, *allAction;
+};
+
+TEST_F(CompositeActionTest, testCallsEveryActionWithoutRouting) {
+    move(0);
+    EXPECT_EQ(1, electronAction->differenceCount);
+    EXPECT_EQ(1, holeAction->differenceCount);
+    EXPECT_EQ(1, allAction->differenceCount);
+    EXPECT_EQ(1, holeAction->acceptCount);
+}
+
+TEST_F(CompositeActionTest, testRoutesMovesBySpecies) {
+    composite.routeBySpecies(*simInfo);
+    move(1);
+    move(0);
+    move(3);
+    EXPECT_EQ(2, electronAction->differenceCount);
+    EXPECT_EQ(2, electronAction->acceptCount);
+    EXPECT_EQ(1, holeAction->differenceCount);
+    EXPECT_EQ(1, holeAction->acceptCount);
+    EXPECT_EQ(3, allAction->differenceCount);
+    EXPECT_EQ(3, allAction->acceptCount);
+}
+
+TEST_F(CompositeActionTest, testRoutesIntoGroups) {
+    CompositeAction* group = new CompositeAction();
+    CountingAction* groupAction = new CountingAction(hole);
+    group->addAction(groupAction);
+    composite.addAction(group);
+    EXPECT_FALSE(group->dependsOnSpecies(*electron));
+    composite.routeBySpecies(*simInfo);
+    move(0);
+    EXPECT_EQ(0, groupAction->differenceCount);
+    move(2);
+    EXPECT_EQ(1, groupAction->differenceCount);
+    EXPECT_EQ(1, groupAction->acceptCount);
+}
+
+TEST_F(CompositeActionTest, testAcceptsBothSections) {
+    composite.routeBySpecies(*simInfo);
+    TwoSectionSamplerFake both(npart, nmoving, nslice);
+    (*both.movingIndex)(0) = 0;
+    both.movingIndex2(0) = 2;
+    // Each level computes the first section, then the second.
+    for (int ilevel = 1; ilevel >= 0; --ilevel) {
+        both.isSecondActive = false;
+        composite.getActionDifference(both, ilevel);
+        both.isSecondActive = true;
+        composite.getActionDifference(both, ilevel);
+    }
+    both.isSecondActive = false;
+    composite.acceptLastMove();
+    EXPECT_EQ(2, electronAction->differenceCount);
+    EXPECT_EQ(2, holeAction->differenceCount);
+    EXPECT_EQ(4, allAction->differenceCount);
+    EXPECT_EQ(1, electronAction->acceptCount);
+    EXPECT_EQ(1, holeAction->acceptCount);
+    EXPECT_EQ(1, allAction->acceptCount);
+}
+
+TEST_F(CompositeActionTest, testDoubleActionRoutesBothSections) {
+    CompositeDoubleAction doubleComposite;
+    CountingDoubleAction* electronDouble = new CountingDoubleAction(electron);
+    CountingDoubleAction* holeDouble = new CountingDoubleAction(hole);
+    doubleComposite.addAction(electronDouble);
+    doubleComposite.addAction(holeDouble);
+    doubleComposite.routeBySpecies(*simInfo);
+    TwoSectionSamplerFake both(npart, nmoving, nslice);
+    (*both.movingIndex)(0) = 0;
+    both.movingIndex2(0) = 2;
+    doubleComposite.getActionDifference(both, 0);
+    doubleComposite.acceptLastMove();
+    EXPECT_EQ(1, electronDouble->differenceCount);
+    EXPECT_EQ(1, holeDouble->differenceCount);
+    EXPECT_EQ(1, electronDouble->acceptCount);
+    EXPECT_EQ(1, holeDouble->acceptCount);
+}
+
+TEST_F(CompositeActionTest, testRunningTotalsTrackAcceptedMoves) {
+    Paths* paths = createPaths();
+    CompositeAction physical;
+    physical.addAction(new SpringAction(*simInfo, 0, 0.0));
+    physical.addAction(new SHOAction(0.1, 1.0, 1.0, NDIM, *hole,
+            SuperCell::Vec(0.0, 0.0, 0.0)));
+    ASSERT_TRUE(physical.hasTotalAction());
+    std::vector<double> drift;
+    physical.syncRunningTotals(*paths, drift);
+    std::vector<double> start = physical.getRunningTotals();
+    // Move one hole on the interior slices of the section.
+    (*sampler->movingIndex)(0) = 2;
+    for (int islice = 0; islice < nslice; ++islice) {
+        sampler->getMovingBeads()(0, islice) = (*paths)(2, islice);
+        if (islice > 0 && islice < nslice - 1) {
+            sampler->getMovingBeads()(0, islice)[0] += 0.3;
+        }
+    }
+    double diff = physical.getActionDifference(*sampler, 0);
+    physical.acceptLastMove();
+    for (int islice = 1; islice < nslice - 1; ++islice) {
+        (*paths)(2, islice) = sampler->getMovingBeads()(0, islice);
+    }
+    const std::vector<double>& running = physical.getRunningTotals();
+    EXPECT_NEAR(diff, running[0] - start[0] + running[1] - start[1], 1e-12);
+    physical.syncRunningTotals(*paths, drift);
+    ASSERT_EQ(2u, drift.size());
+    EXPECT_NEAR(0.0, drift[0], 1e-10);
+    EXPECT_NEAR(0.0, drift[1], 1e-10);
+    EXPECT_NE(0.0, running[1] - start[1]);
+    delete paths;
+}
+
+TEST_F(CompositeActionTest, testRunningTotalsAddBothSections) {
+    composite.routeBySpecies(*simInfo);
+    electronAction->difference = 0.5;
+    holeAction->difference = 2.0;
+    allAction->difference = 3.0;
+    TwoSectionSamplerFake both(npart, nmoving, nslice);
+    (*both.movingIndex)(0) = 0;
+    both.movingIndex2(0) = 2;
+    for (int ilevel = 1; ilevel >= 0; --ilevel) {
+        both.isSecondActive = false;
+        composite.getActionDifference(both, ilevel);
+        both.isSecondActive = true;
+        composite.getActionDifference(both, ilevel);
+    }
+    both.isSecondActive = false;
+    composite.acceptLastMove();
+    const std::vector<double>& running = composite.getRunningTotals();
+    EXPECT_DOUBLE_EQ(0.5, running[0]);
+    EXPECT_DOUBLE_EQ(2.0, running[1]);
+    EXPECT_DOUBLE_EQ(6.0, running[2]);
+    // A later single-section move does not reuse the second section.
+    move(0);
+    EXPECT_DOUBLE_EQ(1.0, running[0]);
+    EXPECT_DOUBLE_EQ(2.0, running[1]);
+    EXPECT_DOUBLE_EQ(9.0, running[2]);
+}
+
+}
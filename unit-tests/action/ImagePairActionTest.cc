@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "action/ImagePairAction.h"
+#include "base/BeadFactory.h"
+#include "base/SerialPaths.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+#include "util/SuperCell.h"
+#include <blitz/tinyvec-et.h>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+class ImagePairActionTest: public ::testing::Test {
+protected:
+    typedef blitz::TinyVector<double,NDIM> Vec;
+    typedef blitz::TinyVector<int,NDIM> IVec;
+
+    /// Action tau/r with an off-diagonal term 0.1*tau*s^2/r.
+    class OffDiagonalAction: public PairAction::EmpiricalPairAction {
+    public:
+        virtual double u(double r, int order) const {
+            return ((order == 0) ? 0.1 : 0.01) / r;
+        }
+        virtual double utau(double r, int order) const {
+            return ((order == 0) ? 1. : 0.1) / r;
+        }
+    };
+
+    virtual void SetUp() {
+        npart = 2;
+        nslice = 4;
+        tau = 0.1;
+        nimage = IVec(5, 0, 0);
+        std::vector<Species*> speciesList, speciesIndex;
+        speciesList.push_back(new Species("e", npart, 1.0, -1.0, 1, false));
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            speciesIndex.push_back(speciesList[0]);
+        }
+        SuperCell* cell = new SuperCell(Vec(4., 20., 20.));
+        cell->computeRecipricalVectors();
+        simInfo = new SimulationInfo(cell, npart, speciesList, speciesIndex,
+                1.0, tau, nslice);
+        paths = new SerialPaths(npart, nslice, tau, *cell, beadFactory);
+        // Neighboring beads are well separated, so the links are
+        // off-diagonal. The separations stay inside half the cell.
+        (*paths)(0, 0) = Vec(0.30, 1.10, -0.30);
+        (*paths)(0, 1) = Vec(0.45, 1.00, -0.40);
+        (*paths)(0, 2) = Vec(0.60, 0.90, -0.35);
+        (*paths)(0, 3) = Vec(0.45, 1.05, -0.20);
+        (*paths)(1, 0) = Vec(-0.90, -0.50, 0.60);
+        (*paths)(1, 1) = Vec(-0.75, -0.40, 0.55);
+        (*paths)(1, 2) = Vec(-0.95, -0.25, 0.70);
+        (*paths)(1, 3) = Vec(-0.80, -0.45, 0.45);
+    }
+
+    virtual void TearDown() {
+        delete paths;
+        delete simInfo;
+    }
+
+    /// Bead action from the exact loop over images along the wire.
+    void getExactBeadAction(int ipart, int islice, double& u,
+            double& utau) const {
+        const SuperCell& cell = *simInfo->getSuperCell();
+        u = utau = 0.;
+        for (int j = 0; j < npart; ++j) {
+            Vec delta = (*paths)(ipart, islice) - (*paths)(j, islice);
+            cell.pbc(delta);
+            Vec prevDelta = (*paths)(ipart, islice, -1)
+                    - (*paths)(j, islice, -1);
+            cell.pbc(prevDelta);
+            Vec svec = delta - prevDelta;
+            for (int img = -nimage[0]; img <= nimage[0]; ++img) {
+                if (img == 0 && ipart == j) continue;
+                Vec imgVec(cell.a[0] * img, 0., 0.);
+                double q = 0.5 * (sqrt(dot(delta + imgVec, delta + imgVec))
+                        + sqrt(dot(prevDelta + imgVec, prevDelta + imgVec)));
+                double s2 = dot(svec, svec) / (q * q);
+                u += 0.5 * (0.1 + 0.01 * s2) / q;
+                utau += 0.5 * (1. + 0.1 * s2) / q;
+            }
+        }
+    }
+
+    int npart;
+    int nslice;
+    double tau;
+    IVec nimage;
+    SimulationInfo *simInfo;
+    BeadFactory beadFactory;
+    SerialPaths *paths;
+    OffDiagonalAction offDiagonalAction;
+};
+
+TEST_F(ImagePairActionTest, testBeadActionSumsImagesExactly) {
+    const Species& species = simInfo->getSpecies(0);
+    ImagePairAction action(species, species, offDiagonalAction, *simInfo, 1,
+            nimage, 0.01, 100., 2000, -1, false);
+    for (int ipart = 0; ipart < npart; ++ipart) {
+        double u, utau, ulambda;
+        Vec fm, fp;
+        action.getBeadAction(*paths, ipart, 1, u, utau, ulambda, fm, fp);
+        double expectU, expectUTau;
+        getExactBeadAction(ipart, 1, expectU, expectUTau);
+        EXPECT_NEAR(expectU, u, 1e-5 * expectU);
+        EXPECT_NEAR(expectUTau, utau, 1e-5 * expectUTau);
+    }
+}
+
+TEST_F(ImagePairActionTest, testImageTableMatchesExactImageLoop) {
+    const Species& species = simInfo->getSpecies(0);
+    ImagePairAction action(species, species, offDiagonalAction, *simInfo, 1,
+            nimage, 0.01, 100., 2000, -1, true);
+    // The table splits each link between its end beads differently,
+    // so compare the bead actions summed over the whole path.
+    for (int ipart = 0; ipart < npart; ++ipart) {
+        double sumU = 0., sumUTau = 0., expectU = 0., expectUTau = 0.;
+        for (int islice = 0; islice < nslice; ++islice) {
+            double u, utau, ulambda;
+            Vec fm, fp;
+            action.getBeadAction(*paths, ipart, islice, u, utau, ulambda,
+                    fm, fp);
+            sumU += u;
+            sumUTau += utau;
+            getExactBeadAction(ipart, islice, u, utau);
+            expectU += u;
+            expectUTau += utau;
+        }
+        // The table drops the off-diagonal terms of the other images and
+        // uses the end-point action on each link.
+        EXPECT_NEAR(expectU, sumU, 2e-4 * expectU);
+        EXPECT_NEAR(expectUTau, sumUTau, 2e-4 * expectUTau);
+    }
+}
+
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "action/ImageSumTable.h"
+#include "action/PairAction.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+#include "util/SuperCell.h"
+#include <blitz/tinyvec-et.h>
+#include <vector>
+
+namespace {
+
+class ImageSumTableTest: public ::testing::Test {
+protected:
+    typedef blitz::TinyVector<double,NDIM> Vec;
+
+    /// Diagonal action tau/r with no off-diagonal terms.
+    class InverseR: public PairAction::EmpiricalPairAction {
+    public:
+        virtual double u(double r, int order) const {
+            return (order == 0) ? 0.1 / r : 0.;
+        }
+        virtual double utau(double r, int order) const {
+            return (order == 0) ? 1. / r : 0.;
+        }
+    };
+
+    virtual void SetUp() {
+        species.count = 1;
+        species.mass = 1.;
+        simInfo.setTau(0.1);
+        action = new PairAction(species, species, inverseR, simInfo, 0,
+                0.01, 100., 2000, false, -1);
+    }
+
+    virtual void TearDown() {
+        delete action;
+    }
+
+    static double sum(const std::vector<Vec>& images, const Vec& r,
+            double scale) {
+        double u = 0.;
+        for (unsigned int i = 0; i < images.size(); ++i) {
+            Vec d = r + images[i];
+            u += scale / sqrt(dot(d, d));
+        }
+        return u;
+    }
+
+    Species species;
+    SimulationInfo simInfo;
+    InverseR inverseR;
+    PairAction *action;
+};
+
+TEST_F(ImageSumTableTest, testWireTableMatchesImageLoop) {
+    SuperCell cell(Vec(4., 20., 20.));
+    cell.computeRecipricalVectors();
+    std::vector<Vec> images;
+    for (int img = -20; img <= 20; ++img) {
+        if (img != 0) images.push_back(Vec(4. * img, 0., 0.));
+    }
+    ImageSumTable table(*action, cell, images, 64);
+    EXPECT_TRUE(table.isWire());
+    Vec r(0.7, 0.4, -0.3);
+    double u, utau;
+    Vec grad;
+    table.evalDerivatives(r, u, utau, grad);
+    EXPECT_NEAR(sum(images, r, 0.1), u, 1e-3 * u);
+    EXPECT_NEAR(sum(images, r, 1.), utau, 1e-3 * utau);
+    EXPECT_NEAR(u, table(r), 1e-12);
+    // Gradient by finite differences of the exact sum.
+    const double h = 1e-5;
+    for (int idim = 0; idim < NDIM; ++idim) {
+        Vec rp(r), rm(r);
+        rp[idim] += h;
+        rm[idim] -= h;
+        double g = (sum(images, rp, 0.1) - sum(images, rm, 0.1)) / (2 * h);
+        EXPECT_NEAR(g, grad[idim], 1e-3 * fabs(u));
+    }
+}
+
+TEST_F(ImageSumTableTest, testCellTableMatchesImageLoop) {
+    SuperCell cell(Vec(4., 5., 6.));
+    cell.computeRecipricalVectors();
+    std::vector<Vec> images;
+    for (int i = -2; i <= 2; ++i)
+        for (int j = -2; j <= 2; ++j)
+            for (int k = -2; k <= 2; ++k)
+                if (i != 0 || j != 0 || k != 0)
+                    images.push_back(Vec(4. * i, 5. * j, 6. * k));
+    ImageSumTable table(*action, cell, images, 32);
+    EXPECT_FALSE(table.isWire());
+    Vec r(-1.3, 2.1, 0.8);
+    double u, utau;
+    Vec grad;
+    table.evalDerivatives(r, u, utau, grad);
+    EXPECT_NEAR(sum(images, r, 0.1), u, 1e-3 * u);
+    const double h = 1e-5;
+    for (int idim = 0; idim < NDIM; ++idim) {
+        Vec rp(r), rm(r);
+        rp[idim] += h;
+        rm[idim] -= h;
+        double g = (sum(images, rp, 0.1) - sum(images, rm, 0.1)) / (2 * h);
+        EXPECT_NEAR(g, grad[idim], 1e-3 * fabs(u));
+    }
+}
+
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "action/SmoothedGridPotential.h"
+#include "base/BeadFactory.h"
+#include "base/SerialPaths.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+#include "util/SuperCell.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+class SmoothedGridPotentialTest: public ::testing::Test {
+protected:
+    typedef blitz::TinyVector<double, NDIM> Vec;
+
+    virtual void SetUp() {
+        gridFile = "smoothedgridtest.h5";
+        cacheFile = "smoothedgridtest-cache.h5";
+        wisdomFile = "smoothedgridtest.wisdom";
+        std::remove(cacheFile.c_str());
+        std::vector<Species*> speciesList, speciesIndex;
+        speciesList.push_back(new Species("h", 1, 1.0, 1.0, 1, true));
+        speciesList.push_back(new Species("e", 1, 1.0, -1.0, 1, true));
+        speciesList[1]->ifirst = 1;
+        speciesIndex.push_back(speciesList[0]);
+        speciesIndex.push_back(speciesList[1]);
+        SuperCell* cell = new SuperCell(Vec(20.0, 20.0, 20.0));
+        cell->computeRecipricalVectors();
+        simInfo = new SimulationInfo(cell, npart, speciesList, speciesIndex,
+                1.0, 0.5, nslice);
+        paths = new SerialPaths(npart, nslice, 0.5, *cell, beadFactory);
+        writeGrids();
+    }
+
+    virtual void TearDown() {
+        delete paths;
+        delete simInfo;
+        std::remove(gridFile.c_str());
+        std::remove(cacheFile.c_str());
+        std::remove(wisdomFile.c_str());
+    }
+
+    /// Write smooth periodic electron and hole grids with unit spacing.
+    void writeGrids() {
+        std::vector<double> vh(n0 * n1 * n2), ve(n0 * n1 * n2);
+        for (int i = 0; i < n0; ++i) {
+            for (int j = 0; j < n1; ++j) {
+                for (int k = 0; k < n2; ++k) {
+                    vh[(i * n1 + j) * n2 + k] = 1 + cos(2 * M_PI * i / n0);
+                    ve[(i * n1 + j) * n2 + k] = 2 + sin(2 * M_PI * k / n2)
+                            + cos(2 * M_PI * j / n1);
+                }
+            }
+        }
+        double a = 1.0;
+        hid_t fileID = H5Fcreate(gridFile.c_str(), H5F_ACC_TRUNC,
+                H5P_DEFAULT, H5P_DEFAULT);
+        hsize_t dims[] = {n0, n1, n2};
+        hsize_t dims1[] = {1};
+        writeDataSet(fileID, "vh", 3, dims, &vh[0]);
+        writeDataSet(fileID, "ve", 3, dims, &ve[0]);
+        writeDataSet(fileID, "a", 1, dims1, &a);
+        H5Fclose(fileID);
+    }
+
+    void writeDataSet(hid_t locID, const char* name, int rank,
+            const hsize_t* dims, const double* data) {
+        hid_t spaceID = H5Screate_simple(rank, dims, NULL);
+        hid_t setID = H5Dcreate2(locID, name, H5T_NATIVE_DOUBLE, spaceID,
+                H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        H5Dwrite(setID, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                data);
+        H5Dclose(setID);
+        H5Sclose(spaceID);
+    }
+
+    /// Potential of a particle at a point, read through getBeadAction.
+    double potential(const SmoothedGridPotential& action, int ipart,
+            const Vec& r) {
+        (*paths)(ipart, 0) = r;
+        double u, utau, ulambda;
+        Vec fm, fp;
+        action.getBeadAction(*paths, ipart, 0, u, utau, ulambda, fm, fp);
+        return utau;
+    }
+
+    static const int npart = 2;
+    static const int nslice = 8;
+    static const int n0 = 6, n1 = 4, n2 = 5;
+    std::string gridFile, cacheFile, wisdomFile;
+    SimulationInfo *simInfo;
+    BeadFactory beadFactory;
+    Paths *paths;
+};
+
+TEST_F(SmoothedGridPotentialTest, testCacheRoundTrip) {
+    SmoothedGridPotential smoothed(*simInfo, 2, gridFile, cacheFile,
+            wisdomFile);
+    SmoothedGridPotential cached(*simInfo, 2, gridFile, cacheFile,
+            wisdomFile);
+    const Vec points[] = {Vec(0.0, 0.0, 0.0), Vec(-1.3, 0.4, 0.7),
+            Vec(1.6, -0.9, -1.2)};
+    for (int ipoint = 0; ipoint < 3; ++ipoint) {
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            EXPECT_DOUBLE_EQ(potential(smoothed, ipart, points[ipoint]),
+                    potential(cached, ipart, points[ipoint]));
+        }
+    }
+    // Overwrite a cached grid: a cache hit must return the new values.
+    std::vector<double> flat(n0 * n1 * n2, 7.0);
+    hid_t fileID = H5Fopen(cacheFile.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+    ASSERT_GE(fileID, 0);
+    hid_t setID = H5Dopen2(fileID, "0/vh", H5P_DEFAULT);
+    H5Dwrite(setID, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+            &flat[0]);
+    H5Dclose(setID);
+    H5Fclose(fileID);
+    SmoothedGridPotential tampered(*simInfo, 2, gridFile, cacheFile,
+            wisdomFile);
+    EXPECT_DOUBLE_EQ(7.0, potential(tampered, 0, points[1]));
+    EXPECT_DOUBLE_EQ(potential(smoothed, 1, points[1]),
+            potential(tampered, 1, points[1]));
+}
+
+}
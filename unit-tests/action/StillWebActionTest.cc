@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "action/StillWebAction.h"
+#include "advancer/MultiLevelSamplerFake.h"
+#include "base/BeadFactory.h"
+#include "base/Beads.h"
+#include "base/SerialPaths.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+#include "util/RandomNumGenerator.h"
+#include "util/SuperCell.h"
+#include <blitz/tinyvec-et.h>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+class StillWebActionTest: public ::testing::Test {
+protected:
+    typedef blitz::TinyVector<double, NDIM> Vec;
+
+    virtual void SetUp() {
+        npart = 40;
+        nslice = 5;
+        tau = 0.1;
+        simInfo = 0;
+        action = 0;
+        RandomNumGenerator::seed(17);
+    }
+
+    virtual void TearDown() {
+        delete action;
+        delete simInfo;
+    }
+
+    /// Make the action for a cubic box of side length.
+    void build(double length) {
+        delete action;
+        delete simInfo;
+        this->length = length;
+        std::vector<Species*> speciesList, speciesIndex;
+        speciesList.push_back(new Species("Si", npart, 50000.0, 0.0, 1,
+                false));
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            speciesIndex.push_back(speciesList[0]);
+        }
+        SuperCell* cell = new SuperCell(Vec(length, length, length));
+        cell->computeRecipricalVectors();
+        simInfo = new SimulationInfo(cell, npart, speciesList, speciesIndex,
+                1.0, tau, nslice);
+        action = new StillWebAction(*simInfo, "");
+    }
+
+    Vec randomPosition() {
+        Vec r;
+        for (int idim = 0; idim < NDIM; ++idim) {
+            r[idim] = length * (RandomNumGenerator::getRand() - 0.5);
+        }
+        return r;
+    }
+
+    /// Pair and triplet sums for r over all other particles, as in the
+    /// all-pairs loop the cell lists replaced.
+    double allPairs(const Vec& r, int ipart, const Beads<NDIM>& beads,
+            int islice, double pairWeight) const {
+        const SuperCell& cell = *simInfo->getSuperCell();
+        double sum = 0.;
+        for (int jpart = 0; jpart < npart; ++jpart) {
+            if (jpart == ipart) continue;
+            Vec deltaj = r - beads(jpart, islice);
+            cell.pbc(deltaj);
+            double rij = sqrt(dot(deltaj, deltaj));
+            sum += pairWeight * action->f2(rij, 0, 0);
+            for (int kpart = 0; kpart < jpart; ++kpart) {
+                if (kpart == ipart) continue;
+                Vec deltak = r - beads(kpart, islice);
+                cell.pbc(deltak);
+                double rik = sqrt(dot(deltak, deltak));
+                double costheta = dot(deltaj, deltak) / (rij * rik);
+                sum += action->h(rij, rik, costheta, 0, 0, 0);
+            }
+        }
+        return sum;
+    }
+
+    /// Compare action differences of random moves with the all-pairs sum.
+    void checkActionDifference() {
+        MultiLevelSamplerFake sampler(npart, 1, nslice);
+        delete sampler.superCell;
+        sampler.superCell = new SuperCell(Vec(length, length, length));
+        sampler.superCell->computeRecipricalVectors();
+        Beads<NDIM> &sectionBeads = sampler.getSectionBeads();
+        Beads<NDIM> &movingBeads = sampler.getMovingBeads();
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            for (int islice = 0; islice < nslice; ++islice) {
+                sectionBeads(ipart, islice) = randomPosition();
+            }
+        }
+        for (int imove = 0; imove < 5; ++imove) {
+            const int i = 7 * imove;
+            (*sampler.movingIndex)(0) = i;
+            for (int islice = 0; islice < nslice; ++islice) {
+                movingBeads(0, islice) = randomPosition();
+            }
+            double expect = 0.;
+            for (int islice = 1; islice < nslice - 1; ++islice) {
+                expect += allPairs(movingBeads(0, islice), i, sectionBeads,
+                        islice, 1.0) * tau;
+                expect -= allPairs(sectionBeads(i, islice), i, sectionBeads,
+                        islice, 1.0) * tau;
+            }
+            ASSERT_NE(0.0, expect);
+            double diff = action->getActionDifference(sampler, 0);
+            EXPECT_NEAR(expect, diff, 1e-10 * fabs(expect));
+            // Accept, so later moves see the cell lists after a move.
+            action->acceptLastMove();
+            for (int islice = 0; islice < nslice; ++islice) {
+                sectionBeads(i, islice) = movingBeads(0, islice);
+            }
+        }
+    }
+
+    /// Compare bead actions of a random slice with the all-pairs sum.
+    void checkBeadAction() {
+        SerialPaths paths(npart, nslice, tau, *simInfo->getSuperCell(),
+                beadFactory);
+        Beads<NDIM> beads(npart, nslice);
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            for (int islice = 0; islice < nslice; ++islice) {
+                beads(ipart, islice) = randomPosition();
+                paths(ipart, islice) = beads(ipart, islice);
+            }
+        }
+        for (int islice = 0; islice < nslice; ++islice) {
+            for (int ipart = 0; ipart < npart; ++ipart) {
+                double u, utau, ulambda;
+                Vec fm, fp;
+                action->getBeadAction(paths, ipart, islice, u, utau, ulambda,
+                        fm, fp);
+                double expect = allPairs(beads(ipart, islice), ipart, beads,
+                        islice, 0.5);
+                EXPECT_NEAR(expect, utau, 1e-10 * fabs(expect) + 1e-14);
+                EXPECT_NEAR(expect * tau, u, 1e-10 * fabs(expect) + 1e-14);
+            }
+        }
+    }
+
+    int npart;
+    int nslice;
+    double tau;
+    double length;
+    SimulationInfo *simInfo;
+    StillWebAction *action;
+    BeadFactory beadFactory;
+};
+
+// Half the box is just above the cutoff of about 7.12 bohr, so there
+// are two cells per axis.
+TEST_F(StillWebActionTest, testActionDifferenceCutoffNearHalfBox) {
+    build(14.4);
+    checkActionDifference();
+}
+
+TEST_F(StillWebActionTest, testActionDifferenceThreeCells) {
+    build(24.0);
+    checkActionDifference();
+}
+
+TEST_F(StillWebActionTest, testBeadActionCutoffNearHalfBox) {
+    build(14.4);
+    checkBeadAction();
+}
+
+TEST_F(StillWebActionTest, testBeadActionThreeCells) {
+    build(24.0);
+    checkBeadAction();
+}
+
+}
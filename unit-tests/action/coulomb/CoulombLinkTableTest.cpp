@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include "action/coulomb/CoulombLinkTable.h"
+#include "action/coulomb/CoulombLinkAction.h"
+#include <blitz/tinyvec-et.h>
+
+namespace {
+
+class CoulombLinkTableTest: public testing::Test {
+protected:
+    typedef CoulombLinkTable::Vec Vec;
+
+    double q1q2;
+    double epsilon;
+    double deltaTau;
+    double mu;
+
+    virtual void SetUp() {
+        q1q2 = -1.0;
+        epsilon = 12.0;
+        deltaTau = 0.1;
+        mu = 1.0;
+    }
+};
+
+TEST_F(CoulombLinkTableTest, testMatchesCoulombLinkAction) {
+    for (int norder = 0; norder <= 4; ++norder) {
+        CoulombLinkTable table(q1q2, epsilon, mu, deltaTau, norder);
+        CoulombLinkAction action(q1q2, epsilon, mu, deltaTau, norder);
+        EXPECT_LT(table.getMaxError(), 1e-5);
+        for (int i = 0; i < 100; ++i) {
+            Vec delta1, delta2;
+            for (int idim = 0; idim < NDIM; ++idim) {
+                delta1[idim] = 0.3 * sin(1.3 * i + idim) * exp(3 * sin(0.7 * i));
+                delta2[idim] = delta1[idim] + 0.2 * cos(2.1 * i + idim);
+            }
+            double expect = action.getValue(delta1, delta2);
+            ASSERT_NEAR(expect, table.getValue(delta1, delta2),
+                    1e-9 * fabs(expect));
+        }
+    }
+}
+
+TEST_F(CoulombLinkTableTest, testValueAtOrigin) {
+    CoulombLinkTable table(q1q2, epsilon, mu, deltaTau, 3);
+    Vec delta1 = 0.0;
+    Vec delta2 = 0.0;
+    ASSERT_NEAR(-0.066158726800149281, table.getValue(delta1, delta2), 1e-9);
+}
+
+TEST_F(CoulombLinkTableTest, testTablesAreShared) {
+    const CoulombLinkTable *table1 =
+            CoulombLinkTable::getTable(q1q2, epsilon, mu, deltaTau, 3);
+    const CoulombLinkTable *table2 =
+            CoulombLinkTable::getTable(q1q2, epsilon, mu, deltaTau, 3);
+    const CoulombLinkTable *table3 =
+            CoulombLinkTable::getTable(q1q2, epsilon, mu, 2 * deltaTau, 3);
+    ASSERT_EQ(table1, table2);
+    ASSERT_NE(table1, table3);
+}
+
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "advancer/mover/BisectionStage.h"
+#include "base/Beads.h"
+#include "util/RandomNumGenerator.h"
+#include "util/SuperCell.h"
+#include <blitz/tinyvec-et.h>
+#include <cmath>
+
+namespace {
+
+class BisectionStageTest: public ::testing::Test {
+protected:
+    typedef blitz::TinyVector<double, NDIM> Vec;
+
+    virtual void SetUp() {
+        npart = 4;
+        nslice = 9;
+        cell = new SuperCell(Vec(3.0, 4.0, 5.0));
+        cell->computeRecipricalVectors();
+        sectionBeads = new Beads<NDIM>(npart, nslice);
+        movingBeads = new Beads<NDIM>(2, nslice);
+        index.resize(2);
+        index = 3, 1;
+        RandomNumGenerator::seed(17);
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            for (int islice = 0; islice < nslice; ++islice) {
+                for (int idim = 0; idim < NDIM; ++idim) {
+                    (*sectionBeads)(ipart, islice)[idim] = cell->a[idim]
+                            * (RandomNumGenerator::getRand() - 0.5);
+                }
+            }
+        }
+        for (int imoving = 0; imoving < 2; ++imoving) {
+            for (int islice = 0; islice < nslice; ++islice) {
+                (*movingBeads)(imoving, islice) =
+                        (*sectionBeads)(index(imoving), islice);
+            }
+        }
+    }
+
+    virtual void TearDown() {
+        delete movingBeads;
+        delete sectionBeads;
+        delete cell;
+    }
+
+    /// Bisection of one bead, as the movers did it one particle at a time.
+    Vec midpoint(const Beads<NDIM>& beads, int ipart, int islice,
+            int nStride) const {
+        Vec mid = beads.delta(ipart, islice + nStride, -2 * nStride);
+        cell->pbc(mid) *= 0.5;
+        mid += beads(ipart, islice - nStride);
+        cell->pbc(mid);
+        return mid;
+    }
+
+    int npart;
+    int nslice;
+    SuperCell *cell;
+    Beads<NDIM> *sectionBeads;
+    Beads<NDIM> *movingBeads;
+    blitz::Array<int, 1> index;
+};
+
+TEST_F(BisectionStageTest, testMatchesParticleLoop) {
+    const int level = 1;
+    const int nStride = 2;
+    const double sigma[2] = {0.7, 2.5};
+    BisectionStage<NDIM> stage;
+    stage.load(*movingBeads, *sectionBeads, index, level, cell->a.data());
+    for (int imoving = 0; imoving < 2; ++imoving) {
+        for (int idim = 0; idim < NDIM; ++idim) {
+            stage.setSigma(imoving, idim, sigma[imoving],
+                    0.5 / (sigma[imoving] * sigma[imoving]));
+        }
+    }
+    RandomNumGenerator::seed(5);
+    double logRatio = stage.sample();
+    stage.store(*movingBeads);
+    EXPECT_EQ(2, stage.getMidpointCount());
+
+    // Same deviates, laid out one array per dimension.
+    const int n = stage.getMidpointCount() * 2;
+    blitz::Array<double, 1> gauss(NDIM * n);
+    RandomNumGenerator::seed(5);
+    RandomNumGenerator::makeGaussRand(gauss);
+    double expectLogRatio = 0.0;
+    for (int k = 0; k < 2; ++k) {
+        int islice = nStride * (2 * k + 1);
+        for (int imoving = 0; imoving < 2; ++imoving) {
+            int i = index(imoving);
+            Vec delta;
+            for (int idim = 0; idim < NDIM; ++idim) {
+                delta[idim] = sigma[imoving] * gauss(idim * n + k * 2 + imoving);
+            }
+            cell->pbc(delta);
+            // The moving end points still equal the section beads.
+            Vec expect = midpoint(*sectionBeads, i, islice, nStride) + delta;
+            cell->pbc(expect);
+            for (int idim = 0; idim < NDIM; ++idim) {
+                EXPECT_NEAR(expect[idim], (*movingBeads)(imoving, islice)[idim],
+                        1e-12);
+            }
+            Vec reverse = (*sectionBeads)(i, islice);
+            reverse -= midpoint(*sectionBeads, i, islice, nStride);
+            cell->pbc(reverse);
+            double inv2Sigma2 = 0.5 / (sigma[imoving] * sigma[imoving]);
+            expectLogRatio += (dot(delta, delta) - dot(reverse, reverse))
+                    * inv2Sigma2;
+        }
+    }
+    EXPECT_NEAR(expectLogRatio, logRatio, 1e-12);
+    // Beads off the midpoint slices are untouched.
+    for (int imoving = 0; imoving < 2; ++imoving) {
+        for (int islice = 0; islice < nslice; islice += 2 * nStride) {
+            Vec d = (*movingBeads)(imoving, islice)
+                    - (*sectionBeads)(index(imoving), islice);
+            EXPECT_EQ(0.0, dot(d, d));
+        }
+    }
+}
+
+TEST_F(BisectionStageTest, testZeroWeightDimension) {
+    BisectionStage<NDIM> stage;
+    stage.load(*movingBeads, *sectionBeads, index, 0, cell->a.data());
+    for (int imoving = 0; imoving < 2; ++imoving) {
+        for (int idim = 0; idim < NDIM; ++idim) {
+            stage.setSigma(imoving, idim, 0.3, (idim == 0) ? 0.0 : 1.0);
+        }
+    }
+    double logRatio = stage.sample();
+    EXPECT_EQ(4, stage.getMidpointCount());
+    double forwardSum = 0.0, expectLogRatio = 0.0;
+    for (int idim = 1; idim < NDIM; ++idim) {
+        const double* forward = stage.getForwardDelta(idim);
+        const double* reverse = stage.getReverseDelta(idim);
+        for (int j = 0; j < 8; ++j) {
+            forwardSum += forward[j] * forward[j];
+            expectLogRatio += forward[j] * forward[j] - reverse[j] * reverse[j];
+        }
+    }
+    EXPECT_NEAR(forwardSum, stage.getForwardSum(), 1e-12);
+    EXPECT_NEAR(expectLogRatio, logRatio, 1e-12);
+}
+
+}
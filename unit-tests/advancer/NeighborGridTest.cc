@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "advancer/NeighborGrid.h"
+#include "base/Beads.h"
+#include "util/SuperCell.h"
+#include <blitz/tinyvec-et.h>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+class NeighborGridTest: public ::testing::Test {
+protected:
+    typedef blitz::TinyVector<double, NDIM> Vec;
+
+    virtual void SetUp() {
+        length = 10.0;
+        cutoff = 2.0;
+        cell = new SuperCell(Vec(length, length, length));
+        npart = 200;
+        beads = new Beads<NDIM>(npart, 1);
+        // Deterministic scatter, including positions outside the box.
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            for (int idim = 0; idim < NDIM; ++idim) {
+                double s = ((ipart * (7 + 3 * idim) + 5 * idim) % 97) / 97.0;
+                (*beads)(ipart, 0)[idim] = (2.0 * s - 1.0) * length;
+            }
+        }
+    }
+
+    virtual void TearDown() {
+        delete beads;
+        delete cell;
+    }
+
+    bool contains(const std::vector<int>& list, int i) const {
+        return std::find(list.begin(), list.end(), i) != list.end();
+    }
+
+    double length;
+    double cutoff;
+    int npart;
+    SuperCell* cell;
+    Beads<NDIM>* beads;
+};
+
+TEST_F(NeighborGridTest, testFindsAllParticlesWithinCutoff) {
+    NeighborGrid grid(*cell, cutoff);
+    grid.bin(*beads, 0, 0, npart);
+    std::vector<int> neighbors;
+    for (int ipart = 0; ipart < npart; ++ipart) {
+        Vec r = (*beads)(ipart, 0);
+        grid.findNeighbors(r, neighbors);
+        for (int jpart = 0; jpart < npart; ++jpart) {
+            Vec delta = r - (*beads)(jpart, 0);
+            cell->pbc(delta);
+            if (dot(delta, delta) < cutoff * cutoff) {
+                ASSERT_TRUE(contains(neighbors, jpart));
+            }
+        }
+    }
+}
+
+TEST_F(NeighborGridTest, testNeighborsAreNotRepeated) {
+    NeighborGrid grid(*cell, cutoff);
+    grid.bin(*beads, 0, 0, npart);
+    std::vector<int> neighbors;
+    grid.findNeighbors(Vec(0.0, 0.0, 0.0), neighbors);
+    std::sort(neighbors.begin(), neighbors.end());
+    ASSERT_TRUE(std::adjacent_find(neighbors.begin(), neighbors.end())
+            == neighbors.end());
+    ASSERT_LT((int) neighbors.size(), npart);
+}
+
+TEST_F(NeighborGridTest, testLargeCutoffReturnsAllParticles) {
+    NeighborGrid grid(*cell, 0.6 * length);
+    ASSERT_EQ(1, grid.getCellCount());
+    grid.bin(*beads, 0, 0, npart);
+    std::vector<int> neighbors;
+    grid.findNeighbors(Vec(1.0, 2.0, 3.0), neighbors);
+    ASSERT_EQ(npart, (int) neighbors.size());
+}
+
+}
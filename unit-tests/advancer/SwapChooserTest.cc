@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "advancer/SwapChooser.h"
+#include "advancer/MultiLevelSamplerFake.h"
+#include "base/Beads.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+#include "util/RandomNumGenerator.h"
+#include "util/SuperCell.h"
+#include <blitz/tinyvec-et.h>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+class SwapChooserTest: public ::testing::Test {
+protected:
+    typedef blitz::TinyVector<double, NDIM> Vec;
+
+    virtual void SetUp() {
+        std::vector<Species*> speciesList, speciesIndex;
+        species = new Species("p", npart, 1.0, 0.0, 1, false);
+        speciesList.push_back(species);
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            speciesIndex.push_back(species);
+        }
+        SuperCell* cell = new SuperCell(Vec(20.0, 20.0, 20.0));
+        cell->computeRecipricalVectors();
+        simInfo = new SimulationInfo(cell, npart, speciesList, speciesIndex,
+                1.0, tau, nslice);
+        sampler = new MultiLevelSamplerFake(npart, 2, nslice);
+        // Start and end points close enough for every exchange to matter.
+        start.resize(npart);
+        end.resize(npart);
+        start[0] = Vec(0.0, 0.0, 0.0);
+        start[1] = Vec(0.6, 0.0, 0.0);
+        start[2] = Vec(0.0, 0.5, 0.0);
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            end[ipart] = start[ipart] + Vec(0.1, 0.2, -0.1);
+            for (int islice = 0; islice < nslice; ++islice) {
+                sampler->getSectionBeads()(ipart, islice) = start[ipart];
+            }
+            sampler->getSectionBeads()(ipart, nslice - 1) = end[ipart];
+        }
+    }
+
+    virtual void TearDown() {
+        delete sampler;
+        delete simInfo;
+    }
+
+    /// Free propagator between a start and an end over the section.
+    double link(int ipart, int jend) const {
+        double alpha = 1.0 / (2 * tau * (1 << nlevel));
+        Vec delta = start[ipart] - end[jend];
+        return exp(-alpha * dot(delta, delta));
+    }
+
+    /// Index of the end point that the path of ipart runs to.
+    int endOf(int ipart) const {
+        const Vec& r = sampler->getSectionBeads()(ipart, nslice - 1);
+        for (int jend = 0; jend < npart; ++jend) {
+            Vec delta = r - end[jend];
+            if (dot(delta, delta) < 1e-20) return jend;
+        }
+        return -1;
+    }
+
+    static const int npart = 3;
+    static const int nlevel = 2;
+    static const int nslice = (1 << nlevel) + 1;
+    static const double tau;
+    Species *species;
+    SimulationInfo *simInfo;
+    MultiLevelSamplerFake *sampler;
+    std::vector<Vec> start, end;
+};
+
+const double SwapChooserTest::tau = 0.1;
+
+TEST_F(SwapChooserTest, testSamplesFreePermutationSectors) {
+    SwapChooser chooser(*species, nlevel, *simInfo);
+    chooser.setSampler(sampler);
+    // Sector of each permutation of the ends, coded as end[0]*npart+end[1].
+    std::vector<double> count(npart * npart, 0.0);
+    RandomNumGenerator::seed(23);
+    const int nstep = 200000;
+    for (int istep = 0; istep < nstep; ++istep) {
+        chooser.init();
+        if (chooser.choosePermutation()) {
+            // Exact free sampling of the interior accepts every swap,
+            // so an accepted swap just exchanges the two end points.
+            int i = chooser[0], j = chooser[1];
+            Vec temp = sampler->getSectionBeads()(i, nslice - 1);
+            sampler->getSectionBeads()(i, nslice - 1) =
+                    sampler->getSectionBeads()(j, nslice - 1);
+            sampler->getSectionBeads()(j, nslice - 1) = temp;
+        }
+        count[endOf(0) * npart + endOf(1)] += 1.0;
+    }
+    // Exact weight of each sector is the product of its free propagators.
+    std::vector<double> weight(npart * npart, 0.0);
+    double total = 0.0;
+    for (int a = 0; a < npart; ++a) {
+        for (int b = 0; b < npart; ++b) {
+            if (a == b) continue;
+            int c = npart - a - b;
+            weight[a * npart + b] = link(0, a) * link(1, b) * link(2, c);
+            total += weight[a * npart + b];
+        }
+    }
+    for (int isector = 0; isector < npart * npart; ++isector) {
+        EXPECT_NEAR(weight[isector] / total, count[isector] / nstep, 0.01);
+    }
+}
+
+}
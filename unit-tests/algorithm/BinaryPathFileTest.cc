@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "algorithm/BinaryPathFile.h"
+#include "base/BeadFactory.h"
+#include "base/SerialPaths.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+#include "util/Permutation.h"
+#include "util/SuperCell.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+class BinaryPathFileTest: public ::testing::Test {
+protected:
+    typedef blitz::TinyVector<double, NDIM> Vec;
+
+    virtual void SetUp() {
+        filename = "binarypathfiletest.bin";
+        npart = 3;
+        nslice = 4;
+        std::vector<Species*> speciesList, speciesIndex;
+        speciesList.push_back(new Species("e", 2, 1.0, -1.0, 1, true));
+        speciesList.push_back(new Species("hole", 1, 1.0, 1.0, 1, true));
+        speciesList[1]->ifirst = 2;
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            speciesIndex.push_back(speciesList[ipart < 2 ? 0 : 1]);
+        }
+        SuperCell* cell = new SuperCell(Vec(10.0, 10.0, 10.0));
+        cell->computeRecipricalVectors();
+        simInfo = new SimulationInfo(cell, npart, speciesList, speciesIndex,
+                1.0, 0.1, nslice);
+        paths = new SerialPaths(npart, nslice, 0.1, *cell, beadFactory);
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            for (int islice = 0; islice < nslice; ++islice) {
+                for (int idim = 0; idim < NDIM; ++idim) {
+                    (*paths)(ipart, islice)[idim] =
+                            ipart + 0.1 * islice + 0.01 * idim;
+                }
+            }
+        }
+    }
+
+    virtual void TearDown() {
+        delete paths;
+        delete simInfo;
+        std::remove(filename.c_str());
+    }
+
+    /// Write a snapshot at an offset, with coordinates shifted by shift.
+    long long writeSnapshot(int fd, long long offset,
+            const Permutation& perm, double shift) {
+        std::string header = BinaryPathFile::makeHeader(*simInfo, *paths,
+                perm);
+        BinaryPathFile::writeAt(fd, header.data(), header.size(), offset,
+                filename);
+        std::vector<double> coords;
+        for (int islice = 0; islice < nslice; ++islice) {
+            for (int ipart = 0; ipart < npart; ++ipart) {
+                for (int idim = 0; idim < NDIM; ++idim) {
+                    coords.push_back((*paths)(ipart, islice)[idim] + shift);
+                }
+            }
+        }
+        BinaryPathFile::writeAt(fd, &coords[0],
+                coords.size() * sizeof(double), offset + header.size(),
+                filename);
+        return offset + header.size() + coords.size() * sizeof(double);
+    }
+
+    int npart;
+    int nslice;
+    std::string filename;
+    SimulationInfo *simInfo;
+    BeadFactory beadFactory;
+    Paths *paths;
+};
+
+TEST_F(BinaryPathFileTest, testHeaderAlignsData) {
+    std::string header = BinaryPathFile::makeHeader(*simInfo, *paths,
+            Permutation(npart));
+    EXPECT_EQ(0u, header.size() % 8);
+    EXPECT_EQ(0, header.compare(0, 8, BinaryPathFile::MAGIC, 8));
+}
+
+TEST_F(BinaryPathFileTest, testRoundTrip) {
+    Permutation perm(npart);
+    perm[0] = 1;
+    perm[1] = 0;
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(fd, 0);
+    long long second = writeSnapshot(fd, 0, perm, 0.0);
+    writeSnapshot(fd, second, Permutation(npart), 0.5);
+    close(fd);
+    ASSERT_TRUE(BinaryPathFile::isBinary(filename));
+
+    BinaryPathFile first(filename);
+    EXPECT_EQ(npart, first.getNPart());
+    EXPECT_EQ(nslice, first.getNSlice());
+    ASSERT_EQ(2, first.getNSpecies());
+    EXPECT_EQ("e", first.getSpeciesName(0));
+    EXPECT_EQ(2, first.getSpeciesCount(0));
+    EXPECT_EQ("hole", first.getSpeciesName(1));
+    EXPECT_EQ(1, first.getSpeciesCount(1));
+    EXPECT_EQ(1, first.getPermutation()[0]);
+    EXPECT_EQ(0, first.getPermutation()[1]);
+    EXPECT_EQ(2, first.getPermutation()[2]);
+    EXPECT_EQ("", first.getModelState());
+    // The second frame starts part way through a page.
+    BinaryPathFile next(filename, second);
+    EXPECT_TRUE(next.getPermutation().isIdentity());
+    for (int ipart = 0; ipart < npart; ++ipart) {
+        for (int islice = 0; islice < nslice; ++islice) {
+            for (int idim = 0; idim < NDIM; ++idim) {
+                double r = (*paths)(ipart, islice)[idim];
+                EXPECT_EQ(r, first(ipart, islice)[idim]);
+                EXPECT_EQ(r + 0.5, next(ipart, islice)[idim]);
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include "base/SerialPaths.h"
+#include "base/Beads.h"
+#include "base/BeadFactory.h"
+#include "util/AllocationCounter.h"
+#include "util/Permutation.h"
+#include "util/SuperCell.h"
+#include <blitz/tinyvec-et.h>
+
+namespace {
+
+class SerialPathsTest: public ::testing::Test {
+protected:
+    typedef blitz::TinyVector<double, NDIM> Vec;
+
+    void SetUp() {
+        cell = new SuperCell(SuperCell::Vec(10.0, 10.0, 10.0));
+        npart = 4;
+        nslice = 10;
+    }
+
+    void TearDown() {
+        delete cell;
+    }
+
+    Paths* createPaths() {
+        Paths *paths = new SerialPaths(npart, nslice, 0.01, *cell,
+                beadFactory);
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            for (int islice = 0; islice < nslice; ++islice) {
+                (*paths)(ipart, islice) = Vec(ipart, islice, 0.);
+            }
+        }
+        return paths;
+    }
+
+    Permutation swap(int i, int j) {
+        Permutation p(npart);
+        p[i] = j;
+        p[j] = i;
+        return p;
+    }
+
+    BeadFactory beadFactory;
+    SuperCell *cell;
+    int npart;
+    int nslice;
+};
+
+TEST_F(SerialPathsTest, testPermutationRelabelsFollowingSlices) {
+    Paths *paths = createPaths();
+    Beads<NDIM> *beads = beadFactory.getNewBeads(npart, 3);
+    paths->getBeads(2, *beads);
+    paths->putBeads(2, *beads, swap(1, 2));
+    for (int islice = 0; islice < nslice; ++islice) {
+        bool after = islice >= 5;
+        ASSERT_EQ(0., (*paths)(0, islice)[0]);
+        ASSERT_EQ(after ? 2. : 1., (*paths)(1, islice)[0]);
+        ASSERT_EQ(after ? 1. : 2., (*paths)(2, islice)[0]);
+        ASSERT_EQ(3., (*paths)(3, islice)[0]);
+    }
+    ASSERT_EQ(2, paths->getPermutation()[1]);
+    ASSERT_EQ(1, paths->getPermutation()[2]);
+    delete beads;
+    delete paths;
+}
+
+TEST_F(SerialPathsTest, testPutMovedBeadsMatchesPutBeadsAcrossWrap) {
+    Paths *paths1 = createPaths();
+    Paths *paths2 = createPaths();
+    Beads<NDIM> *beads = beadFactory.getNewBeads(npart, 4);
+    // Give both paths the same nontrivial permutation.
+    paths1->getBeads(3, *beads);
+    paths1->putBeads(3, *beads, swap(0, 3));
+    paths2->putBeads(3, *beads, swap(0, 3));
+    // Move particle 0 on a section that wraps past the last slice.
+    paths1->getBeads(8, *beads);
+    for (int islice = 1; islice < 3; ++islice) {
+        (*beads)(0, islice) += Vec(0.5, 0.25, 0.125);
+    }
+    blitz::Array<int, 1> moved(1);
+    moved(0) = 0;
+    paths1->putBeads(8, *beads, Permutation(npart));
+    paths2->putMovedBeads(8, *beads, Permutation(npart), moved);
+    for (int ipart = 0; ipart < npart; ++ipart) {
+        for (int islice = 0; islice < nslice; ++islice) {
+            for (int idim = 0; idim < NDIM; ++idim) {
+                ASSERT_EQ((*paths1)(ipart, islice)[idim],
+                        (*paths2)(ipart, islice)[idim]);
+            }
+        }
+    }
+    delete beads;
+    delete paths1;
+    delete paths2;
+}
+
+TEST_F(SerialPathsTest, testAcceptedExchangeDoesNotAllocate) {
+    Paths *paths = createPaths();
+    Beads<NDIM> *beads = beadFactory.getNewBeads(npart, 4);
+    Permutation exchange(swap(1, 2));
+    blitz::Array<int, 1> moved(2);
+    moved = 1, 2;
+    // Warm up once, then every accepted exchange must reuse storage,
+    // including sections that wrap past the last slice. The count only
+    // moves when configured with ENABLE_ALLOC_COUNT.
+    paths->getBeads(8, *beads);
+    paths->putMovedBeads(8, *beads, exchange, moved);
+    const long nalloc = AllocationCounter::getCount();
+    for (int ifirst = 0; ifirst < nslice; ++ifirst) {
+        paths->getBeads(ifirst, *beads);
+        paths->putMovedBeads(ifirst, *beads, exchange, moved);
+    }
+    EXPECT_EQ(0, AllocationCounter::getCount() - nalloc);
+    delete beads;
+    delete paths;
+}
+
+}
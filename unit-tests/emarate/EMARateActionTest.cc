@@ -102,7 +102,8 @@ TEST_F(EMARateActionTest, testActionDifferenceWithCoulombAction) {
     double newAction = -log(1 + coefficient * exp(actionDifference));
     double expect = newAction - oldAction;
 
-    ASSERT_DOUBLE_EQ(expect, deltaAction);
+    // EMARateAction interpolates the Coulomb link action from a table.
+    ASSERT_NEAR(expect, deltaAction, 1e-10);
 }
 
 }
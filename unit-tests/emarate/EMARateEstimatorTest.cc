@@ -155,7 +155,8 @@ TEST_F(EMARateEstimatorTest, testCoulombInteraction) {
     actionDifference += 2.0 * coulomb.getValue(zero, delta);
     actionDifference -= 2.0 * coulomb.getValue(delta, delta);
     double expect = 1.0 / (1.0 + exp(-actionDifference));
-    ASSERT_DOUBLE_EQ(expect, value);
+    // EMARateEstimator interpolates the Coulomb link action from a table.
+    ASSERT_NEAR(expect, value, 1e-10);
 }
 
 }
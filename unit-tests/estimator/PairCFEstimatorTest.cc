@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "estimator/PairCFEstimator.h"
+#include "base/BeadFactory.h"
+#include "base/SerialPaths.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+#include "util/PairDistance.h"
+#include "util/RandomNumGenerator.h"
+#include "util/SuperCell.h"
+#include <vector>
+
+namespace {
+
+class PairCFEstimatorTest: public ::testing::Test {
+protected:
+    typedef PairCFEstimator<1> Estimator;
+    typedef blitz::TinyVector<double, NDIM> Vec;
+
+    virtual void SetUp() {
+        npart = 4;
+        nslice = 8;
+        nbin = 20;
+        std::vector<Species*> speciesList, speciesIndex;
+        speciesList.push_back(new Species("e", 2, 1.0, -1.0, 1, true));
+        speciesList.push_back(new Species("h", 2, 1.0, 1.0, 1, true));
+        speciesList[1]->ifirst = 2;
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            speciesIndex.push_back(speciesList[ipart < 2 ? 0 : 1]);
+        }
+        pair[0] = *speciesList[0];
+        pair[1] = *speciesList[1];
+        SuperCell* cell = new SuperCell(Vec(6.0, 6.0, 6.0));
+        cell->computeRecipricalVectors();
+        simInfo = new SimulationInfo(cell, npart, speciesList, speciesIndex,
+                1.0, 0.1, nslice);
+        paths = new SerialPaths(npart, nslice, 0.1, *cell, beadFactory);
+        RandomNumGenerator::seed(31);
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            for (int islice = 0; islice < nslice; ++islice) {
+                for (int idim = 0; idim < NDIM; ++idim) {
+                    (*paths)(ipart, islice)[idim] =
+                            3.0 * (RandomNumGenerator::getRand() - 0.5);
+                }
+            }
+        }
+    }
+
+    virtual void TearDown() {
+        delete paths;
+        delete simInfo;
+    }
+
+    Estimator* createEstimator(bool sparse) {
+        Estimator::DistN dist(1, new PairRadial());
+        return new Estimator(*simInfo, "g", pair, 2,
+                Estimator::VecN(0.0), Estimator::VecN(5.0),
+                Estimator::IVecN(nbin), dist, 0, sparse);
+    }
+
+    int npart;
+    int nslice;
+    int nbin;
+    Species pair[2];
+    SimulationInfo *simInfo;
+    BeadFactory beadFactory;
+    Paths *paths;
+};
+
+TEST_F(PairCFEstimatorTest, testSparseMatchesDense) {
+    Estimator *dense = createEstimator(false);
+    Estimator *sparse = createEstimator(true);
+    ASSERT_TRUE(sparse->isSparse());
+    dense->evaluate(*paths);
+    sparse->evaluate(*paths);
+    dense->averageOverClones(0);
+    sparse->averageOverClones(0);
+    std::vector<float> unpacked(nbin, 0.0f);
+    for (int itile = 0; itile < sparse->getNTile(); ++itile) {
+        int origin;
+        sparse->getTileOrigin(itile, &origin);
+        const float *p = static_cast<const float*>(sparse->getTileData(itile));
+        for (int i = 0; i < sparse->getTileExtent(0); ++i) {
+            if (origin + i < nbin) unpacked[origin + i] = p[i];
+        }
+    }
+    const float *expect = static_cast<const float*>(dense->getData());
+    double total = 0.0;
+    for (int ibin = 0; ibin < nbin; ++ibin) {
+        EXPECT_FLOAT_EQ(expect[ibin], unpacked[ibin]);
+        total += unpacked[ibin];
+    }
+    // Each electron bead sees both holes unless they fall past the last bin.
+    EXPECT_GT(total, 0.0);
+    EXPECT_LE(total, 4.0 + 1e-5);
+    delete dense;
+    delete sparse;
+}
+
+}
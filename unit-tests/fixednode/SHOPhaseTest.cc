@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <vector>
+#include "fixednode/SHOPhase.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+
+namespace {
+
+class SHOPhaseTest: public ::testing::Test {
+protected:
+    typedef SHOPhase::Vec Vec;
+    typedef SHOPhase::VArray VArray;
+    typedef SHOPhase::IArray IArray;
+
+    virtual void SetUp() {
+        std::vector<Species*> speciesList;
+        speciesList.push_back(new Species("e", npart, 1.0, -1.0, 1, true));
+        std::vector<Species*> speciesIndex(npart, speciesList[0]);
+        simInfo = new SimulationInfo(0, npart, speciesList, speciesIndex,
+                                     1.0, 0.1, 8);
+        const Species& species(simInfo->getSpecies(0));
+        updatePhase = new SHOPhase(*simInfo, species, 1.0, 1.0, 2.0, 2,
+                                   true, 100);
+        fullPhase = new SHOPhase(*simInfo, species, 1.0, 1.0, 2.0, 2);
+        r1.resize(npart);
+        r2.resize(npart);
+        for (int i = 0; i < npart; ++i) {
+            for (int idim = 0; idim < NDIM; ++idim) {
+                r1(i)[idim] = 0.3 * cos(1.7 * i + idim);
+                r2(i)[idim] = 0.4 * sin(0.9 * i - 2.1 * idim);
+            }
+        }
+    }
+
+    virtual void TearDown() {
+        delete updatePhase;
+        delete fullPhase;
+        delete simInfo;
+    }
+
+    void expectSamePhase(const SHOPhase& a, const SHOPhase& b) {
+        double deltaPhi = a.getPhi() - b.getPhi();
+        EXPECT_NEAR(0.0, sin(deltaPhi), 1e-10);
+        EXPECT_LT(0.0, cos(deltaPhi));
+        for (int i = 0; i < npart; ++i) {
+            for (int idim = 0; idim < NDIM; ++idim) {
+                EXPECT_NEAR(b.getGradPhi(1)(i)[idim],
+                            a.getGradPhi(1)(i)[idim], 1e-9);
+                EXPECT_NEAR(b.getGradPhi(2)(i)[idim],
+                            a.getGradPhi(2)(i)[idim], 1e-9);
+            }
+        }
+    }
+
+    SimulationInfo *simInfo;
+    SHOPhase *updatePhase;
+    SHOPhase *fullPhase;
+    VArray r1, r2;
+    static const int npart = 5;
+};
+
+TEST_F(SHOPhaseTest, TestColumnUpdate) {
+    updatePhase->evaluate(r1, r2, 1);
+    IArray index1(2), index2(0);
+    index1 = 1, 3;
+    r1(1) += 0.2;
+    r1(3) -= 0.1;
+    updatePhase->getUpdateObj()->evaluateChange(r1, r2, index1, index2, 1);
+    fullPhase->evaluate(r1, r2, 1);
+    expectSamePhase(*updatePhase, *fullPhase);
+}
+
+TEST_F(SHOPhaseTest, TestRowAndColumnUpdate) {
+    updatePhase->evaluate(r1, r2, 1);
+    IArray index1(2), index2(2);
+    index1 = 0, 4;
+    index2 = 4, 2;
+    r1(0) += 0.15;
+    r1(4) -= 0.25;
+    r2(4) += 0.1;
+    r2(2) -= 0.3;
+    updatePhase->getUpdateObj()->evaluateChange(r1, r2, index1, index2, 1);
+    fullPhase->evaluate(r1, r2, 1);
+    expectSamePhase(*updatePhase, *fullPhase);
+}
+
+TEST_F(SHOPhaseTest, TestUpdateAfterAccept) {
+    for (int islice = 0; islice < 2; ++islice) {
+        updatePhase->evaluate(r1, r2, islice);
+    }
+    IArray index1(1), index2(0);
+    index1 = 2;
+    r1(2) += 0.2;
+    updatePhase->getUpdateObj()->evaluateChange(r1, r2, index1, index2, 1);
+    updatePhase->getUpdateObj()->acceptLastMove(2);
+    index1 = 3;
+    r1(3) -= 0.2;
+    updatePhase->getUpdateObj()->evaluateChange(r1, r2, index1, index2, 1);
+    fullPhase->evaluate(r1, r2, 1);
+    expectSamePhase(*updatePhase, *fullPhase);
+}
+
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "parser/PIMCParser.h"
+#include "action/CompositeAction.h"
+#include "advancer/MultiLevelSampler.h"
+#include "advancer/SectionChooser.h"
+#include "algorithm/Collect.h"
+#include "algorithm/CompositeAlgorithm.h"
+#include "base/BeadFactory.h"
+#include "base/SimulationInfo.h"
+#include "base/Species.h"
+#include "stats/Estimator.h"
+#include "stats/EstimatorManager.h"
+#include "util/SuperCell.h"
+#include <libxml/parser.h>
+#include <libxml/xpath.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+class PIMCParserTest: public ::testing::Test {
+protected:
+    typedef blitz::TinyVector<double, NDIM> Vec;
+
+    virtual void SetUp() {
+        npart = 2;
+        std::vector<Species*> speciesList, speciesIndex;
+        speciesList.push_back(new Species("e", npart, 1.0, -1.0, 1, true));
+        for (int ipart = 0; ipart < npart; ++ipart) {
+            speciesIndex.push_back(speciesList[0]);
+        }
+        SuperCell* cell = new SuperCell(Vec(10.0, 10.0, 10.0));
+        cell->computeRecipricalVectors();
+        simInfo = new SimulationInfo(cell, npart, speciesList, speciesIndex,
+                1.0, 0.1, 10);
+        estimators = new EstimatorManager("pimcparsertest.h5", 0, 0);
+        doc = 0;
+        ctxt = 0;
+    }
+
+    virtual void TearDown() {
+        if (ctxt) xmlXPathFreeContext(ctxt);
+        if (doc) xmlFreeDoc(doc);
+        delete estimators;
+        delete simInfo;
+    }
+
+    /// Parse the PIMC element of an xml document.
+    PIMCParser* parse(const char* xml) {
+        doc = xmlReadMemory(xml, strlen(xml), "test.xml", 0, 0);
+        ctxt = xmlXPathNewContext(doc);
+        PIMCParser* parser = new PIMCParser(*simInfo, new CompositeAction(),
+                0, 0, estimators, beadFactory);
+        parser->parse(ctxt);
+        return parser;
+    }
+
+    /// Whether an estimator name starts with a prefix.
+    bool hasEstimator(const std::string& prefix) {
+        std::vector<Estimator*>& all(estimators->getEstimatorSet("all"));
+        for (unsigned int i = 0; i < all.size(); ++i) {
+            if (all[i]->getName().compare(0, prefix.size(), prefix) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int npart;
+    SimulationInfo *simInfo;
+    EstimatorManager *estimators;
+    BeadFactory beadFactory;
+    xmlDocPtr doc;
+    xmlXPathContextPtr ctxt;
+};
+
+TEST_F(PIMCParserTest, testReplicasGetOwnSamplers) {
+    PIMCParser* parser = parse("<Simulation><PIMC nreplica=\"2\">"
+            "<Loop nrepeat=\"1\"><ChooseSection nlevel=\"2\">"
+            "<Sample npart=\"1\" mover=\"Free\"/></ChooseSection>"
+            "<Collect/></Loop></PIMC></Simulation>");
+    CompositeAlgorithm* pimc =
+            dynamic_cast<CompositeAlgorithm*>(parser->getAlgorithm());
+    ASSERT_TRUE(pimc);
+    ASSERT_EQ(1, pimc->getNStep());
+    CompositeAlgorithm* loop = dynamic_cast<CompositeAlgorithm*>(pimc->get(0));
+    ASSERT_TRUE(loop);
+    // One batch of section choosers, and a single Collect after it.
+    ASSERT_EQ(2, loop->getNStep());
+    EXPECT_TRUE(dynamic_cast<Collect*>(loop->get(1)));
+    CompositeAlgorithm* batch = dynamic_cast<CompositeAlgorithm*>(loop->get(0));
+    ASSERT_TRUE(batch);
+    ASSERT_EQ(2, batch->getNStep());
+    const Paths* replicaPaths[2];
+    for (int ireplica = 0; ireplica < 2; ++ireplica) {
+        SectionChooser* chooser =
+                dynamic_cast<SectionChooser*>(batch->get(ireplica));
+        ASSERT_TRUE(chooser);
+        ASSERT_EQ(1, chooser->getNStep());
+        MultiLevelSampler* sampler =
+                dynamic_cast<MultiLevelSampler*>(chooser->get(0));
+        ASSERT_TRUE(sampler);
+        replicaPaths[ireplica] = &sampler->getPaths();
+    }
+    EXPECT_NE(replicaPaths[0], replicaPaths[1]);
+    EXPECT_TRUE(hasEstimator("MLSampler: "));
+    EXPECT_TRUE(hasEstimator("MLSampler_r1: "));
+    EXPECT_FALSE(hasEstimator("MLSampler_r2"));
+    delete parser;
+}
+
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "stats/BlockingAnalysis.h"
+#include "util/RandomNumGenerator.h"
+#include <cmath>
+
+namespace {
+
+class BlockingAnalysisTest: public ::testing::Test {
+protected:
+    BlockingAnalysis blocking;
+};
+
+TEST_F(BlockingAnalysisTest, testEmptyAnalysis) {
+    ASSERT_EQ(0, blocking.getSampleCount());
+    ASSERT_DOUBLE_EQ(0.0, blocking.getError());
+}
+
+TEST_F(BlockingAnalysisTest, testMean) {
+    for (int i = 0; i < 10; ++i) {
+        blocking.addSample(i);
+    }
+    ASSERT_EQ(10, blocking.getSampleCount());
+    ASSERT_DOUBLE_EQ(4.5, blocking.getMean());
+}
+
+TEST_F(BlockingAnalysisTest, testUncorrelatedSeries) {
+    RandomNumGenerator::seed(3);
+    for (int i = 0; i < 4096; ++i) {
+        blocking.addSample(RandomNumGenerator::getRand() - 0.5);
+    }
+    double naiveError = std::sqrt(blocking.getNaiveVariance());
+    ASSERT_NEAR(1.0 / std::sqrt(12. * 4096.), naiveError, 0.05 * naiveError);
+    ASSERT_NEAR(naiveError, blocking.getError(), 0.35 * naiveError);
+    ASSERT_NEAR(1.0, blocking.getAutocorrelationTime(), 0.75);
+}
+
+TEST_F(BlockingAnalysisTest, testAntiCorrelatedSeriesKeepsNaiveError) {
+    for (int i = 0; i < 1024; ++i) {
+        blocking.addSample((i % 2 == 0) ? 1.0 : -1.0);
+    }
+    double naiveError = std::sqrt(blocking.getNaiveVariance());
+    ASSERT_NEAR(1.0 / std::sqrt(1023.), naiveError, 1e-12);
+    ASSERT_DOUBLE_EQ(naiveError, blocking.getError());
+    ASSERT_DOUBLE_EQ(1.0, blocking.getAutocorrelationTime());
+}
+
+TEST_F(BlockingAnalysisTest, testRepeatedSamplesAreCorrelated) {
+    const int repeat = 8;
+    for (int i = 0; i < 1024; ++i) {
+        double x = ((i / repeat) % 2 == 0) ? 1.0 : -1.0;
+        blocking.addSample(x);
+    }
+    ASSERT_NEAR(repeat, blocking.getAutocorrelationTime(), 0.1);
+    ASSERT_NEAR(1024. / repeat, blocking.getEffectiveSampleCount(), 2.);
+}
+
+TEST_F(BlockingAnalysisTest, testReset) {
+    blocking.addSample(1.0);
+    blocking.addSample(2.0);
+    blocking.reset();
+    ASSERT_EQ(0, blocking.getSampleCount());
+}
+
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "util/AliasTable.h"
+#include <vector>
+
+namespace {
+
+class AliasTableTest: public ::testing::Test {
+protected:
+    /// Exact probability of each slot, found by sweeping u over [0,1).
+    std::vector<double> sweep(const AliasTable& table, int begin, int end,
+            int nsweep = 100000) {
+        std::vector<double> p(end, 0.);
+        for (int i = 0; i < nsweep; ++i) {
+            p[table.sample(begin, end, (i + 0.5) / nsweep)] += 1. / nsweep;
+        }
+        return p;
+    }
+};
+
+TEST_F(AliasTableTest, testReproducesWeights) {
+    std::vector<double> weight;
+    weight.push_back(1.);
+    weight.push_back(2.);
+    weight.push_back(3.);
+    weight.push_back(4.);
+    AliasTable table;
+    table.resize(4);
+    table.build(weight, 0, 4);
+    std::vector<double> p = sweep(table, 0, 4);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_NEAR(weight[i] / 10., p[i], 1e-4);
+    }
+}
+
+TEST_F(AliasTableTest, testRowsAreIndependent) {
+    std::vector<double> weight;
+    weight.push_back(5.);
+    weight.push_back(1e-30);
+    weight.push_back(0.);
+    weight.push_back(2.);
+    weight.push_back(6.);
+    AliasTable table;
+    table.resize(5);
+    table.build(weight, 0, 2);
+    table.build(weight, 2, 5);
+    std::vector<double> p = sweep(table, 2, 5);
+    ASSERT_DOUBLE_EQ(0., p[0] + p[1]);
+    ASSERT_NEAR(0., p[2], 1e-12);
+    ASSERT_NEAR(0.25, p[3], 1e-4);
+    ASSERT_NEAR(0.75, p[4], 1e-4);
+    p = sweep(table, 0, 2);
+    ASSERT_NEAR(1., p[0], 1e-10);
+}
+
+}
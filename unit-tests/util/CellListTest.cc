@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "util/CellList.h"
+#include "util/SuperCell.h"
+#include <blitz/tinyvec-et.h>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+class CellListTest: public ::testing::Test {
+protected:
+    typedef blitz::TinyVector<double,NDIM> Vec;
+
+    CellListTest()
+    :   cell(Vec(10., 10., 4.)) {
+        cell.computeRecipricalVectors();
+    }
+
+    virtual void SetUp() {
+        for (int i = 0; i < npart; ++i) {
+            r[i] = Vec(0.37 * ((i * 7) % 27), 0.41 * ((i * 11) % 23),
+                    0.13 * ((i * 5) % 31));
+            cell.pbc(r[i]);
+        }
+    }
+
+    bool isCandidate(const CellList& cellList, const Vec& ri, int j) const {
+        std::vector<int> list;
+        cellList.getCandidates(ri, list);
+        return std::find(list.begin(), list.end(), j) != list.end();
+    }
+
+    static const int npart = 40;
+    SuperCell cell;
+    Vec r[npart];
+};
+
+TEST_F(CellListTest, testBoxCount) {
+    CellList cellList(cell, 3., npart);
+    ASSERT_EQ(3, cellList.getNCell(0));
+    ASSERT_EQ(3, cellList.getNCell(1));
+    ASSERT_EQ(1, cellList.getNCell(2));
+}
+
+TEST_F(CellListTest, testCandidatesIncludeNeighbors) {
+    const double rcut = 3.;
+    CellList cellList(cell, rcut, npart);
+    for (int i = 0; i < npart; ++i) cellList.move(i, r[i]);
+    for (int i = 0; i < npart; ++i) {
+        std::vector<int> list;
+        cellList.getCandidates(r[i], list);
+        std::vector<int> sorted(list);
+        std::sort(sorted.begin(), sorted.end());
+        ASSERT_TRUE(std::unique(sorted.begin(), sorted.end()) == sorted.end());
+        for (int j = 0; j < npart; ++j) {
+            Vec delta = r[i] - r[j];
+            cell.pbc(delta);
+            if (sqrt(dot(delta, delta)) < rcut) {
+                ASSERT_TRUE(isCandidate(cellList, r[i], j));
+            }
+        }
+    }
+}
+
+TEST_F(CellListTest, testMove) {
+    CellList cellList(cell, 2., npart);
+    for (int i = 0; i < npart; ++i) cellList.move(i, r[i]);
+    Vec far(-4.5, -4.5, 0.);
+    Vec near(4.5, 4.5, 0.);
+    cellList.move(0, near);
+    EXPECT_TRUE(isCandidate(cellList, near, 0));
+    cellList.move(0, far);
+    // Boxes are 2 wide, so the corner box is not adjacent to the center.
+    EXPECT_FALSE(isCandidate(cellList, Vec(0., 0., 0.), 0));
+    EXPECT_TRUE(isCandidate(cellList, far, 0));
+    cellList.clear();
+    EXPECT_FALSE(isCandidate(cellList, far, 0));
+}
+
+}
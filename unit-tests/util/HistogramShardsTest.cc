@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "util/HistogramShards.h"
+
+namespace {
+
+class HistogramShardsTest: public ::testing::Test {
+protected:
+    typedef blitz::Array<float, 2> Array2;
+};
+
+TEST_F(HistogramShardsTest, testThreadedCountsMatchSerial) {
+    const int n0 = 37, n1 = 53, nsample = 20000;
+    Array2 hist(n0, n1);
+    hist = 1.;
+    HistogramShards<float, 2> shards;
+    shards.init(hist);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int k = 0; k < nsample; ++k) {
+        ++shards.get()(k % n0, (7 * k) % n1);
+    }
+    shards.reduce();
+    Array2 expect(n0, n1);
+    expect = 1.;
+    for (int k = 0; k < nsample; ++k) {
+        ++expect(k % n0, (7 * k) % n1);
+    }
+    for (int i = 0; i < n0; ++i) {
+        for (int j = 0; j < n1; ++j) {
+            ASSERT_FLOAT_EQ(expect(i, j), hist(i, j));
+        }
+    }
+}
+
+TEST_F(HistogramShardsTest, testShardsAreClearedOnInit) {
+    Array2 hist(4, 5);
+    hist = 0.;
+    HistogramShards<float, 2> shards;
+    for (int pass = 0; pass < 3; ++pass) {
+        shards.init(hist);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int k = 0; k < 100; ++k) {
+            ++shards.get()(k % 4, k % 5);
+        }
+        shards.reduce();
+    }
+    EXPECT_FLOAT_EQ(300., blitz::sum(hist));
+}
+
+}
@@ -1,10 +1,33 @@
 #include <gtest/gtest.h>
 #include "util/Hungarian.h"
+#include <algorithm>
+#include <cmath>
 
 namespace {
 
 class HungarianTest: public ::testing::Test {
 protected:
+    static const int N = 6;
+
+    /// Fill a column-major cost matrix with scrambled values.
+    static void fill(double *matrix, int seed) {
+        for (int i = 0; i < N * N; ++i) {
+            matrix[i] = fabs(sin(1.7 * i + 0.3 * seed)) * 10.;
+        }
+    }
+
+    /// Smallest assignment cost by trying every permutation.
+    static double bruteForce(const double *matrix) {
+        int perm[N];
+        for (int i = 0; i < N; ++i) perm[i] = i;
+        double best = 1e100;
+        do {
+            double sum = 0.;
+            for (int i = 0; i < N; ++i) sum += matrix[i + perm[i] * N];
+            best = std::min(best, sum);
+        } while (std::next_permutation(perm, perm + N));
+        return best;
+    }
 };
 
 TEST_F(HungarianTest, testMinusIdentityMatrix) {
@@ -45,4 +68,59 @@ TEST_F(HungarianTest, testFindSmallestSumIsTen) {
         ASSERT_EQ(expect[index], hungarian[index]);
     }
 }
+
+TEST_F(HungarianTest, testMatchesBruteForce) {
+    double matrix[N * N];
+    Hungarian hungarian(N);
+    for (int seed = 0; seed < 5; ++seed) {
+        fill(matrix, seed);
+        hungarian.solve(matrix);
+        ASSERT_NEAR(bruteForce(matrix), hungarian.getSum(), 1e-12);
+    }
+}
+
+TEST_F(HungarianTest, testWarmStartWithOptimalGuess) {
+    double matrix[N * N];
+    fill(matrix, 1);
+    Hungarian hungarian(N);
+    hungarian.solve(matrix);
+    int guess[N];
+    for (int i = 0; i < N; ++i) guess[i] = hungarian[i];
+    hungarian.solve(matrix, guess);
+    ASSERT_EQ(0, hungarian.getAugmentCount());
+    for (int i = 0; i < N; ++i) ASSERT_EQ(guess[i], hungarian[i]);
+}
+
+TEST_F(HungarianTest, testWarmStartAfterChange) {
+    double matrix[N * N];
+    fill(matrix, 2);
+    Hungarian hungarian(N);
+    hungarian.solve(matrix);
+    int guess[N];
+    for (int seed = 3; seed < 8; ++seed) {
+        for (int i = 0; i < N; ++i) guess[i] = hungarian[i];
+        double next[N * N];
+        fill(next, seed);
+        for (int i = 0; i < N * N; ++i) matrix[i] = 0.8 * matrix[i] + 0.2 * next[i];
+        hungarian.solve(matrix, guess);
+        ASSERT_NEAR(bruteForce(matrix), hungarian.getSum(), 1e-12);
+    }
+}
+
+TEST_F(HungarianTest, testManyWarmStarts) {
+    double matrix[N * N];
+    fill(matrix, 0);
+    Hungarian hungarian(N);
+    hungarian.solve(matrix);
+    int guess[N];
+    // Unrelated matrices force augmenting on most solves.
+    for (int seed = 1; seed <= 2000; ++seed) {
+        for (int i = 0; i < N; ++i) guess[i] = hungarian[i];
+        fill(matrix, seed);
+        hungarian.solve(matrix, guess);
+        if (seed % 100 == 0) {
+            ASSERT_NEAR(bruteForce(matrix), hungarian.getSum(), 1e-12);
+        }
+    }
+}
 }
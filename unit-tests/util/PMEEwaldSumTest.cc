@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "util/OptEwaldSum.h"
+#include "util/PMEEwaldSum.h"
+#include "util/SuperCell.h"
+#include <blitz/tinyvec-et.h>
+
+namespace {
+
+class PMEEwaldSumTest: public ::testing::Test {
+protected:
+    typedef EwaldSum::Vec Vec;
+    typedef EwaldSum::VArray VArray;
+
+    PMEEwaldSumTest()
+    :   cell(Vec(6., 7., 8.)), npart(8), r(npart), force(npart) {
+        cell.computeRecipricalVectors();
+        for (int i = 0; i < npart; ++i) {
+            r(i) = Vec(0.73 * i - 2.9, 1.31 * ((i * i) % 7) - 3.4, 2.17 * i - 4.);
+        }
+    }
+
+    void setCharges(EwaldSum& ewald) {
+        for (int i = 0; i < npart; ++i) {
+            ewald.getQArray()(i) = (i % 2 == 0) ? 1. : -1.;
+        }
+        ewald.evalSelfEnergy();
+    }
+
+    void expectForceIsGradient(const EwaldSum& ewald, double tol) {
+        ewald.evalLongRange(r, force);
+        const double h = 1e-5;
+        for (int i = 0; i < npart; ++i) {
+            for (int idim = 0; idim < NDIM; ++idim) {
+                VArray rp(r.copy()), rm(r.copy());
+                rp(i)[idim] += h;
+                rm(i)[idim] -= h;
+                double f = -(ewald.evalLongRange(rp)
+                        - ewald.evalLongRange(rm)) / (2 * h);
+                EXPECT_NEAR(f, force(i)[idim], tol);
+            }
+        }
+    }
+
+    SuperCell cell;
+    const int npart;
+    VArray r, force;
+};
+
+TEST_F(PMEEwaldSumTest, testEnergyMatchesDirectSum) {
+    OptEwaldSum direct(cell, npart, 3., 2.5, 10., 8);
+    PMEEwaldSum pme(cell, npart, 3., 2.5, 10., 8);
+    setCharges(direct);
+    setCharges(pme);
+    double e = direct.evalLongRange(r);
+    EXPECT_NEAR(e, pme.evalLongRange(r), 1e-4 * fabs(e));
+    // Forces with the energy should give the same energy.
+    EXPECT_NEAR(e, pme.evalLongRange(r, force), 1e-4 * fabs(e));
+}
+
+TEST_F(PMEEwaldSumTest, testMeshSize) {
+    PMEEwaldSum pme(cell, npart, 3., 2.5, 10., 8, 6, 2.);
+    // Two k-vectors each way and the origin, doubled and rounded up.
+    EXPECT_EQ(10, pme.getMeshSize(0));
+    EXPECT_EQ(15, pme.getMeshSize(2));
+}
+
+TEST_F(PMEEwaldSumTest, testPMEForceIsGradient) {
+    PMEEwaldSum pme(cell, npart, 3., 2.5, 10., 8);
+    setCharges(pme);
+    expectForceIsGradient(pme, 1e-6);
+}
+
+TEST_F(PMEEwaldSumTest, testDirectForceIsGradient) {
+    OptEwaldSum direct(cell, npart, 3., 2.5, 10., 8);
+    setCharges(direct);
+    expectForceIsGradient(direct, 1e-6);
+}
+
+TEST_F(PMEEwaldSumTest, testForcesMatchDirectSum) {
+    OptEwaldSum direct(cell, npart, 3., 2.5, 10., 8);
+    PMEEwaldSum pme(cell, npart, 3., 2.5, 10., 8);
+    setCharges(direct);
+    setCharges(pme);
+    VArray directForce(npart);
+    direct.evalLongRange(r, directForce);
+    pme.evalLongRange(r, force);
+    for (int i = 0; i < npart; ++i) {
+        for (int idim = 0; idim < NDIM; ++idim) {
+            EXPECT_NEAR(directForce(i)[idim], force(i)[idim], 1e-4);
+        }
+    }
+}
+
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "util/TiledArray.h"
+#include <blitz/tinyvec-et.h>
+
+namespace {
+
+class TiledArrayTest: public ::testing::Test {
+protected:
+    typedef TiledArray<float, 3> Tiled3;
+    typedef Tiled3::IVecN IVec3;
+    typedef blitz::Array<float, 3> Array3;
+
+    void expectEqual(const Array3& dense, const Tiled3& tiled) {
+        Array3 copy(dense.shape());
+        copy = 0.;
+        for (int itile = 0; itile < tiled.getNTile(); ++itile) {
+            IVec3 origin = tiled.getTileOrigin(itile);
+            const float *p = tiled.getTileData(itile);
+            int k = 0;
+            for (int i = 0; i < tiled.getTileExtent(0); ++i)
+                for (int j = 0; j < tiled.getTileExtent(1); ++j)
+                    for (int l = 0; l < tiled.getTileExtent(2); ++l, ++k) {
+                        IVec3 ibin = origin + IVec3(i, j, l);
+                        if (ibin[0] < dense.extent(0)
+                                && ibin[1] < dense.extent(1)
+                                && ibin[2] < dense.extent(2)) {
+                            copy(ibin) = p[k];
+                        } else {
+                            EXPECT_EQ(0., p[k]);
+                        }
+                    }
+        }
+        for (int i = 0; i < dense.extent(0); ++i)
+            for (int j = 0; j < dense.extent(1); ++j)
+                for (int l = 0; l < dense.extent(2); ++l)
+                    EXPECT_EQ(dense(i, j, l), copy(i, j, l));
+    }
+};
+
+TEST_F(TiledArrayTest, testOnlyTouchedTilesAreAllocated) {
+    Tiled3 tiled(IVec3(100, 100, 100));
+    EXPECT_EQ(16, tiled.getTileExtent(0));
+    EXPECT_EQ(0, tiled.getNTile());
+    ++tiled(IVec3(0, 0, 0));
+    ++tiled(IVec3(15, 15, 15));
+    ++tiled(IVec3(99, 99, 99));
+    EXPECT_EQ(2, tiled.getNTile());
+    EXPECT_EQ(2 * 4096, tiled.size());
+    EXPECT_EQ(96, tiled.getTileOrigin(1)[2]);
+    EXPECT_EQ(2., tiled(IVec3(99, 99, 99)) + tiled(IVec3(0, 0, 0)));
+}
+
+TEST_F(TiledArrayTest, testCountsMatchDenseArray) {
+    const IVec3 n(21, 37, 9);
+    Tiled3 tiled(n, 64);
+    Array3 dense(n);
+    dense = 0.;
+    for (int k = 0; k < 5000; ++k) {
+        IVec3 ibin((3 * k) % n[0], (k * k) % n[1], (7 * k) % n[2]);
+        ++tiled(ibin);
+        ++dense(ibin);
+    }
+    expectEqual(dense, tiled);
+}
+
+TEST_F(TiledArrayTest, testShardsAddIntoTarget) {
+    const IVec3 n(40, 40, 40);
+    Tiled3 target(n), other(n);
+    Array3 dense(n);
+    dense = 0.;
+    ++target(IVec3(1, 2, 3));
+    dense(1, 2, 3) = 1.;
+    TiledArrayShards<float, 3> shards;
+    shards.init(target, n);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int k = 0; k < 3000; ++k) {
+        ++shards.get()(IVec3(k % n[0], (11 * k) % n[1], (5 * k) % n[2]));
+    }
+    shards.reduce();
+    for (int k = 0; k < 3000; ++k) {
+        ++dense(k % n[0], (11 * k) % n[1], (5 * k) % n[2]);
+    }
+    expectEqual(dense, target);
+    other.add(target, 0.5);
+    dense *= 0.5;
+    expectEqual(dense, other);
+}
+
+}
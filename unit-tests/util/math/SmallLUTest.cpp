@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "util/math/SmallLU.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+class SmallLUTest: public ::testing::Test {
+protected:
+    void SetUp() {
+        n = 4;
+        // Column-major matrix with determinant -119 that needs pivoting.
+        double values[] = {0., 2., 1., 0.,
+                           1., 0., 0., 3.,
+                           4., 1., 0., 0.,
+                           0., 0., 5., 1.};
+        a.assign(values, values + 16);
+        ipiv.resize(n);
+        work.resize(n * n);
+    }
+
+    int n;
+    std::vector<double> a;
+    std::vector<int> ipiv;
+    std::vector<double> work;
+};
+
+TEST_F(SmallLUTest, testLogDetAndSign) {
+    int sign = 0;
+    std::vector<double> lu(a);
+    double logDet = SmallLU::factor(&lu[0], n, &ipiv[0], sign);
+    ASSERT_EQ(-1, sign);
+    ASSERT_NEAR(log(119.), logDet, 1e-12);
+}
+
+TEST_F(SmallLUTest, testInverse) {
+    int sign = 0;
+    std::vector<double> inv(a);
+    SmallLU::factor(&inv[0], n, &ipiv[0], sign);
+    SmallLU::invert(&inv[0], n, &ipiv[0], &work[0]);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double sum = 0.;
+            for (int k = 0; k < n; ++k)
+                sum += a[i + k * n] * inv[k + j * n];
+            ASSERT_NEAR((i == j) ? 1. : 0., sum, 1e-12);
+        }
+    }
+}
+
+TEST_F(SmallLUTest, testSingularMatrix) {
+    for (int i = 0; i < n; ++i)
+        a[i + 2 * n] = 2 * a[i];
+    int sign = 1;
+    SmallLU::factor(&a[0], n, &ipiv[0], sign);
+    ASSERT_EQ(0, sign);
+}
+
+}
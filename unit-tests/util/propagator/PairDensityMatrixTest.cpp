@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "util/propagator/PairDensityMatrix.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+class PairDensityMatrixTest: public testing::Test {
+protected:
+    void SetUp() {
+        mass = 1.0;
+        omega = 1.0;
+        tau = 0.1;
+    }
+
+    static double zeroPotential(double r) {
+        return 0.0;
+    }
+
+    static double harmonicPotential(double r) {
+        return 0.5 * r * r;
+    }
+
+    /// Exact harmonic action, -ln(rho/rho0) for the 3D oscillator.
+    double harmonicAction(double r1, double r2, double cosTheta) {
+        return harmonicAction(r1, r2, cosTheta, tau);
+    }
+
+    double harmonicAction(double r1, double r2, double cosTheta,
+            double tau) {
+        double sinhwt = sinh(omega * tau);
+        double coshwt = cosh(omega * tau);
+        double s2 = r1 * r1 + r2 * r2 - 2.0 * r1 * r2 * cosTheta;
+        double logRho = 1.5 * log(mass * omega * tau / sinhwt)
+                - mass * omega * ((r1 * r1 + r2 * r2) * coshwt
+                        - 2.0 * r1 * r2 * cosTheta) / (2.0 * sinhwt);
+        double logRho0 = -0.5 * mass * s2 / tau;
+        return logRho0 - logRho;
+    }
+
+    double mass;
+    double omega;
+    double tau;
+};
+
+TEST_F(PairDensityMatrixTest, TestZeroPotential) {
+    PairDensityMatrix matrix(mass, tau, 2.5, 0.04, 30);
+    matrix.setPotential(zeroPotential);
+    matrix.propagate();
+    EXPECT_NEAR(0.0, matrix.evaluate(1.0, 1.0, 1.0), 1e-8);
+    EXPECT_NEAR(0.0, matrix.evaluate(0.3, 0.5, 0.8), 1e-8);
+    EXPECT_NEAR(0.0, matrix.evaluate(1.5, 1.3, 0.95), 1e-8);
+}
+
+TEST_F(PairDensityMatrixTest, TestHarmonicAction) {
+    PairDensityMatrix matrix(mass, tau, 2.5, 0.04, 30);
+    matrix.setPotential(harmonicPotential);
+    matrix.propagate();
+    EXPECT_NEAR(harmonicAction(1.0, 1.0, 1.0),
+            matrix.evaluate(1.0, 1.0, 1.0), 2e-5);
+    EXPECT_NEAR(harmonicAction(0.3, 0.5, 0.8),
+            matrix.evaluate(0.3, 0.5, 0.8), 2e-5);
+    EXPECT_NEAR(harmonicAction(1.5, 1.3, 0.95),
+            matrix.evaluate(1.5, 1.3, 0.95), 2e-5);
+}
+
+TEST_F(PairDensityMatrixTest, TestWriteTables) {
+    PairDensityMatrix matrix(mass, tau, 2.5, 0.04, 30);
+    matrix.setPotential(harmonicPotential);
+    const std::string filename = "PairDensityMatrixTest";
+    matrix.write(filename, 2, true, 0.1, 1.5, 20);
+    std::ifstream ufile((filename + ".dmu").c_str());
+    std::ifstream efile((filename + ".dme").c_str());
+    int lineCount = 0;
+    std::string uline, eline;
+    while (getline(ufile, uline) && getline(efile, eline)) {
+        std::istringstream ustream(uline), estream(eline);
+        double q, qe, u[6], utau[6];
+        ustream >> q;
+        estream >> qe;
+        for (int i = 0; i < 6; ++i) ustream >> u[i] >> std::ws;
+        for (int i = 0; i < 6; ++i) estream >> utau[i];
+        ASSERT_TRUE(ustream.eof());
+        EXPECT_DOUBLE_EQ(q, qe);
+        double expect = harmonicAction(q, q, 1.0);
+        EXPECT_NEAR(expect, u[0], 2e-5);
+        double expectTau = (harmonicAction(q, q, 1.0, 1.01 * tau)
+                - harmonicAction(q, q, 1.0, 0.99 * tau)) / (0.02 * tau);
+        EXPECT_NEAR(expectTau, utau[0], 2e-4);
+        double s2 = 0.25 * q * q;
+        double z2 = 0.01 * q * q;
+        double r1 = q + 0.05 * q, r2 = q - 0.05 * q;
+        double cosTheta = (r1 * r1 + r2 * r2 - 0.25 * q * q) / (2 * r1 * r2);
+        double fit = u[0] + u[1] * s2 / (q * q) + u[2] * z2 / (q * q)
+                + u[3] * s2 * s2 / (q * q * q * q)
+                + u[4] * z2 * s2 / (q * q * q * q)
+                + u[5] * z2 * z2 / (q * q * q * q);
+        EXPECT_NEAR(harmonicAction(r1, r2, cosTheta), fit, 2e-5);
+        ++lineCount;
+    }
+    EXPECT_EQ(20, lineCount);
+    std::remove((filename + ".dmu").c_str());
+    std::remove((filename + ".dme").c_str());
+}
+
+}